@@ -14,123 +14,204 @@
 //  operations and transactions. 
 //  No device specific code should be added into this generic functions.
 //
+//  Continuous ranging leaves the sensor measuring on its own every 
+//  VL6180_PERIOD_MS. Each result is collected with queued I2C1 transfers,
+//  started by the GPIO1 new sample interrupt or by VL6180_Step(), and 
+//  cached for VL6180_GetRange(), so the CPU never waits on the sensor.
+//
 ///////////////////////////////////////////////////////////////////////////////
 #include <xc.h>
+#include <stddef.h>
 #include "VL6180.h"
 #include "i2c1.h"
+#include "i2cdev.h"
+#include "sched.h"
+
+// use interrupt no_auto_psv attribute to reduce interrupt overhead
+#define ISR_NO_PSV __attribute__((__interrupt__, no_auto_psv))
+
+// the sensor on I2C1, 16-bit registers, the continuous ranging setup 
+// shadowed
+static unsigned char ucVlCache[VL_CACHE_LAST - VL_CACHE_FIRST + 1];
+static unsigned char ucVlValid[I2CDEV_VALID_BYTES(sizeof(ucVlCache))];
+static I2CDEV sVlDev =
+{
+    .cAddr = VL6180_ADDR,
+    .ucRegWidth = 2,
+    .ucAutoInc = 1,
+    .uiCacheBase = VL_CACHE_FIRST,
+    .ucCacheCnt = sizeof(ucVlCache),
+    .pucCache = ucVlCache,
+    .pucValid = ucVlValid,
+    .ulWrites = 0,
+    .ulSkipped = 0
+};
+
+// result collection: the status read, then when a sample is ready the range
+// read and the interrupt clear, which releases GPIO1
+static const char vlStatusReg[2] = { VL_RANGE_STATUS >> 8, VL_RANGE_STATUS & 0xFF };
+static const char vlRangeReg[2] = { VL_RANGE_VAL >> 8, VL_RANGE_VAL & 0xFF };
+static const char vlClear[3] = { VL_INT_CLEAR >> 8, VL_INT_CLEAR & 0xFF, VL_INT_CLEAR_ALL };
+static const char vlStop[3] = { VL_RANGE_START >> 8, VL_RANGE_START & 0xFF, VL_START_SINGLE };
+static char vlStatus[VL_INT_STATUS - VL_RANGE_STATUS + 1];
+static char vlRange;
+static I2C1_XFER vlStatusXfer, vlRangeXfer, vlClearXfer, vlStopXfer;
+
+// latest valid range, and whether it was fetched yet
+static volatile unsigned char ucRange = 0xFF;
+static volatile unsigned char ucNewRange = 0;
+
+// SCHED_Ticks() of the last result and status poll, samples cached and 
+// results with an error
+static volatile unsigned int u16_lastResult;
+#if !VL6180_GPIO_MODE
+static unsigned int u16_lastPoll;
+#endif
+static volatile unsigned long ulSamples = 0, ulErrors = 0;
 
 ///////////////////////////////////////////////////////////////////////////////
-//      Name:       WriteByte
+//      Name:       writeTable
 //
-//  Operation:      Writes one byte to the slave using I2C.
+//  Operation:      Writes the runs of a register table, each as one auto-
+//                  increment transaction less the registers the shadow 
+//                  knows to hold their value, and with <cVerify> reads them
+//                  back, writing a run that differs once more
 //
-//      Accepts:    - wchar_t reg:      slave register address
-//                  - char data:        data to send
+//      Accepts:    - const unsigned char* pucTable:    VL_RUN() runs, ended
+//                                                      by VL_TABLE_END
+//                  - char cVerify:                     1 to read back
 //
-//      Returns:    None
+//      Returns:    - unsigned char:    runs still differing after that
 //
 ///////////////////////////////////////////////////////////////////////////////
-void WriteByte(wchar_t reg, char data)
+static unsigned char writeTable(const unsigned char* pucTable, char cVerify)
 {
-    char data_w[3];
-    
-    data_w[0] = (reg >> 8) & 0xFF;
-    data_w[1] = reg & 0xFF;
-    data_w[2] = data & 0xFF;
+    unsigned char data_r[I2CDEV_RUN_MAX];
+    const unsigned char* pucData;
+    unsigned int uiReg;
+    unsigned char ucCnt, ucTry, ucBad = 0;
+    unsigned int i;
     
-    writeNI2C1(ADDR, data_w, 3);
+    while((ucCnt = pucTable[2] & ~VL_COMMAND) != 0)
+    {
+        uiReg = ((unsigned int)pucTable[0] << 8) | pucTable[1];
+        pucData = pucTable + 3;
+        ucTry = 0;
+        
+        if(pucTable[2] & VL_COMMAND)
+        {
+            for(i = 0; i < ucCnt; i++)
+                I2CDEV_Send(&sVlDev, uiReg + i, pucData[i]);
+        }
+        else for(ucTry = 0; ucTry < 2; ucTry++)
+        {
+            if(!I2CDEV_WriteN(&sVlDev, uiReg, pucData, ucCnt))
+                continue;
+            if(!cVerify)
+                break;
+            
+            // a differing read back leaves the shadow wrong, so the next 
+            // write is sent
+            if(I2CDEV_ReadN(&sVlDev, uiReg, data_r, ucCnt))
+            {
+                for(i = 0; i < ucCnt && data_r[i] == pucData[i]; i++);
+                if(i == ucCnt)
+                    break;
+            }
+        }
+        if(ucTry == 2)
+            ucBad++;
+        
+        pucTable += 3 + ucCnt;
+    }
+    return(ucBad);
 }
 
-///////////////////////////////////////////////////////////////////////////////
-//      Name:       ReadByte
-//
-//  Operation:      Read one byte from the slave using I2C
-//
-//      Accepts:    - wchar_t reg:      slave register address
-//
-//      Returns:    - char data_r:      Byte read from transaction
-//
-///////////////////////////////////////////////////////////////////////////////
-char ReadByte(wchar_t reg)
+// Settings loaded after a reset, ST's recommended private registers first,
+// in address order so neighbours share a transaction, then the public ones.
+// const tables are kept in program memory and read through the PSV window.
+static const unsigned char ucInitTable[] =
 {
-    char data_w[2];
-    char data_r[1];
-    
-    data_w[0] = (reg >> 8) & 0xFF;
-    data_w[1] = reg & 0xFF;
+    VL_RUN(0x0207, 2),  0x01, 0x01,
+    VL_RUN(0x0096, 2),  0x00, 0xfd,
+    VL_RUN(0x009f, 1),  0x00,
+    VL_RUN(0x00a3, 1),  0x3c,
+    VL_RUN(0x00b2, 1),  0x09,
+    VL_RUN(0x00b7, 1),  0x00,
+    VL_RUN(0x00bb, 1),  0x3c,
+    VL_RUN(0x00ca, 1),  0x09,
+    VL_RUN(0x00d9, 1),  0x05,
+    VL_RUN(0x00db, 3),  0xce, 0x03, 0xf8,
+    VL_RUN(0x00e3, 5),  0x00, 0x04, 0x02, 0x01, 0x03,
+    VL_RUN(0x00f5, 1),  0x02,
+    VL_RUN(0x00ff, 2),  0x05, 0x05,
+    VL_RUN(0x0198, 2),  0x01, 0x05,
+    VL_RUN(0x01a6, 2),  0x1b, 0x1f,
+    VL_RUN(0x01ac, 2),  0x3e, 0x00,
+    VL_RUN(0x01b0, 1),  0x17,
     
-    writeNI2C1(ADDR, data_w, 2);
-    read1I2C1(ADDR, data_r);
-    return(data_r[0]);
-}
+    VL_RUN(VL_GPIO1_MODE, 1),   0x10,   // GPIO1 interrupt output, active low
+    VL_RUN(0x010a, 1),  0x30,           // Set the averaging sample period
+                                        // (compromise between lower noise and
+                                        // increased execution time)
+    VL_RUN(0x003f, 2),  0x46,           // Sets the light and dark gain (upper
+                                        // nibble). Dark gain should not be
+                                        // changed.
+                        0x63,           // Set ALS integration time to 100ms
+    VL_RUN(0x0030, 2),  0x00,
+                        0xFF,           // sets the # of range measurements 
+                                        // after which auto calibration of 
+                                        // system is performed
+    VL_RUN(0x002e, 1 | VL_COMMAND),     // perform a single temperature 
+                        0x01,           // calibration of the ranging sensor,
+                                        // the bit clears when it is done
+    VL_RUN(VL_FRESH_RESET, 1),  0x00,
+    VL_TABLE_END
+};
+
+// flags a new range sample in the status PollRange() waits for, it was 
+// never enabled so the status stayed 0
+static const unsigned char ucStatusTable[] =
+{
+    VL_RUN(VL_INT_CONFIG, 1),   VL_INT_NEW_SAMPLE,
+    VL_TABLE_END
+};
+
+// continuous ranging, the interrupt cleared before the start; after 
+// initVL6180() the shadow leaves out the GPIO1 setup
+static const unsigned char ucContinuousTable[] =
+{
+    VL_RUN(VL_GPIO1_MODE, 1),   0x10,
+    VL_RUN(VL_INT_CONFIG, 1),   VL_INT_NEW_SAMPLE,
+    VL_RUN(VL_RANGE_PERIOD, 2), VL6180_PERIOD_MS / 10 - 1, VL6180_CONVERGE_MS,
+    VL_RUN(VL_INT_CLEAR, 1 | VL_COMMAND),   VL_INT_CLEAR_ALL,
+    VL_RUN(VL_RANGE_START, 1 | VL_COMMAND), VL_START_CONTINUOUS,
+    VL_TABLE_END
+};
 
 ///////////////////////////////////////////////////////////////////////////////
 //      Name:       initVL6180
 //
-//  Operation:      Initializes the VL6180 range sensor
+//  Operation:      Initializes the VL6180 range sensor from the register
+//                  tables, read back when VL6180_VERIFY is set. A sensor
+//                  fresh out of reset has lost what the shadow holds.
 //
 //      Accepts:    None
 //
-//      Returns:    None
+//      Returns:    - unsigned char:    runs of registers that did not read 
+//                                      back as written, 0 when not verified
 //
 ///////////////////////////////////////////////////////////////////////////////
-void initVL6180(void)
+unsigned char initVL6180(void)
 {
-    char reset;
+    unsigned char ucBad = 0;
     
-    reset = ReadByte(0x016);
-    
-    if(reset == 1)
+    if(I2CDEV_Read(&sVlDev, VL_FRESH_RESET) == 1)
     {
-        WriteByte(0x0207, 0x01);
-        WriteByte(0x0208, 0x01);
-        WriteByte(0x0096, 0x00);
-        WriteByte(0x0097, 0xfd);
-        WriteByte(0x00e3, 0x00);
-        WriteByte(0x00e4, 0x04);
-        WriteByte(0x00e5, 0x02);
-        WriteByte(0x00e6, 0x01);
-        WriteByte(0x00e7, 0x03);
-        WriteByte(0x00f5, 0x02);
-        WriteByte(0x00d9, 0x05);
-        WriteByte(0x00db, 0xce);
-        WriteByte(0x00dc, 0x03);
-        WriteByte(0x00dd, 0xf8);
-        WriteByte(0x009f, 0x00);
-        WriteByte(0x00a3, 0x3c);
-        WriteByte(0x00b7, 0x00);
-        WriteByte(0x00bb, 0x3c);
-        WriteByte(0x00b2, 0x09);
-        WriteByte(0x00ca, 0x09);
-        WriteByte(0x0198, 0x01);
-        WriteByte(0x01b0, 0x17);
-        WriteByte(0x01ad, 0x00);
-        WriteByte(0x00ff, 0x05);
-        WriteByte(0x0100, 0x05);
-        WriteByte(0x0199, 0x05);
-        WriteByte(0x01a6, 0x1b);
-        WriteByte(0x01ac, 0x3e);
-        WriteByte(0x01a7, 0x1f);
-        WriteByte(0x0030, 0x00);
-        
-        WriteByte(0x0011, 0x10);    // Enables polling for ?New Sample ready?
-                                    // when measurement completes
-        WriteByte(0x010a, 0x30);    // Set the averaging sample period
-                                    // (compromise between lower noise and
-                                    // increased execution time)
-        WriteByte(0x003f, 0x46);    // Sets the light and dark gain (upper
-                                    // nibble). Dark gain should not be
-                                    // changed.
-        WriteByte(0x0031, 0xFF);    // sets the # of range measurements after
-                                    // which auto calibration of system is
-                                    // performed
-        WriteByte(0x0040, 0x63);    // Set ALS integration time to 100ms
-        
-        WriteByte(0x002e, 0x01);    // perform a single temperature calibration
-                                    // of the ranging sensor
-        
-        WriteByte(0x016, 0x00);
+        I2CDEV_Invalidate(&sVlDev);
+        ucBad = writeTable(ucInitTable, VL6180_VERIFY);
     }
+    return(ucBad + writeTable(ucStatusTable, VL6180_VERIFY));
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -145,13 +226,14 @@ void initVL6180(void)
 ///////////////////////////////////////////////////////////////////////////////
 void StartRange(void)
 {
-    WriteByte(0x018, 0x01);
+    I2CDEV_Send(&sVlDev, VL_RANGE_START, VL_START_SINGLE);
 }
 
 ///////////////////////////////////////////////////////////////////////////////
 //      Name:       PollRange
 //
-//  Operation:      Polls the range (Function did not work in lab)
+//  Operation:      Waits for the range measurement to complete; it never
+//                  did in lab before initVL6180() enabled the status
 //
 //      Accepts:    None
 //
@@ -165,7 +247,7 @@ void PollRange(void)
     
     do
     {
-        status = ReadByte(0x04F);
+        status = I2CDEV_Read(&sVlDev, VL_INT_STATUS);
         range_status = status & 0x07;
     }
     while (range_status != 0x04);
@@ -183,7 +265,7 @@ void PollRange(void)
 ///////////////////////////////////////////////////////////////////////////////
 unsigned char ReadRange(void)
 {
-    return(ReadByte(0x062));
+    return(I2CDEV_Read(&sVlDev, VL_RANGE_VAL));
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -198,5 +280,238 @@ unsigned char ReadRange(void)
 ///////////////////////////////////////////////////////////////////////////////
 void ClearInterrupts(void)
 {
-    WriteByte(0x015, 0x07);
+    I2CDEV_Send(&sVlDev, VL_INT_CLEAR, VL_INT_CLEAR_ALL);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//      Name:       collecting
+//
+//  Operation:      Tells whether the transfers of a result are still queued
+//                  or on the bus
+//
+///////////////////////////////////////////////////////////////////////////////
+static char collecting(void)
+{
+    return(vlStatusXfer.ucStatus <= I2C_XFER_BUSY
+           || vlRangeXfer.ucStatus <= I2C_XFER_BUSY
+           || vlClearXfer.ucStatus <= I2C_XFER_BUSY);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//      Name:       clearDone
+//
+//  Operation:      Completion callback of the interrupt clear, runs in the
+//                  MI2C1 ISR: caches the range read before it. A failed
+//                  transfer leaves GPIO1 asserted, VL6180_Step() then 
+//                  collects the result again.
+//
+///////////////////////////////////////////////////////////////////////////////
+static void clearDone(I2C1_XFER* pXfer)
+{
+    if(vlRangeXfer.ucStatus != I2C_XFER_DONE || pXfer->ucStatus != I2C_XFER_DONE)
+        return;
+    
+    u16_lastResult = SCHED_Ticks();
+    if(vlStatus[0] & 0xF0)
+        ulErrors++;
+    else
+    {
+        ucRange = vlRange;
+        ucNewRange = 1;
+        ulSamples++;
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//      Name:       statusDone
+//
+//  Operation:      Completion callback of the status read, runs in the MI2C1
+//                  ISR: queues the range read and the interrupt clear when a 
+//                  new sample is ready
+//
+///////////////////////////////////////////////////////////////////////////////
+static void statusDone(I2C1_XFER* pXfer)
+{
+    if(pXfer->ucStatus != I2C_XFER_DONE 
+       || (vlStatus[VL_INT_STATUS - VL_RANGE_STATUS] & 0x07) != VL_INT_NEW_SAMPLE)
+        return;
+    
+    submitI2C1(&vlRangeXfer);
+    submitI2C1(&vlClearXfer);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//      Name:       collect
+//
+//  Operation:      Starts collecting a result unless one is underway, with
+//                  INT1 kept out by the caller so that no other collect()
+//                  comes between the test and the submit. The submit is
+//                  safe from main against the INT0 DR ISR, which queues
+//                  XZ reads, as submitI2C1() raises the CPU priority.
+//
+///////////////////////////////////////////////////////////////////////////////
+static void collect(void)
+{
+    if(!collecting())
+        submitI2C1(&vlStatusXfer);
+}
+
+#if VL6180_GPIO_MODE
+///////////////////////////////////////////////////////////////////////////////
+//      Name:       INT1Interrupt
+//
+//  Operation:      ISR for INT1, GPIO1 fell with a new range sample
+//
+///////////////////////////////////////////////////////////////////////////////
+void ISR_NO_PSV _INT1Interrupt(void)
+{
+    IFS1bits.INT1IF = 0;
+    collect();
+}
+#endif
+
+///////////////////////////////////////////////////////////////////////////////
+//      Name:       xferInit
+//
+//  Operation:      Fills in a transfer descriptor to the VL6180, marked done
+//
+///////////////////////////////////////////////////////////////////////////////
+static void xferInit(I2C1_XFER* pXfer, const char* pcWrite, unsigned char ucWriteCnt,
+                     char* pcRead, unsigned char ucReadCnt, I2C1_CALLBACK pfDone)
+{
+    pXfer->cAddr = VL6180_ADDR;
+    pXfer->pcWrite = pcWrite;
+    pXfer->ucWriteCnt = ucWriteCnt;
+    pXfer->pcRead = pcRead;
+    pXfer->ucReadCnt = ucReadCnt;
+    pXfer->pfDone = pfDone;
+    pXfer->ucStatus = I2C_XFER_DONE;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//      Name:       VL6180_StartContinuous
+//
+//  Operation:      Starts continuous ranging every VL6180_PERIOD_MS and the
+//                  collection of its results. Configures the sensor with the
+//                  blocking operations, so call it after initVL6180() and 
+//                  before other queued transfers start.
+//
+//      Accepts:    None
+//
+//      Returns:    None
+//
+///////////////////////////////////////////////////////////////////////////////
+void VL6180_StartContinuous(void)
+{
+    xferInit(&vlStatusXfer, vlStatusReg, 2, vlStatus, sizeof(vlStatus), statusDone);
+    xferInit(&vlRangeXfer, vlRangeReg, 2, &vlRange, 1, NULL);
+    xferInit(&vlClearXfer, vlClear, 3, NULL, 0, clearDone);
+    xferInit(&vlStopXfer, vlStop, 3, NULL, 0, NULL);
+    
+    writeTable(ucContinuousTable, 0);
+    u16_lastResult = SCHED_Ticks();
+    
+#if VL6180_GPIO_MODE
+    TRISEbits.TRISE8 = 1;
+    INTCON2bits.INT1EP = 1;                     // falling edge
+    IFS1bits.INT1IF = 0;
+    IPC5bits.INT1IP = 1;
+    IEC1bits.INT1IE = 1;
+#endif
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//      Name:       VL6180_StopContinuous
+//
+//  Operation:      Stops continuous ranging after the measurement underway,
+//                  with a queued write; called from main, see collect()
+//
+//      Accepts:    None
+//
+//      Returns:    None
+//
+///////////////////////////////////////////////////////////////////////////////
+void VL6180_StopContinuous(void)
+{
+#if VL6180_GPIO_MODE
+    IEC1bits.INT1IE = 0;
+#endif
+    if(vlStopXfer.ucStatus > I2C_XFER_BUSY)
+        submitI2C1(&vlStopXfer);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//      Name:       VL6180_Step
+//
+//  Operation:      Polls the status for a result to collect, to be called
+//                  every millisecond or so. With the GPIO1 output it only 
+//                  does so when no result came for VL6180_STALL_MS, else 
+//                  every VL6180_POLL_MS once the next result is due. Never
+//                  waits for the bus.
+//
+//      Accepts:    None
+//
+//      Returns:    None
+//
+///////////////////////////////////////////////////////////////////////////////
+void VL6180_Step(void)
+{
+    unsigned int u16_now = SCHED_Ticks();
+    
+#if VL6180_GPIO_MODE
+    if((unsigned int)(u16_now - u16_lastResult) < SCHED_MS(VL6180_STALL_MS))
+        return;
+    
+    // poll once per stall period until a result comes
+    u16_lastResult = u16_now;
+    IEC1bits.INT1IE = 0;
+    collect();
+    IEC1bits.INT1IE = 1;
+#else
+    // the sensor's own clock paces the results, allow it 1/8 too fast
+    if((unsigned int)(u16_now - u16_lastResult) < SCHED_MS(VL6180_PERIOD_MS * 7 / 8)
+       || (unsigned int)(u16_now - u16_lastPoll) < SCHED_MS(VL6180_POLL_MS))
+        return;
+    
+    u16_lastPoll = u16_now;
+    collect();
+#endif
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//      Name:       VL6180_GetRange
+//
+//  Operation:      Reads the cached latest range of continuous ranging
+//
+//      Accepts:    - unsigned char* pucMm:     returns the range in mm, 0xFF
+//                                              before the first one
+//
+//      Returns:    - char:     1 if it arrived since the last call, else 0
+//
+///////////////////////////////////////////////////////////////////////////////
+char VL6180_GetRange(unsigned char* pucMm)
+{
+    char cNew = ucNewRange;
+    
+    ucNewRange = 0;
+    *pucMm = ucRange;
+    return(cNew);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//      Name:       VL6180_Stats
+//
+//  Operation:      Reports the results of continuous ranging
+//
+//      Accepts:    - unsigned long* pulSamples:    returns the ranges cached
+//                  - unsigned long* pulErrors:     returns the results the
+//                                                  sensor flagged invalid
+//
+//      Returns:    None
+//
+///////////////////////////////////////////////////////////////////////////////
+void VL6180_Stats(unsigned long* pulSamples, unsigned long* pulErrors)
+{
+    *pulSamples = ulSamples;
+    *pulErrors = ulErrors;
 }
\ No newline at end of file
@@ -14,16 +14,75 @@
 #define	VL6180_H
 
 // Address: 0x29 (7 bits) => 0b010 1001 + W/R bit => 0b0101 0010 => 0x52
-#define ADDR    0x52    //0b0101 0010
+#define VL6180_ADDR     0x52    //0b0101 0010
 
-#define wchar_t  unsigned int
+// Register addresses
+#define VL_GPIO1_MODE       0x011   // GPIO1 function and polarity
+#define VL_INT_CONFIG       0x014   // events signalled on GPIO1
+#define VL_INT_CLEAR        0x015
+#define VL_FRESH_RESET      0x016
+#define VL_RANGE_START      0x018
+#define VL_RANGE_PERIOD     0x01B   // inter-measurement period, 10 ms steps
+#define VL_RANGE_CONVERGE   0x01C   // max convergence time, ms
+#define VL_RANGE_STATUS     0x04D   // error code in the upper nibble
+#define VL_INT_STATUS       0x04F   // range event in the lower 3 bits
+#define VL_RANGE_VAL        0x062   // range in mm
 
-void WriteByte(wchar_t reg, char data);
-char ReadByte(wchar_t reg); 
-void initVL6180(void);
+// register values
+#define VL_INT_NEW_SAMPLE   0x04    // range event: new sample ready
+#define VL_INT_CLEAR_ALL    0x07
+#define VL_START_SINGLE     0x01
+#define VL_START_CONTINUOUS 0x03    // the start bit again stops the mode
+
+// configuration registers shadowed by the driver, see i2cdev.h
+#define VL_CACHE_FIRST      VL_GPIO1_MODE
+#define VL_CACHE_LAST       VL_RANGE_CONVERGE
+
+// Register tables: each run is the register address, high byte first, the
+// count of data bytes written from there with auto-increment and the data.
+// A run is at most I2CDEV_RUN_MAX bytes.
+#define VL_RUN(reg, cnt)    ((reg) >> 8), ((reg) & 0xFF), (cnt)
+#define VL_TABLE_END        0, 0, 0
+#define VL_COMMAND          0x80    // in the count: command register, always
+                                    // sent, not shadowed nor verified
+
+// 1 reads every run of initVL6180() back and writes it again if it differs,
+// which doubles the bus traffic of the initialization
+#define VL6180_VERIFY       0
+
+// continuous ranging: a measurement every VL6180_PERIOD_MS, each taking up
+// to VL6180_CONVERGE_MS plus about 5 ms of readout averaging
+#define VL6180_PERIOD_MS    30
+#define VL6180_CONVERGE_MS  20
+
+#if VL6180_PERIOD_MS < VL6180_CONVERGE_MS + 5
+#error "VL6180_PERIOD_MS leaves no time for the readout"
+#endif
+
+// result collection: 1 = the active low GPIO1 output on INT1 (RE8), which 
+// needs a pull-up, 0 = status polled from VL6180_Step()
+#define VL6180_GPIO_MODE    1
+
+// with the GPIO1 output, VL6180_Step() polls once when no result came for
+// this long, in case an edge was lost
+#define VL6180_STALL_MS     (3 * VL6180_PERIOD_MS)
+
+// without it, the interval of the status polls from shortly before the 
+// next result is due until it comes
+#define VL6180_POLL_MS      1
+
+unsigned char initVL6180(void);
 void StartRange(void);
+void PollRange(void);
 unsigned char ReadRange(void);
 void ClearInterrupts(void);
 
+// Continuous ranging
+void VL6180_StartContinuous(void);
+void VL6180_StopContinuous(void);
+void VL6180_Step(void);
+char VL6180_GetRange(unsigned char* pucMm);
+void VL6180_Stats(unsigned long* pulSamples, unsigned long* pulErrors);
+
 #endif	/* VL6180_H */
 
@@ -9,7 +9,45 @@
 #include <string.h>
 #include "XZsensor.h"
 #include "i2c1.h"
+#include "i2cdev.h"
 #include "uart2.h"
+#include "term.h"
+#include "canvas.h"
+#include "prof.h"
+#include "motion.h"
+
+// DR driven acquisition: the INT0 edge queues xzXfer, a repeated-start burst
+// of X_REG..Z_REG, and its completion callback publishes the sample
+static const char xzReg = X_REG;
+static char xzBuff[XZ_BURST_CNT];
+static I2C1_XFER xzXfer;
+
+// latest sample, X in the high byte and Z in the low byte so main reads both
+// coordinates of one sample in a single access
+static volatile unsigned int u16_xzSample;
+static volatile unsigned char ucNewSample = 0;
+
+// DR edges seen, and edges ignored because the previous burst was running
+static volatile unsigned long ulDrEdges = 0, ulDrMissed = 0;
+
+// cursor velocity state of each axis, see motion.c
+static MOTION_AXIS sxAxis, szAxis;
+
+// the sensor on I2C1, DRE_REG and DRCFG_REG shadowed
+static unsigned char ucXzCache[DRCFG_REG - DRE_REG + 1];
+static unsigned char ucXzValid[I2CDEV_VALID_BYTES(sizeof(ucXzCache))];
+static I2CDEV sXzDev =
+{
+    .cAddr = XZ_ADDR,
+    .ucRegWidth = 1,
+    .ucAutoInc = 1,
+    .uiCacheBase = DRE_REG,
+    .ucCacheCnt = sizeof(ucXzCache),
+    .pucCache = ucXzCache,
+    .pucValid = ucXzValid,
+    .ulWrites = 0,
+    .ulSkipped = 0
+};
 
 /*
  *  Initializes INT0 to detect a HIGH from XZ sensor's DR pin.
@@ -26,90 +64,189 @@ void INT0_Initialize(void)
 }
 
 /*
- *  Writes a byte to XZ sensor at address ADDR using I2C.
- *  Parameters: - reg   address of XZ sensor register
- *              - data  data to write to register
+ *  Initializes the XZ sensor. DRE reg is set to assert DR pin when coordinate
+ *  data is available, and DRECFG reg is set to DR pin is active HIGH and DR is
+ *  enabled. The two registers are neighbours and go in one write; called 
+ *  again, e.g. on a reconnect, only what the sensor does not hold is sent.
+ *  Parameters: None
  *  Return:     None
  */
-void WriteByte(_wchar_t reg, char data)
+void XZ_Initialize(void)
 {
-    char data_w[2];
+    static const unsigned char ucCfg[] = { DRE_CFG, DRCFG_CFG };
     
-    data_w[0] = reg & 0xFF;
-    data_w[1] = data & 0xFF;
+    I2CDEV_WriteN(&sXzDev, DRE_REG, ucCfg, sizeof(ucCfg));
+}
+
+/*
+ *  Reads data from X Position register of XZ sensor.
+ *  Parameters: None
+ *  Return:     xData: X position from XZ sensor
+ */
+unsigned char readXcoord(void)
+{
+    unsigned char xData;
+    xData = I2CDEV_Read(&sXzDev, X_REG);
+    return(xData);
+}
+
+/*
+ *  Reads data from Z Position register of XZ sensor.
+ *  Parameters: None
+ *  Return:     zData: Z position from XZ sensor
+ */
+unsigned char readZcoord(void)
+{
+    unsigned char zData;
+    zData = I2CDEV_Read(&sXzDev, Z_REG);
+    return(zData);
+}
+
+/*
+ *  Reads X and Z Position registers of XZ sensor in a single burst. The
+ *  register pointer is written once and the bus turned around with a repeated
+ *  start, so both coordinates come from the same sensor sample at the cost of
+ *  one address phase per direction, instead of two full write-STOP-START-read
+ *  transactions for readXcoord() and readZcoord().
+ *  Parameters: - pxCo: returns X position from XZ sensor
+ *              - pzCo: returns Z position from XZ sensor
+ *  Return:     None
+ */
+void readXZcoord(unsigned char* pxCo, unsigned char* pzCo)
+{
+    unsigned char data_r[XZ_BURST_CNT];
     
-    writeNI2C1(ADDR, data_w, 1);
+    I2CDEV_ReadN(&sXzDev, X_REG, data_r, XZ_BURST_CNT);
+    *pxCo = data_r[0];
+    *pzCo = data_r[Z_REG - X_REG];
 }
 
 /*
- *  Reads a byte from XZ sensor at address ADDR using I2C.
- *  Parameters: - reg   address of XZ sensor register
+ *  Completion callback of the DR burst read, runs in the MI2C1 ISR.
+ *  Parameters: - pXfer: the completed transfer
  *  Return:     None
  */
-char ReadByte(_wchar_t reg)
+static void xzDone(I2C1_XFER* pXfer)
 {
-    char data_w;
-    char data_r;
+    if(pXfer->ucStatus == I2C_XFER_DONE)
+    {
+        u16_xzSample = ((unsigned int)(unsigned char)xzBuff[0] << 8)
+                | (unsigned char)xzBuff[Z_REG - X_REG];
+        ucNewSample = 1;
+    }
+    PROF_END(PROF_XZ_READ);
     
-    data_w = reg & 0xFF;
+    // a sample that arrived after X was read keeps DR high without a new
+    // edge, and so does one a failed burst did not read: read it now or 
+    // acquisition would stall
+    if(PORTFbits.RF6)
+    {
+        PROF_BEGIN(PROF_XZ_READ);
+        submitI2C1(&xzXfer);
+    }
+}
+
+/*
+ *  ISR for INT0, the XZ sensor's DR pin went high: queues a non-blocking
+ *  burst read of the coordinates. An edge arriving while the previous burst is
+ *  still running is only counted, that burst already fetches the newest data.
+ */
+void ISR_NO_PSV _INT0Interrupt(void)
+{
+    IFS0bits.INT0IF = 0;
+    ulDrEdges++;
     
-    writeNI2C1(ADDR, &data_w, 1);
-    read1I2C1(ADDR, &data_r);
-    return(data_r);
+    if(xzXfer.ucStatus == I2C_XFER_QUEUED || xzXfer.ucStatus == I2C_XFER_BUSY)
+        ulDrMissed++;
+    else
+    {
+        PROF_BEGIN(PROF_XZ_READ);
+        submitI2C1(&xzXfer);
+    }
 }
 
 /*
- *  Initializes the XZ sensor. DRE reg is set to assert DR pin when coordinate
- *  data is available, and DRECFG reg is set to DR pin is active HIGH and DR is
- *  enabled.
+ *  Starts DR driven acquisition. One burst is queued right away, because DR
+ *  may already be high and reading the coordinates is what releases it.
  *  Parameters: None
  *  Return:     None
  */
-void XZ_Initialize(void)
+void XZ_StartDR(void)
 {
-    WriteByte(DRE_REG, DRE_CFG);
-    WriteByte(DRCFG_REG, DRCFG_CFG);
+    xzXfer.cAddr = XZ_ADDR;
+    xzXfer.pcWrite = &xzReg;
+    xzXfer.ucWriteCnt = 1;
+    xzXfer.pcRead = xzBuff;
+    xzXfer.ucReadCnt = XZ_BURST_CNT;
+    xzXfer.pfDone = xzDone;
+    xzXfer.ucStatus = I2C_XFER_DONE;
+    
+    INT0_Initialize();
+    
+    IEC0bits.INT0IE = 0;
+    PROF_BEGIN(PROF_XZ_READ);
+    submitI2C1(&xzXfer);
+    IEC0bits.INT0IE = 1;
 }
 
 /*
- *  Initializes push buttons on Explorer16 as inputs.
- *  Parameters: None
- *  Return:     None
+ *  Fetches the latest sample of DR driven acquisition.
+ *  Parameters: - pxCo: returns X position from XZ sensor
+ *              - pzCo: returns Z position from XZ sensor
+ *  Return:     1 if a new sample arrived since the last call, else 0 and the
+ *              coordinates are left unchanged
  */
-void IO_Initialize(void)
+char XZ_GetSample(unsigned char* pxCo, unsigned char* pzCo)
 {
-    TRISDbits.TRISD6 = 1;       // pushbutton S3
-    TRISDbits.TRISD13 = 1;      // pushbutton S4
-    TRISAbits.TRISA7 = 1;       // pushbutton S5
+    unsigned int u16_sample;
+    
+    if(!ucNewSample)
+        return(0);
+    
+    ucNewSample = 0;
+    u16_sample = u16_xzSample;
+    *pxCo = u16_sample >> 8;
+    *pzCo = u16_sample & 0xFF;
+    return(1);
 }
 
 /*
- *  Reads data from X Position register of XZ sensor.
- *  Parameters: None
- *  Return:     xData: X position from XZ sensor
+ *  Reports DR pin statistics.
+ *  Parameters: - pulEdges:  returns the number of DR edges seen
+ *              - pulMissed: returns the edges ignored while a burst was running
+ *  Return:     None
  */
-unsigned char readXcoord(void)
+void XZ_DRStats(unsigned long* pulEdges, unsigned long* pulMissed)
 {
-    unsigned char xData;
-    xData = ReadByte(X_REG);
-    return(xData);
+    *pulEdges = ulDrEdges;
+    *pulMissed = ulDrMissed;
 }
 
 /*
- *  Reads data from Z Position register of XZ sensor.
- *  Parameters: None
- *  Return:     zData: Z position from XZ sensor
+ *  Moves the cursor by one axis step of the velocity model, stopping the
+ *  axis at the screen edge.
+ *  Parameters: - pAxis:    velocity state of the axis
+ *              - iCells:   cells to move, from MOTION_Step()
+ *              - pCu:      pointer to cursor position on the axis
+ *              - max:      last cell of the axis
+ *  Return:     None
  */
-unsigned char readZcoord(void)
+static void moveAxis(MOTION_AXIS* pAxis, int iCells, uchar* pCu, uchar max)
 {
-    unsigned char zData;
-    zData = ReadByte(Z_REG);
-    return(zData);
+    int iPos = (int)*pCu + iCells;
+    
+    if(iPos < 1 || iPos > max)
+    {
+        MOTION_Stop(pAxis);
+        iPos = (iPos < 1)? 1 : max;
+    }
+    *pCu = iPos;
 }
 
 /*
- *  Determines cursor movement direction from XZ sensor coordinates and updates
- *  cursor position.
+ *  Determines cursor movement from XZ sensor coordinates and updates cursor
+ *  position. The speed grows with the distance from MIDPOINT past DEADZONE,
+ *  see motion.c, and may be a fraction of a cell per update.
  *  Parameters: - xL: last X Position from XZ Sensor
  *              - zL: last Z Position from XZ Sensor
  *              - xCo: X Position from XZ Sensor
@@ -119,70 +256,78 @@ unsigned char readZcoord(void)
  */
 void checkDir(uchar xL, uchar zL, uchar xCo, uchar zCo, uchar* pxCu, uchar* pzCu)
 {
-    // xDir: determines left or right cursor movement
-    // zDir: determines up or down cursor movement
-    int xDir = 0, zDir = 0;
-    
     // first, if coordinates are same as the last then no movement,
-    // then determines if received coordinates are within deadzone,
-    // if not decides left, right, up, or down movement
-    if(xCo == xL) xDir = NOMOVE;                                                          // same coords check
-    else if((MIDPOINT - DEADZONE < xCo) && (xCo < MIDPOINT + DEADZONE)) xDir = NOMOVE;    // x deadzone check
-    else xDir = (MIDPOINT > (int)xCo)? LEFT : RIGHT;                                     // left or right movement
-
-    if(zCo == zL) zDir = NOMOVE;                                                          // same coords check
-    else if((MIDPOINT - DEADZONE < zCo) && (zCo < MIDPOINT + DEADZONE)) zDir = NOMOVE;    // z deadzone check
-    else zDir = ((int)zCo > MIDPOINT)? UP : DOWN;                                         // up or down movement 
-
-    // moves cursor depending on value of xDir, only if within 0 to SCREEN_W boundaries
-    if(xDir == LEFT && *pxCu > 0) (*pxCu)--;
-    else if(xDir == RIGHT && *pxCu < SCREEN_W) (*pxCu)++;
+    // otherwise the velocity model moves right for X above MIDPOINT and up
+    // for Z above MIDPOINT, and not at all within the deadzone
+    if(xCo == xL) MOTION_Stop(&sxAxis);                                   // same coords check
+    else moveAxis(&sxAxis, MOTION_Step(&sxAxis, xCo), pxCu, SCREEN_W);    // left or right movement
 
-    // moves cursor depending on value of zDir, only if within 0 to SCREEN_H boundaries
-    if(zDir == UP && *pzCu > 0) (*pzCu)--;
-    else if(zDir == DOWN && *pzCu < SCREEN_H) (*pzCu)++;
+    if(zCo == zL) MOTION_Stop(&szAxis);                                   // same coords check
+    else moveAxis(&szAxis, -MOTION_Step(&szAxis, zCo), pzCu, SCREEN_H);   // up or down movement
 }
 
 /*
- *  Outputs the cursor position to Tera Term via UART
- *  Parameters: - pBuff:    text buffer
+ *  Outputs the cursor position to Tera Term via UART. Only the difference to
+ *  where the terminal's cursor already is gets sent, see term.c; nothing is
+ *  sent when it is already there.
+ *  Parameters: - pBuff:    text buffer, at least TERM_SEQ_MAX chars
  *              - z:        z coordinate of cursor
  *              - x:        x coordinate of cursor
  *  Return:     None
  */
 void moveCursor(char* pBuff, unsigned char z, unsigned char x)
 {
-    sprintf(pBuff, "\033[%u;%uH", z, x);
-    outString(pBuff);
+    unsigned int len = TERM_CursorSeq(pBuff, z, x);
+    
+    if(len && !outBytes(pBuff, len))
+        TERM_Invalidate();
+}
+
+/*
+ *  Sets a canvas cell and prints it at the current cursor location, which
+ *  must be at (z, x). Nothing is sent when the cell already holds <state>;
+ *  when the character cannot be sent the row is marked dirty for a redraw.
+ *  Parameters: - z:        z coordinate of cursor
+ *              - x:        x coordinate of cursor
+ *              - state:    CANVAS_INK or CANVAS_BLANK
+ *  Return:     None
+ */
+static void setPix(unsigned char z, unsigned char x, char state)
+{
+    if(CANVAS_Set(z, x, state) && !TERM_PutChar((state == CANVAS_INK)? '\xDB' : '\x20'))
+        CANVAS_MarkDirty(z);
 }
 
 /*
  *  Colors a pixel at the current cursor location.
- *  Parameters: None
+ *  Parameters: - z:        z coordinate of cursor
+ *              - x:        x coordinate of cursor
  *  Return:     None
  */
-void colorPix(void)
+void colorPix(unsigned char z, unsigned char x)
 {
-    outString("\xDB");
+    setPix(z, x, CANVAS_INK);
 }
 
 /*
  *  Erases a pixel at the current cursor location.
- *  Parameters: None
+ *  Parameters: - z:        z coordinate of cursor
+ *              - x:        x coordinate of cursor
  *  Return:     None
  */
-void erasePix(void)
+void erasePix(unsigned char z, unsigned char x)
 {
-    outString("\x20");
+    setPix(z, x, CANVAS_BLANK);
 }
 
 /*
- *  Clears the screen.
+ *  Clears the screen and the canvas.
  *  Parameters: None
  *  Return:     None
  */
 void clrScr(char* pStr)
 {
-    outString(pStr);
+    TERM_PutString(pStr);
+    CANVAS_Clear();
 }
 
@@ -10,11 +10,10 @@
 
 ////////////////////////////// Application Macros //////////////////////////////
 #define ISR_NO_PSV  __attribute__((__interrupt__, no_auto_psv))
-#define _wchar_t    unsigned int
 #define uchar       unsigned char
 
 // I2C address of XZ sensor
-#define ADDR        0x20
+#define XZ_ADDR     0x20
 
 // Register addresses of XZ sensor
 #define STATUS_REG  0x00
@@ -23,39 +22,44 @@
 #define X_REG       0x08
 #define Z_REG       0x0A
 
+// X_REG through Z_REG are read together in one burst, see readXZcoord()
+#define XZ_BURST_CNT    (Z_REG - X_REG + 1)
+
 // hex config values for DRE and DRCFG registers of XZ sensor
 #define DRE_CFG     0x02    // assert DR pin when coordinate data available
 #define DRCFG_CFG   0x81    // DR pin enable, active HIGH 
 
-// push button ports for read operations
-#define S3          PORTDbits.RD6
-#define S4          PORTDbits.RD13
-#define S5          PORTAbits.RA7
+// acquisition mode: 1 = burst read started by the DR pin on INT0 (RF6),
+// 0 = blind polling from the sampling task
+#ifndef XZ_DR_MODE
+#define XZ_DR_MODE  1
+#endif
 
 // screen dimension used in main()
 #define SCREEN_H    79
 #define SCREEN_W    184
+
+// tuning, may be set on the compiler command line, e.g. for the replayer
+#ifndef MIDPOINT
 #define MIDPOINT    120
+#endif
+#ifndef DEADZONE
 #define DEADZONE    20
-
-// movement macros
-#define NOMOVE  0
-#define LEFT    1
-#define RIGHT   2
-#define UP      3
-#define DOWN    4
+#endif
 
 ////////////////////////////// Function prototypes /////////////////////////////
 void INT0_Initialize(void);
-void WriteByte(_wchar_t reg, char data);
-char ReadByte(_wchar_t reg);
 void XZ_Initialize(void);
 unsigned char readXcoord(void);
 unsigned char readZcoord(void);
+void readXZcoord(unsigned char* pxCo, unsigned char* pzCo);
+void XZ_StartDR(void);
+char XZ_GetSample(unsigned char* pxCo, unsigned char* pzCo);
+void XZ_DRStats(unsigned long* pulEdges, unsigned long* pulMissed);
 void checkDir(unsigned char xL, unsigned char zL, unsigned char xCo, unsigned char zCo, unsigned char* pxCu, unsigned char* pzCu);
 void moveCursor(char* pBuff, unsigned char z, unsigned char x);
-void colorPix(void);
-void erasePix(void);
-void ClrScr(char* pStr);
+void colorPix(unsigned char z, unsigned char x);
+void erasePix(unsigned char z, unsigned char x);
+void clrScr(char* pStr);
 
 #endif	/* XZSENSOR_H */
\ No newline at end of file
@@ -0,0 +1,270 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+//  Filename:       baud.c
+//
+//  Description:
+//  Raises the UART2 rate above UART2_BOOT_BAUD when the peer takes part in
+//  the negotiation of baud.h, for more cursor updates per second than the
+//  19200 baud line allows. It is stepped from the command task without
+//  blocking and owns UART2 while it runs: nothing else may be sent, and 
+//  the bytes received are matched against the expected answer. The first
+//  BAUD_KEEP bytes outside an answer at the boot rate are kept for 
+//  BAUD_Kept(), so keys typed meanwhile are not lost.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "baud.h"
+#include "uart2.h"
+#include "sched.h"
+#include "fmt.h"
+
+// negotiation states
+#define ST_DONE         0
+#define ST_PROPOSE      1       // send the next proposal
+#define ST_ACCEPT       2       // wait for the accept
+#define ST_DRAIN        3       // let the proposal leave before the change
+#define ST_SETTLE       4       // give the peer time to change
+#define ST_CHECK        5       // wait for the answer to the check
+#define ST_BACKOFF      6       // back at the boot rate, wait for the peer
+
+// rates usable at this Fcy, highest first
+static const unsigned long u32_rates[] =
+{
+#if UART2_BAUD_OK(460800UL)
+    460800UL,
+#endif
+#if UART2_BAUD_OK(230400UL)
+    230400UL,
+#endif
+#if UART2_BAUD_OK(115200UL)
+    115200UL,
+#endif
+    0
+};
+
+static char cState = ST_DONE;
+static unsigned int u16_rate = 0;       // index of the rate tried
+static unsigned int u16_since;          // SCHED_Ticks() the state started
+
+// the answer waited for and how much of it was received
+static char cExpect[BAUD_MSG_MAX];
+static unsigned int u16_expectLen, u16_matched;
+
+// bytes received outside the answers
+static char cKept[BAUD_KEEP];
+static unsigned int u16_kept = 0;
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           message
+//  Description:    Builds ESC _ B <text> ESC '\' with <text> a rate or a
+//                  single character when the rate is 0
+//      Returns:    message length
+///////////////////////////////////////////////////////////////////////////////
+static unsigned int message(char* pBuff, unsigned long u32_rate, char c)
+{
+    unsigned int u16_n = 3;
+
+    pBuff[0] = '\033';
+    pBuff[1] = '_';
+    pBuff[2] = 'B';
+    if(u32_rate)
+        u16_n += FMT_U32(pBuff + u16_n, u32_rate, 0);
+    else
+        pBuff[u16_n++] = c;
+    pBuff[u16_n++] = '\033';
+    pBuff[u16_n++] = '\\';
+    return(u16_n);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           send
+//  Description:    Sends a message and sets the answer to wait for
+//      Returns:    1 if sent, 0 if the Tx ring had no room
+///////////////////////////////////////////////////////////////////////////////
+static char send(unsigned long u32_rate, char c, unsigned long u32_answer, char cAnswer)
+{
+    char msg[BAUD_MSG_MAX];
+
+    if(!outBytes(msg, message(msg, u32_rate, c)))
+        return(0);
+    u16_expectLen = message(cExpect, u32_answer, cAnswer);
+    u16_matched = 0;
+    return(1);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           received
+//  Description:    Matches the received bytes against the expected answer,
+//                  a refusal counts as an answer too
+//      Returns:    1 when the answer is in, -1 on a refusal, else 0
+///////////////////////////////////////////////////////////////////////////////
+static int received(void)
+{
+    static const char refusal[] = "\033_B0\033\\";
+    static unsigned int u16_refused = 0;
+    char buff[4];
+    unsigned int i, n;
+
+    while((n = inBytes(buff, sizeof(buff))) > 0)
+    {
+        for(i = 0; i < n; i++)
+        {
+            // ESC starts every message, a mismatch starts over
+            if(buff[i] == cExpect[u16_matched])
+                u16_matched++;
+            else
+                u16_matched = (buff[i] == '\033');
+            if(buff[i] == refusal[u16_refused])
+                u16_refused++;
+            else
+                u16_refused = (buff[i] == '\033');
+            // at another rate they would be garbled
+            if(cState == ST_ACCEPT && !u16_matched && !u16_refused 
+               && u16_kept < BAUD_KEEP)
+                cKept[u16_kept++] = buff[i];
+
+            if(u16_matched == u16_expectLen)
+                return(1);
+            if(u16_refused == sizeof(refusal) - 1)
+            {
+                u16_refused = 0;
+                return(-1);
+            }
+        }
+    }
+    return(0);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           enter
+//  Description:    Changes state and restarts its timer
+///////////////////////////////////////////////////////////////////////////////
+static void enter(char cNew)
+{
+    cState = cNew;
+    u16_since = SCHED_Ticks();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           elapsed
+//  Description:    Milliseconds spent in the current state
+///////////////////////////////////////////////////////////////////////////////
+static unsigned int elapsed(void)
+{
+    return(SCHED_Ticks() - u16_since);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           nextRate
+//  Description:    Moves on to the next lower rate, done after the last
+///////////////////////////////////////////////////////////////////////////////
+static void nextRate(void)
+{
+    u16_rate++;
+    enter(u32_rates[u16_rate]? ST_PROPOSE : ST_DONE);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           BAUD_Start
+//  Description:    Starts a negotiation from UART2_BOOT_BAUD, where the
+//                  link is after UART2_Initialize()
+//      Accepts:    None
+//      Returns:    None
+///////////////////////////////////////////////////////////////////////////////
+void BAUD_Start(void)
+{
+    u16_rate = 0;
+    u16_kept = 0;
+    enter(u32_rates[0]? ST_PROPOSE : ST_DONE);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           BAUD_Step
+//  Description:    Advances the negotiation, to be called every few
+//                  milliseconds until it returns 1; baudUART2() is then the
+//                  rate agreed on
+//      Accepts:    None
+//      Returns:    - char:     1 once the negotiation is over
+///////////////////////////////////////////////////////////////////////////////
+char BAUD_Step(void)
+{
+    int iIn;
+
+    switch(cState)
+    {
+        case ST_PROPOSE:
+            if(send(u32_rates[u16_rate], 0, u32_rates[u16_rate], 0))
+                enter(ST_ACCEPT);
+            break;
+
+        case ST_ACCEPT:
+            iIn = received();
+            if(iIn > 0)
+                enter(ST_DRAIN);
+            else if(iIn < 0 || elapsed() >= BAUD_REPLY_MS)
+                nextRate();
+            break;
+
+        case ST_DRAIN:
+            if(txIdleUART2())
+            {
+                setBaudUART2(u32_rates[u16_rate]);
+                enter(ST_SETTLE);
+            }
+            break;
+
+        case ST_SETTLE:
+            if(elapsed() >= BAUD_SETTLE_MS && send(0, '?', 0, '!'))
+                enter(ST_CHECK);
+            break;
+
+        case ST_CHECK:
+            if(received() > 0)
+                enter(ST_DONE);
+            else if(elapsed() >= BAUD_REPLY_MS)
+            {
+                // the check left long ago, nothing is cut off
+                setBaudUART2(UART2_BOOT_BAUD);
+                enter(ST_BACKOFF);
+            }
+            break;
+
+        case ST_BACKOFF:
+            if(elapsed() >= BAUD_PEER_MS)
+            {
+                // drop what arrived at the wrong rate
+                received();
+                nextRate();
+            }
+            break;
+    }
+
+    return(cState == ST_DONE);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           BAUD_Active
+//  Description:    Tells whether a negotiation runs
+//      Accepts:    None
+//      Returns:    - char:     1 until BAUD_Step() is over
+///////////////////////////////////////////////////////////////////////////////
+char BAUD_Active(void)
+{
+    return(cState != ST_DONE);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           BAUD_Kept
+//  Description:    Hands over the bytes kept during the negotiation, once
+//      Accepts:    - char* pc_buff:            buffer of BAUD_KEEP bytes
+//      Returns:    - unsigned int:             number of bytes
+///////////////////////////////////////////////////////////////////////////////
+unsigned int BAUD_Kept(char* pc_buff)
+{
+    unsigned int i, n = u16_kept;
+    
+    for(i = 0; i < n; i++)
+        pc_buff[i] = cKept[i];
+    u16_kept = 0;
+    return(n);
+}
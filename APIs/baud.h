@@ -0,0 +1,49 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+//  Filename:       baud.h
+//
+//  Description:    Header file for the baud.c UART2 rate negotiation
+//
+//  Protocol, all messages are APC strings, which ECMA-48 terminals discard,
+//  so a plain terminal shows nothing and never answers:
+//      firmware -> peer, at the current rate:  ESC _ B <rate> ESC '\'
+//      peer -> firmware, accepts:              ESC _ B <rate> ESC '\'
+//      peer -> firmware, refuses:              ESC _ B 0 ESC '\'
+//  After an accept both ends change to <rate>, the firmware once it has no
+//  more to send, the peer once the accept is sent. Then the round trip at
+//  the new rate:
+//      firmware -> peer:                       ESC _ B ? ESC '\'
+//      peer -> firmware:                       ESC _ B ! ESC '\'
+//  A peer that does not get the check within BAUD_PEER_MS of its accept
+//  goes back to the old rate. The firmware goes back when the answer is
+//  not in within BAUD_REPLY_MS, waits out BAUD_PEER_MS and proposes the
+//  next lower rate. The rates are 460800, 230400 and 115200 baud, those
+//  UART2_BAUD_OK() allows at this Fcy; with none accepted the link stays
+//  at UART2_BOOT_BAUD.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef _BAUD_H
+#define _BAUD_H
+
+/////////////////////////////////// MACROS ///////////////////////////////////
+
+// timeouts in milliseconds
+#define BAUD_REPLY_MS       250     // for an answer from the peer
+#define BAUD_SETTLE_MS      20      // after the change, before the check
+#define BAUD_PEER_MS        500     // the peer's wait for the check
+
+// longest message, ESC _ B, 6 digits and ESC backslash
+#define BAUD_MSG_MAX        11
+
+// other bytes received during the negotiation that are kept
+#define BAUD_KEEP           4
+
+///////////////////////////// FUNCTION PROTOTYPES /////////////////////////////
+
+void BAUD_Start(void);
+char BAUD_Step(void);
+char BAUD_Active(void);
+unsigned int BAUD_Kept(char* pc_buff);
+
+#endif  // _BAUD_H
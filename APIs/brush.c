@@ -0,0 +1,228 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+//  Filename:       brush.c
+//
+//  Description:
+//  Square and round brushes of BRUSH_MAX cells at most. A brush is kept as
+//  one span of columns per row, relative to the cursor cell, so a stamp is
+//  a handful of row spans, each sent by STROKE_Span() as one cursor move
+//  and one run of ink (REP) or one ECH.
+//
+//  A cursor move sweeps the brush along the line from one position to the
+//  next. The swept area of a convex brush is one span per row; the part of
+//  it the stamp at the start of the move already covers is left out, so
+//  only the leading edge of the brush goes out, at most two spans per row.
+//  A brush of one cell is the plain line of stroke.c.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "brush.h"
+#include "stroke.h"
+#include "term.h"
+
+static unsigned char ucSize = 1;
+static char cShape = BRUSH_SQUARE;
+
+// brush rows from scTop rows above the cursor, cells scLo to scHi of its
+// column
+static signed char scTop = 0;
+static signed char scLo[BRUSH_MAX], scHi[BRUSH_MAX];
+
+// the last stamp, at the end of the last stroke, is on the canvas
+static char cDown = 0;
+static unsigned char ucLastRow, ucLastCol;
+static char cLastState;
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           shape
+//  Description:    Computes the spans of the brush rows. A round brush takes
+//                  the cells whose centers lie in its circle, less a bit
+//                  so the sizes 3 and 4 are not squares; measured in half
+//                  cells from the brush center to stay in integers.
+///////////////////////////////////////////////////////////////////////////////
+static void shape(void)
+{
+    int iHalf = (ucSize - 1) / 2;
+    int iR2 = ucSize * ucSize - 2;
+    int i, j, iY2, iX2;
+
+    scTop = -iHalf;
+    for(i = 0; i < ucSize; i++)
+    {
+        j = 0;
+        if(cShape == BRUSH_ROUND && ucSize > 2)
+        {
+            iY2 = 2 * i - (ucSize - 1);
+            for(iX2 = -(ucSize - 1); iX2 * iX2 + iY2 * iY2 > iR2; iX2 += 2)
+                j++;
+        }
+        scLo[i] = j - iHalf;
+        scHi[i] = ucSize - 1 - j - iHalf;
+    }
+    cDown = 0;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           swept
+//  Description:    Span of row <iRow> the brush covers along the line from
+//                  (row0, col0) to (row1, col1), Bresenham's as in stroke.c
+//      Returns:    1 if the brush touches the row
+///////////////////////////////////////////////////////////////////////////////
+static char swept(int iRow, unsigned char row0, unsigned char col0, unsigned char row1,
+                  unsigned char col1, int* piLo, int* piHi)
+{
+    int iDc = (col1 > col0)? col1 - col0 : col0 - col1;
+    int iDr = (row1 > row0)? row0 - row1 : row1 - row0;     // negative
+    int iErr = iDc + iDr, iErr2;
+    int iRowNow = row0, iColNow = col0, i;
+
+    *piLo = SCREEN_W + BRUSH_MAX;
+    *piHi = -BRUSH_MAX;
+
+    for(;;)
+    {
+        i = iRow - iRowNow - scTop;
+        if(i >= 0 && i < ucSize)
+        {
+            if(iColNow + scLo[i] < *piLo) *piLo = iColNow + scLo[i];
+            if(iColNow + scHi[i] > *piHi) *piHi = iColNow + scHi[i];
+        }
+        if(iRowNow == row1 && iColNow == col1)
+            break;
+
+        iErr2 = 2 * iErr;
+        if(iErr2 >= iDr)
+        {
+            iErr += iDr;
+            iColNow += (col1 > col0)? 1 : -1;
+        }
+        if(iErr2 <= iDc)
+        {
+            iErr += iDc;
+            iRowNow += (row1 > row0)? 1 : -1;
+        }
+    }
+    return(*piLo <= *piHi);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           BRUSH_SetSize
+//  Description:    Sets the brush size
+//      Accepts:    - unsigned char ucNewSize:  1 to BRUSH_MAX cells, limited
+//                                              to that range
+//      Returns:    None
+///////////////////////////////////////////////////////////////////////////////
+void BRUSH_SetSize(unsigned char ucNewSize)
+{
+    if(ucNewSize < 1) ucNewSize = 1;
+    if(ucNewSize > BRUSH_MAX) ucNewSize = BRUSH_MAX;
+
+    if(ucNewSize != ucSize)
+    {
+        ucSize = ucNewSize;
+        shape();
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           BRUSH_SetShape
+//  Description:    Sets the brush shape
+//      Accepts:    - char cNewShape:   BRUSH_SQUARE or BRUSH_ROUND
+//      Returns:    None
+///////////////////////////////////////////////////////////////////////////////
+void BRUSH_SetShape(char cNewShape)
+{
+    if(cNewShape != cShape)
+    {
+        cShape = cNewShape;
+        shape();
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           BRUSH_Size / BRUSH_Shape
+//  Description:    Read the brush size and shape
+///////////////////////////////////////////////////////////////////////////////
+unsigned char BRUSH_Size(void)
+{
+    return(ucSize);
+}
+
+char BRUSH_Shape(void)
+{
+    return(cShape);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           BRUSH_Lift
+//  Description:    Ends the stroke, the next one starts with a whole stamp.
+//                  Call when the pen and the eraser are up, or the canvas
+//                  was cleared.
+//      Accepts:    None
+//      Returns:    None
+///////////////////////////////////////////////////////////////////////////////
+void BRUSH_Lift(void)
+{
+    cDown = 0;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           BRUSH_Stroke
+//  Description:    Paints the brush along a cursor move and sends the cells
+//                  that changed, row by row from the top. A move that goes
+//                  on from the last stamp only sends the leading edge. The
+//                  terminal cursor is left on the end position.
+//      Accepts:    - unsigned char row0:   1-based row of the start
+//                  - unsigned char col0:   1-based column of the start
+//                  - unsigned char row1:   1-based row of the end
+//                  - unsigned char col1:   1-based column of the end
+//                  - char state:           CANVAS_INK or CANVAS_BLANK
+//      Returns:    None
+///////////////////////////////////////////////////////////////////////////////
+void BRUSH_Stroke(unsigned char row0, unsigned char col0, unsigned char row1, unsigned char col1, char state)
+{
+    int iRow, iBottom, iLo, iHi, i;
+    char cGoOn;
+
+    if(ucSize == 1)
+    {
+        STROKE_Line(row0, col0, row1, col1, state);
+        return;
+    }
+
+    cGoOn = cDown && ucLastRow == row0 && ucLastCol == col0 && cLastState == state;
+
+    iRow = ((row0 < row1)? row0 : row1) + scTop;
+    iBottom = ((row0 > row1)? row0 : row1) + scTop + ucSize - 1;
+    if(iRow < 1) iRow = 1;
+    if(iBottom > SCREEN_H) iBottom = SCREEN_H;
+
+    for(; iRow <= iBottom; iRow++)
+    {
+        if(!swept(iRow, row0, col0, row1, col1, &iLo, &iHi))
+            continue;
+        if(iLo < 1) iLo = 1;
+        if(iHi > SCREEN_W) iHi = SCREEN_W;
+        if(iLo > iHi)
+            continue;
+
+        // the swept span less the row of the last stamp, to its left and
+        // to its right
+        i = iRow - row0 - scTop;
+        if(cGoOn && i >= 0 && i < ucSize)
+        {
+            if(iLo < col0 + scLo[i])
+                STROKE_Span(iRow, iLo, (iHi < col0 + scLo[i])? iHi : col0 + scLo[i] - 1, state);
+            if(iHi > col0 + scHi[i])
+                STROKE_Span(iRow, (iLo > col0 + scHi[i])? iLo : col0 + scHi[i] + 1, iHi, state);
+        }
+        else
+            STROKE_Span(iRow, iLo, iHi, state);
+    }
+    TERM_MoveCursor(row1, col1);
+
+    cDown = 1;
+    ucLastRow = row1;
+    ucLastCol = col1;
+    cLastState = state;
+}
@@ -0,0 +1,37 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+//  Filename:       brush.h
+//
+//  Description:    Header file for the brush.c multi-cell brushes
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef _BRUSH_H
+#define _BRUSH_H
+
+#include "canvas.h"
+
+/////////////////////////////////// MACROS ///////////////////////////////////
+
+// brush shapes
+#define BRUSH_SQUARE    0
+#define BRUSH_ROUND     1
+
+// sizes, the width and height in cells
+#define BRUSH_MAX       8
+
+// commands received on UART2: next shape, bigger and smaller brush
+#define BRUSH_SHAPE_CMD     'b'
+#define BRUSH_BIGGER_CMD    '+'
+#define BRUSH_SMALLER_CMD   '-'
+
+///////////////////////////// FUNCTION PROTOTYPES /////////////////////////////
+
+void BRUSH_SetSize(unsigned char ucSize);
+void BRUSH_SetShape(char cShape);
+unsigned char BRUSH_Size(void);
+char BRUSH_Shape(void);
+void BRUSH_Lift(void);
+void BRUSH_Stroke(unsigned char row0, unsigned char col0, unsigned char row1, unsigned char col1, char state);
+
+#endif  // _BRUSH_H
@@ -0,0 +1,184 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+//  Filename:       button.c
+//
+//  Description:
+//  Debounced push button events, see button.h. A change of S3 or S4 raises
+//  the CN interrupt, whose ISR only notes the new level and the tick it
+//  came at; S5 has no CN input and is read by BUTTON_Step(). Stepped every
+//  tick, BUTTON_Step() accepts a level once it has held for
+//  BUTTON_DEBOUNCE_MS and queues the events, so a press is seen within a
+//  few milliseconds whatever the cursor update rate, and none is lost while
+//  the queue has room.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "button.h"
+#include "hal.h"
+#include "sched.h"
+
+// use interrupt no_auto_psv attribute to reduce interrupt overhead
+#define ISR_NO_PSV __attribute__((__interrupt__, no_auto_psv))
+
+#define BUTTON_CNT  3
+
+static const unsigned char ucBit[BUTTON_CNT] = { HAL_BTN_S3, HAL_BTN_S4, HAL_BTN_S5 };
+
+// pin levels as HAL_BTN_ bits of the pressed buttons and the tick each
+// last changed, the CN ISR writes those of the HAL_BTN_CN buttons
+static volatile unsigned char ucRaw = 0;
+static volatile unsigned int u16_changed[BUTTON_CNT];
+
+// debounced levels, the buttons BUTTON_HOLD was sent for and the tick of
+// their next BUTTON_HOLD or BUTTON_REPEAT
+static unsigned char ucStable = 0;
+static unsigned char ucHoldSent = 0;
+static unsigned int u16_next[BUTTON_CNT];
+
+// event queue, head and tail run freely, their difference is the depth
+static unsigned char ucQueue[BUTTON_QUEUE_SIZE];
+static unsigned char ucQHead = 0, ucQTail = 0;
+static unsigned long ulLost = 0;
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           noteChanges
+//  Description:    Takes new levels of the buttons in <ucWhich>, noting the
+//                  tick for those that changed
+///////////////////////////////////////////////////////////////////////////////
+static void noteChanges(unsigned char ucWhich, unsigned char ucNow)
+{
+    unsigned char ucDiff = (ucNow ^ ucRaw) & ucWhich;
+    unsigned int i;
+
+    for(i = 0; i < BUTTON_CNT; i++)
+        if(ucDiff & ucBit[i])
+            u16_changed[i] = SCHED_Ticks();
+    ucRaw ^= ucDiff;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           put
+//  Description:    Queues an event, counts it lost when the queue is full
+///////////////////////////////////////////////////////////////////////////////
+static void put(unsigned char ucEvent)
+{
+    if((unsigned char)(ucQHead - ucQTail) >= BUTTON_QUEUE_SIZE)
+    {
+        ulLost++;
+        return;
+    }
+    ucQueue[ucQHead++ & (BUTTON_QUEUE_SIZE - 1)] = ucEvent;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           CNInterrupt
+//  Description:    ISR for the change notification of S3 and S4. Reading
+//                  the port ends the mismatch before the flag is cleared.
+///////////////////////////////////////////////////////////////////////////////
+void ISR_NO_PSV _CNInterrupt(void)
+{
+    noteChanges(HAL_BTN_CN, HAL_Buttons(HAL_BTN_CN));
+    IFS1bits.CNIF = 0;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           BUTTON_Initialize
+//  Description:    Sets up the button pins and the CN interrupt. A button
+//                  held now is reported pressed after the debounce time.
+//      Accepts:    None
+//      Returns:    None
+///////////////////////////////////////////////////////////////////////////////
+void BUTTON_Initialize(void)
+{
+    unsigned int i;
+
+    HAL_ButtonsInit();
+
+    ucStable = 0;
+    ucHoldSent = 0;
+    ucQHead = ucQTail = 0;
+    ucRaw = HAL_Buttons(HAL_BTN_ALL);
+    for(i = 0; i < BUTTON_CNT; i++)
+        u16_changed[i] = SCHED_Ticks();
+
+    IPC4bits.CNIP = 2;
+    IFS1bits.CNIF = 0;
+    IEC1bits.CNIE = 1;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           BUTTON_Step
+//  Description:    Reads the buttons without a CN input, debounces all and
+//                  queues their events, to be called every tick
+//      Accepts:    None
+//      Returns:    None
+///////////////////////////////////////////////////////////////////////////////
+void BUTTON_Step(void)
+{
+    unsigned int u16_now = SCHED_Ticks();
+    unsigned char ucB;
+    unsigned int i;
+
+    // keep the CN ISR out while its levels and ticks are used
+    IEC1bits.CNIE = 0;
+    noteChanges(HAL_BTN_ALL & ~HAL_BTN_CN, HAL_Buttons(HAL_BTN_ALL & ~HAL_BTN_CN));
+
+    for(i = 0; (ucRaw | ucStable) && i < BUTTON_CNT; i++)
+    {
+        ucB = ucBit[i];
+
+        if((ucRaw ^ ucStable) & ucB)
+        {
+            if((unsigned int)(u16_now - u16_changed[i]) >= SCHED_MS(BUTTON_DEBOUNCE_MS))
+            {
+                ucStable ^= ucB;
+                ucHoldSent &= ~ucB;
+                u16_next[i] = u16_now + SCHED_MS(BUTTON_HOLD_MS);
+                put(((ucStable & ucB)? BUTTON_PRESS : BUTTON_RELEASE) | ucB);
+            }
+        }
+        // signed difference handles the tick counter wrapping
+        else if((ucStable & ucB) && (int)(u16_now - u16_next[i]) >= 0)
+        {
+            put(((ucHoldSent & ucB)? BUTTON_REPEAT : BUTTON_HOLD) | ucB);
+            ucHoldSent |= ucB;
+            u16_next[i] += SCHED_MS(BUTTON_REPEAT_MS);
+        }
+    }
+    IEC1bits.CNIE = 1;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           BUTTON_Get
+//  Description:    Takes the oldest event from the queue
+//      Accepts:    None
+//      Returns:    - unsigned char:    the event, 0 if there is none
+///////////////////////////////////////////////////////////////////////////////
+unsigned char BUTTON_Get(void)
+{
+    if(ucQHead == ucQTail)
+        return(0);
+    return(ucQueue[ucQTail++ & (BUTTON_QUEUE_SIZE - 1)]);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           BUTTON_Held
+//  Description:    Reads the debounced levels
+//      Accepts:    None
+//      Returns:    - unsigned char:    HAL_BTN_ bits of the held buttons
+///////////////////////////////////////////////////////////////////////////////
+unsigned char BUTTON_Held(void)
+{
+    return(ucStable);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           BUTTON_Lost
+//  Description:    Reports the events dropped on a full queue
+//      Accepts:    None
+//      Returns:    - unsigned long:    number of events lost
+///////////////////////////////////////////////////////////////////////////////
+unsigned long BUTTON_Lost(void)
+{
+    return(ulLost);
+}
@@ -0,0 +1,46 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+//  Filename:       button.h
+//
+//  Description:    Header file for the button.c debounced push button events
+//
+//  An event is one byte: the BUTTON_ type in the high nibble, the HAL_BTN_
+//  bit of the button in the low one. A button counts as pressed or
+//  released once its pin has kept the new level for BUTTON_DEBOUNCE_MS;
+//  held for BUTTON_HOLD_MS it raises BUTTON_HOLD, then BUTTON_REPEAT every
+//  BUTTON_REPEAT_MS until released.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef _BUTTON_H
+#define _BUTTON_H
+
+/////////////////////////////////// MACROS ///////////////////////////////////
+
+// timing in milliseconds
+#define BUTTON_DEBOUNCE_MS  10
+#define BUTTON_HOLD_MS      500
+#define BUTTON_REPEAT_MS    100
+
+// events kept until BUTTON_Get(), must be a power of two
+#define BUTTON_QUEUE_SIZE   8
+
+// event types
+#define BUTTON_PRESS        0x10
+#define BUTTON_RELEASE      0x20
+#define BUTTON_HOLD         0x40
+#define BUTTON_REPEAT       0x80
+
+// parts of an event
+#define BUTTON_TYPE(e)      ((e) & 0xF0)
+#define BUTTON_WHICH(e)     ((e) & 0x0F)
+
+///////////////////////////// FUNCTION PROTOTYPES /////////////////////////////
+
+void BUTTON_Initialize(void);
+void BUTTON_Step(void);
+unsigned char BUTTON_Get(void);
+unsigned char BUTTON_Held(void);
+unsigned long BUTTON_Lost(void);
+
+#endif  // _BUTTON_H
@@ -0,0 +1,279 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+//  Filename:       canvas.c
+//
+//  Description:    
+//  On-chip copy of the painting: one bit per cell of the SCREEN_W x SCREEN_H
+//  canvas, 1817 bytes packed, plus one dirty bit per row. A row is dirty 
+//  when the terminal may not show what the canvas holds (paint output was
+//  dropped, the terminal was reset...) and is cleaned once it has been 
+//  redrawn. A dirty row may also be marked cleared: the terminal row was 
+//  blanked and since then only received cells copied from the canvas, so
+//  its redraw can skip blank cells. Rows and columns are 1-based like the
+//  terminal's; 0 is clamped to 1 and positions past the canvas are ignored.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "canvas.h"
+
+static unsigned char ucCells[SCREEN_H][CANVAS_ROW_BYTES];
+static unsigned char ucDirty[(SCREEN_H + 7) / 8];
+static unsigned char ucCleared[(SCREEN_H + 7) / 8];
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           CANVAS_Clear
+//  Description:    Blanks every cell, the terminal is cleared alongside so
+//                  no row is dirty afterwards
+//      Accepts:    None
+//      Returns:    None
+///////////////////////////////////////////////////////////////////////////////
+void CANVAS_Clear(void)
+{
+    unsigned char* pc = &ucCells[0][0];
+    unsigned int i;
+    
+    for(i = 0; i < CANVAS_BYTES; i++)
+        pc[i] = 0;
+    for(i = 0; i < sizeof(ucDirty); i++)
+        ucDirty[i] = ucCleared[i] = 0;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           CANVAS_Get
+//  Description:    Reads a cell
+//      Accepts:    - unsigned char row:    1-based row
+//                  - unsigned char col:    1-based column
+//      Returns:    - char:     CANVAS_INK or CANVAS_BLANK
+///////////////////////////////////////////////////////////////////////////////
+char CANVAS_Get(unsigned char row, unsigned char col)
+{
+    if(row == 0) row = 1;
+    if(col == 0) col = 1;
+    if(row > SCREEN_H || col > SCREEN_W)
+        return(CANVAS_BLANK);
+    
+    col--;
+    return((ucCells[row - 1][col >> 3] >> (col & 7)) & 1);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           CANVAS_Set
+//  Description:    Writes a cell
+//      Accepts:    - unsigned char row:    1-based row
+//                  - unsigned char col:    1-based column
+//                  - char state:           CANVAS_INK or CANVAS_BLANK
+//      Returns:    - char:     1 if the cell changed, 0 if it already held
+//                              <state> and nothing needs to be sent
+///////////////////////////////////////////////////////////////////////////////
+char CANVAS_Set(unsigned char row, unsigned char col, char state)
+{
+    unsigned char* pc;
+    unsigned char mask;
+    
+    if(row == 0) row = 1;
+    if(col == 0) col = 1;
+    if(row > SCREEN_H || col > SCREEN_W)
+        return(0);
+    
+    col--;
+    pc = &ucCells[row - 1][col >> 3];
+    mask = 1 << (col & 7);
+    
+    if(((*pc & mask) != 0) == (state != CANVAS_BLANK))
+        return(0);
+    
+    *pc ^= mask;
+    return(1);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           CANVAS_SetRun
+//  Description:    Writes cells <lo> to <hi> of a row, whole bytes at once
+//      Accepts:    - unsigned char row:    1-based row, 1 to SCREEN_H
+//                  - unsigned char lo:     first 1-based column
+//                  - unsigned char hi:     last 1-based column, lo to
+//                                          SCREEN_W
+//                  - char state:           CANVAS_INK or CANVAS_BLANK
+//      Returns:    None
+///////////////////////////////////////////////////////////////////////////////
+void CANVAS_SetRun(unsigned char row, unsigned char lo, unsigned char hi, char state)
+{
+    unsigned char* pu8_row = ucCells[row - 1];
+    unsigned char u8_i;
+    
+    for(u8_i = lo - 1; u8_i < hi; u8_i++)
+    {
+        if((u8_i & 7) == 0 && u8_i + 8 <= hi)
+        {
+            pu8_row[u8_i >> 3] = state? 0xFF : 0x00;
+            u8_i += 7;
+        }
+        else if(state)
+            pu8_row[u8_i >> 3] |= 1 << (u8_i & 7);
+        else
+            pu8_row[u8_i >> 3] &= ~(1 << (u8_i & 7));
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           CANVAS_Row
+//  Description:    Gives read access to the packed cells of one row
+//      Accepts:    - unsigned char row:    1-based row, 1 to SCREEN_H
+//      Returns:    - const unsigned char*: CANVAS_ROW_BYTES bytes
+///////////////////////////////////////////////////////////////////////////////
+const unsigned char* CANVAS_Row(unsigned char row)
+{
+    return(ucCells[row - 1]);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           CANVAS_RunEnd
+//  Description:    Finds the end of the run of <state> cells starting at 
+//                  <col>, whole bytes of the run are skipped at once
+//      Accepts:    - unsigned char row:    1-based row, 1 to SCREEN_H
+//                  - unsigned char col:    1-based column, 1 to SCREEN_W
+//                  - char state:           CANVAS_INK or CANVAS_BLANK
+//      Returns:    - unsigned char:        first column after the run, 
+//                                          <col> if that cell is not 
+//                                          <state>, SCREEN_W + 1 at the most
+///////////////////////////////////////////////////////////////////////////////
+unsigned char CANVAS_RunEnd(unsigned char row, unsigned char col, char state)
+{
+    const unsigned char* pu8_row = ucCells[row - 1];
+    unsigned char u8_fill = state? 0xFF : 0x00;
+    unsigned char u8_i = col - 1;       // 0-based cell index
+    
+    while(u8_i < SCREEN_W)
+    {
+        if((u8_i & 7) == 0 && pu8_row[u8_i >> 3] == u8_fill)
+            u8_i += 8;
+        else if(((pu8_row[u8_i >> 3] >> (u8_i & 7)) & 1) == state)
+            u8_i++;
+        else
+            break;
+    }
+    
+    return((u8_i > SCREEN_W)? SCREEN_W + 1 : u8_i + 1);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           CANVAS_RunStart
+//  Description:    Finds the start of the run of <state> cells ending at
+//                  <col>, the mirror of CANVAS_RunEnd()
+//      Accepts:    - unsigned char row:    1-based row, 1 to SCREEN_H
+//                  - unsigned char col:    1-based column of a <state> 
+//                                          cell, 1 to SCREEN_W
+//                  - char state:           CANVAS_INK or CANVAS_BLANK
+//      Returns:    - unsigned char:        first column of the run
+///////////////////////////////////////////////////////////////////////////////
+unsigned char CANVAS_RunStart(unsigned char row, unsigned char col, char state)
+{
+    const unsigned char* pu8_row = ucCells[row - 1];
+    unsigned char u8_fill = state? 0xFF : 0x00;
+    unsigned char u8_i = col - 1;       // 0-based index of the first cell
+    
+    while(u8_i > 0)
+    {
+        if((u8_i & 7) == 0 && pu8_row[(u8_i >> 3) - 1] == u8_fill)
+            u8_i -= 8;
+        else if(((pu8_row[(u8_i - 1) >> 3] >> ((u8_i - 1) & 7)) & 1) == state)
+            u8_i--;
+        else
+            break;
+    }
+    
+    return(u8_i + 1);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           CANVAS_MarkDirty / CANVAS_MarkAllDirty / CANVAS_CleanRow
+//  Description:    Sets or clears the dirty bit of a row. Marking a row 
+//                  dirty also drops its cleared bit, the terminal row now
+//                  holds unknown cells.
+//      Accepts:    - unsigned char row:    1-based row, 1 to SCREEN_H
+//      Returns:    None
+///////////////////////////////////////////////////////////////////////////////
+void CANVAS_MarkDirty(unsigned char row)
+{
+    row--;
+    ucDirty[row >> 3] |= 1 << (row & 7);
+    ucCleared[row >> 3] &= ~(1 << (row & 7));
+}
+
+void CANVAS_MarkAllDirty(void)
+{
+    unsigned char row;
+    
+    for(row = 1; row <= SCREEN_H; row++)
+        CANVAS_MarkDirty(row);
+}
+
+void CANVAS_CleanRow(unsigned char row)
+{
+    row--;
+    ucDirty[row >> 3] &= ~(1 << (row & 7));
+    ucCleared[row >> 3] &= ~(1 << (row & 7));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           CANVAS_MarkAllCleared
+//  Description:    Marks every row dirty and cleared, call once the terminal
+//                  screen has been erased
+//      Accepts:    None
+//      Returns:    None
+///////////////////////////////////////////////////////////////////////////////
+void CANVAS_MarkAllCleared(void)
+{
+    unsigned int i;
+    
+    for(i = 0; i < sizeof(ucDirty); i++)
+        ucDirty[i] = ucCleared[i] = 0xFF;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           CANVAS_IsCleared
+//  Description:    Tests the cleared bit of a row
+//      Accepts:    - unsigned char row:    1-based row, 1 to SCREEN_H
+//      Returns:    - char:     1 if the terminal row only holds blanks and
+//                              cells copied from the canvas
+///////////////////////////////////////////////////////////////////////////////
+char CANVAS_IsCleared(unsigned char row)
+{
+    row--;
+    return((ucCleared[row >> 3] >> (row & 7)) & 1);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           CANVAS_IsDirty
+//  Description:    Tests the dirty bit of a row
+//      Accepts:    - unsigned char row:    1-based row, 1 to SCREEN_H
+//      Returns:    - char:     1 if dirty
+///////////////////////////////////////////////////////////////////////////////
+char CANVAS_IsDirty(unsigned char row)
+{
+    row--;
+    return((ucDirty[row >> 3] >> (row & 7)) & 1);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           CANVAS_NextDirty
+//  Description:    Finds the first dirty row at or after <row>, skipping 8
+//                  clean rows at a time
+//      Accepts:    - unsigned char row:    1-based row to start from
+//      Returns:    - unsigned char:        dirty row, 0 if there is none
+///////////////////////////////////////////////////////////////////////////////
+unsigned char CANVAS_NextDirty(unsigned char row)
+{
+    if(row == 0) row = 1;
+    
+    while(row <= SCREEN_H)
+    {
+        if(ucDirty[(row - 1) >> 3] == 0 && ((row - 1) & 7) == 0)
+            row += 8;
+        else if(CANVAS_IsDirty(row))
+            return(row);
+        else
+            row++;
+    }
+    return(0);
+}
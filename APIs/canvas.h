@@ -0,0 +1,42 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+//  Filename:       canvas.h
+//
+//  Description:    Header file for the canvas.c shadow framebuffer
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef _CANVAS_H
+#define _CANVAS_H
+
+#include "XZsensor.h"
+
+/////////////////////////////////// MACROS ///////////////////////////////////
+
+// packed 1-bit cells, one row is CANVAS_ROW_BYTES bytes, column 1 in bit 0
+#define CANVAS_ROW_BYTES    ((SCREEN_W + 7) / 8)
+#define CANVAS_BYTES        (SCREEN_H * CANVAS_ROW_BYTES)
+
+// cell states
+#define CANVAS_BLANK    0
+#define CANVAS_INK      1
+
+///////////////////////////// FUNCTION PROTOTYPES /////////////////////////////
+
+void CANVAS_Clear(void);
+char CANVAS_Get(unsigned char row, unsigned char col);
+char CANVAS_Set(unsigned char row, unsigned char col, char state);
+void CANVAS_SetRun(unsigned char row, unsigned char lo, unsigned char hi, char state);
+const unsigned char* CANVAS_Row(unsigned char row);
+unsigned char CANVAS_RunEnd(unsigned char row, unsigned char col, char state);
+unsigned char CANVAS_RunStart(unsigned char row, unsigned char col, char state);
+
+void CANVAS_MarkDirty(unsigned char row);
+void CANVAS_MarkAllDirty(void);
+void CANVAS_CleanRow(unsigned char row);
+void CANVAS_MarkAllCleared(void);
+char CANVAS_IsCleared(unsigned char row);
+char CANVAS_IsDirty(unsigned char row);
+unsigned char CANVAS_NextDirty(unsigned char row);
+
+#endif  // _CANVAS_H
@@ -0,0 +1,305 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+//  Filename:       fill.c
+//
+//  Description:
+//  Flood fill of the canvas: the cells 4-connected to the seed cell that
+//  hold the other state than the fill take the fill state. A scanline fill
+//  works on spans, the longest runs of such cells on a row: it fills one,
+//  then looks for more on the rows above and below it. Each filled span
+//  goes out through STROKE_Span() as one cursor move and one run, so a
+//  fill is sent in about as many bytes as the rows it covers.
+//
+//  The spans still to look at are seeds on a stack of FILL_STACK entries,
+//  no recursion. A seed is a span of the row next to a filled one, in the
+//  direction it came from; the parts of a filled span that stick out past
+//  its seed are seeded back the other way. Combs and spirals can need more
+//  seeds than the stack holds: the seed is then dropped and its row marked,
+//  and once the stack is empty a marked row is scanned again for spans
+//  next to cells of this fill, which a bitmap of the filled cells tells
+//  apart from ink already there. The result does not depend on the stack
+//  size, only the time does.
+//
+//  FILL_Step() does the work a bit at a time while the UART2 Tx ring has
+//  room for a span, like REDRAW_Step(), so a fill of the whole screen
+//  neither holds up the cursor nor drops output.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "fill.h"
+#include "stroke.h"
+#include "uart2.h"
+
+#if CANVAS_BYTES + FILL_RAM > FILL_RAM_MAX
+#error "the canvas and the fill take more than FILL_RAM_MAX of RAM"
+#endif
+
+typedef struct
+{
+    unsigned char ucRow;
+    unsigned char ucLo, ucHi;
+    signed char scDir;          // row of the span it came from: ucRow - scDir
+} FILL_SEED;
+
+static FILL_SEED sStack[FILL_STACK];
+static unsigned int uiTop = 0;
+
+// deepest the stack got and seeds dropped, since FILL_Start()
+static unsigned int uiPeak = 0;
+static unsigned int uiDropped = 0;
+
+// seed being looked at, spans of it left of ucLo are done
+static FILL_SEED sSeed;
+static char cSeed = 0;
+
+// cells filled, rows with dropped seeds and the marked row being rescanned
+static unsigned char ucFilled[SCREEN_H][CANVAS_ROW_BYTES];
+static unsigned char ucDropped[(SCREEN_H + 7) / 8];
+static unsigned char ucScanRow = 0, ucScanCol;
+
+static char cActive = 0;
+static char cState;
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           push
+//  Description:    Adds a seed, or marks its row for a rescan if the stack
+//                  is full; rows past the canvas are left out
+///////////////////////////////////////////////////////////////////////////////
+static void push(int iRow, unsigned char ucLo, unsigned char ucHi, signed char scDir)
+{
+    if(iRow < 1 || iRow > SCREEN_H)
+        return;
+
+    if(uiTop < FILL_STACK)
+    {
+        sStack[uiTop].ucRow = iRow;
+        sStack[uiTop].ucLo = ucLo;
+        sStack[uiTop].ucHi = ucHi;
+        sStack[uiTop].scDir = scDir;
+        uiTop++;
+        if(uiTop > uiPeak)
+            uiPeak = uiTop;
+    }
+    else
+    {
+        uiDropped++;
+        iRow--;
+        ucDropped[iRow >> 3] |= 1 << (iRow & 7);
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           fillSpan
+//  Description:    Fills and sends a span, and records its cells as filled
+///////////////////////////////////////////////////////////////////////////////
+static void fillSpan(unsigned char row, unsigned char ucLo, unsigned char ucHi)
+{
+    unsigned char* pu8_row = ucFilled[row - 1];
+    unsigned char u8_i;
+
+    STROKE_Span(row, ucLo, ucHi, cState);
+
+    for(u8_i = ucLo - 1; u8_i < ucHi; u8_i++)
+    {
+        if((u8_i & 7) == 0 && u8_i + 8 <= ucHi)
+        {
+            pu8_row[u8_i >> 3] = 0xFF;
+            u8_i += 7;
+        }
+        else
+            pu8_row[u8_i >> 3] |= 1 << (u8_i & 7);
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           touches
+//  Description:    Tests whether a span of <row> lies next to a filled cell
+//                  of the row above or below it
+///////////////////////////////////////////////////////////////////////////////
+static char touches(unsigned char row, unsigned char ucLo, unsigned char ucHi)
+{
+    unsigned char u8_i, u8_bits;
+
+    for(u8_i = ucLo - 1; u8_i < ucHi; u8_i++)
+    {
+        u8_bits = 0;
+        if(row > 1)
+            u8_bits |= ucFilled[row - 2][u8_i >> 3];
+        if(row < SCREEN_H)
+            u8_bits |= ucFilled[row][u8_i >> 3];
+        if((u8_bits >> (u8_i & 7)) & 1)
+            return(1);
+    }
+    return(0);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           nextDropped
+//  Description:    Takes the first row marked for a rescan
+//      Returns:    the row, 0 if none is marked
+///////////////////////////////////////////////////////////////////////////////
+static unsigned char nextDropped(void)
+{
+    unsigned char u8_i;
+
+    for(u8_i = 0; u8_i < SCREEN_H; u8_i++)
+    {
+        if((u8_i & 7) == 0 && ucDropped[u8_i >> 3] == 0)
+            u8_i += 7;
+        else if((ucDropped[u8_i >> 3] >> (u8_i & 7)) & 1)
+        {
+            ucDropped[u8_i >> 3] &= ~(1 << (u8_i & 7));
+            return(u8_i + 1);
+        }
+    }
+    return(0);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           FILL_Start
+//  Description:    Starts a fill from a cell, sent by the next FILL_Step()s.
+//                  Ignored while a fill is underway, or if the cell already
+//                  holds <state>.
+//      Accepts:    - unsigned char row:    1-based row of the seed cell
+//                  - unsigned char col:    1-based column of the seed cell
+//                  - char state:           CANVAS_INK or CANVAS_BLANK
+//      Returns:    None
+///////////////////////////////////////////////////////////////////////////////
+void FILL_Start(unsigned char row, unsigned char col, char state)
+{
+    unsigned char* pc = &ucFilled[0][0];
+    unsigned int i;
+
+    if(cActive || row < 1 || row > SCREEN_H || col < 1 || col > SCREEN_W
+       || CANVAS_Get(row, col) == state)
+        return;
+
+    for(i = 0; i < sizeof(ucFilled); i++)
+        pc[i] = 0;
+    for(i = 0; i < sizeof(ucDropped); i++)
+        ucDropped[i] = 0;
+
+    // the seed cell as a span coming from above, and the cell above it
+    // as one coming from below since no row was filled before
+    cState = state;
+    uiTop = 0;
+    uiPeak = 0;
+    uiDropped = 0;
+    cSeed = 0;
+    ucScanRow = 0;
+    push(row - 1, col, col, -1);
+    push(row, col, col, 1);
+    cActive = 1;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           FILL_Step
+//  Description:    Fills up to FILL_STEP_MAX spans, or looks at as many
+//                  seeds, while the UART2 Tx ring has room for a span
+//      Accepts:    None
+//      Returns:    - char:     1 while the fill is underway
+///////////////////////////////////////////////////////////////////////////////
+char FILL_Step(void)
+{
+    unsigned char u8_n, u8_lo, u8_hi;
+    char target = !cState;
+
+    for(u8_n = 0; cActive && u8_n < FILL_STEP_MAX; u8_n++)
+    {
+        if(txFreeUART2() < FILL_SPAN_MAX)
+            return(1);
+
+        if(!cSeed && uiTop)
+        {
+            sSeed = sStack[--uiTop];
+            cSeed = 1;
+        }
+
+        if(cSeed)
+        {
+            // next span of the seed, grown to its whole run on the row
+            u8_lo = CANVAS_RunEnd(sSeed.ucRow, sSeed.ucLo, cState);
+            if(u8_lo > sSeed.ucHi)
+            {
+                cSeed = 0;
+                continue;
+            }
+            u8_lo = CANVAS_RunStart(sSeed.ucRow, u8_lo, target);
+            u8_hi = CANVAS_RunEnd(sSeed.ucRow, u8_lo, target) - 1;
+            fillSpan(sSeed.ucRow, u8_lo, u8_hi);
+
+            push(sSeed.ucRow + sSeed.scDir, u8_lo, u8_hi, sSeed.scDir);
+            if(u8_lo < sSeed.ucLo)
+                push(sSeed.ucRow - sSeed.scDir, u8_lo, sSeed.ucLo - 1, -sSeed.scDir);
+            if(u8_hi > sSeed.ucHi)
+                push(sSeed.ucRow - sSeed.scDir, sSeed.ucHi + 1, u8_hi, -sSeed.scDir);
+
+            // the cell after the span is not a target, go on past it
+            if(u8_hi + 2 > sSeed.ucHi)
+                cSeed = 0;
+            else
+                sSeed.ucLo = u8_hi + 2;
+        }
+        else if(ucScanRow)
+        {
+            // next span of the rescanned row, filled if next to the fill
+            u8_lo = CANVAS_RunEnd(ucScanRow, ucScanCol, cState);
+            if(u8_lo > SCREEN_W)
+            {
+                ucScanRow = 0;
+                continue;
+            }
+            u8_hi = CANVAS_RunEnd(ucScanRow, u8_lo, target) - 1;
+            ucScanCol = (u8_hi < SCREEN_W)? u8_hi + 1 : u8_hi;
+            if(touches(ucScanRow, u8_lo, u8_hi))
+            {
+                fillSpan(ucScanRow, u8_lo, u8_hi);
+                push(ucScanRow - 1, u8_lo, u8_hi, -1);
+                push(ucScanRow + 1, u8_lo, u8_hi, 1);
+            }
+            if(u8_hi >= SCREEN_W)
+                ucScanRow = 0;
+        }
+        else if((ucScanRow = nextDropped()) != 0)
+            ucScanCol = 1;
+        else
+            cActive = 0;
+    }
+
+    return(cActive);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           FILL_Cancel
+//  Description:    Stops a fill underway, e.g. the canvas was cleared; the
+//                  cells already filled stay
+//      Accepts:    None
+//      Returns:    None
+///////////////////////////////////////////////////////////////////////////////
+void FILL_Cancel(void)
+{
+    cActive = 0;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           FILL_Peak
+//  Description:    Reports the deepest the seed stack got in the last fill
+//      Accepts:    None
+//      Returns:    - unsigned int:     seeds, at most FILL_STACK
+///////////////////////////////////////////////////////////////////////////////
+unsigned int FILL_Peak(void)
+{
+    return(uiPeak);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           FILL_Dropped
+//  Description:    Reports the seeds of the last fill dropped on a full
+//                  stack, whose rows were rescanned instead
+//      Accepts:    None
+//      Returns:    - unsigned int:     number of seeds dropped
+///////////////////////////////////////////////////////////////////////////////
+unsigned int FILL_Dropped(void)
+{
+    return(uiDropped);
+}
@@ -0,0 +1,49 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+//  Filename:       fill.h
+//
+//  Description:    Header file for the fill.c scanline flood fill
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef _FILL_H
+#define _FILL_H
+
+#include "canvas.h"
+#include "term.h"
+
+/////////////////////////////////// MACROS ///////////////////////////////////
+
+// seeds waiting on the stack, 4 bytes each; past that a seed is dropped
+// and its row rescanned once the stack is empty
+#define FILL_STACK      64
+
+// RAM of the fill: the seed stack, a bitmap of the cells it filled, as
+// large as the canvas since only it tells them apart from ink that was
+// there before, and a bit per row to rescan; 2083 bytes at 184x79, the
+// most of any module. The canvas and the fill may take FILL_RAM_MAX of
+// the 8 KB together, fill.c stops the build past that, and the linker
+// keeps at least 512 bytes for the stack after all the statics
+// (stack-size in nbproject/configurations.xml).
+#define FILL_RAM        (FILL_STACK * 4 + CANVAS_BYTES + (SCREEN_H + 7) / 8)
+#define FILL_RAM_MAX    4096
+
+// spans filled or seeds looked at per FILL_Step()
+#define FILL_STEP_MAX   32
+
+// longest output of one span: a move to its start and one ink character
+// and REP, or one ECH
+#define FILL_SPAN_MAX   (TERM_SEQ_MAX + 1 + FMT_CSI_MAX)
+
+// fill command received on UART2: fills the blank area around the cursor
+#define FILL_CMD        'f'
+
+///////////////////////////// FUNCTION PROTOTYPES /////////////////////////////
+
+void FILL_Start(unsigned char row, unsigned char col, char state);
+char FILL_Step(void);
+void FILL_Cancel(void);
+unsigned int FILL_Peak(void);
+unsigned int FILL_Dropped(void);
+
+#endif  // _FILL_H
@@ -0,0 +1,146 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+//  Filename:       filter.c
+//
+//  Description:    
+//  Noise filters for the XZ sensor coordinates, run on every sample before
+//  the cursor update so sensor jitter does not move the cursor. All in 
+//  integer and fixed-point math:
+//  - moving average of FILTER_MA_LEN samples, a running sum and a shift
+//  - exponential smoothing, y += alpha * (x - y) in Q8.8
+//  - 1-euro: exponential smoothing whose weight grows with the speed of 
+//    the hand, heavy smoothing while it holds still and little lag while 
+//    it moves; one division per sample
+//  FILTER_Select() changes the filter of every axis at run time.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "filter.h"
+
+static unsigned char u8_selected = FILTER_DEFAULT;
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           smooth
+//  Description:    y += alpha * (x - y), y in Q8.8 and alpha in Q0.8
+///////////////////////////////////////////////////////////////////////////////
+static unsigned int smooth(unsigned int u16_y, unsigned int u16_x, unsigned int u16_alpha)
+{
+    long i32_d = (long)u16_x - (long)u16_y;
+    
+    return((unsigned int)((long)u16_y + ((i32_d * (long)u16_alpha) >> 8)));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           round8
+//  Description:    Q8.8 to the nearest integer
+///////////////////////////////////////////////////////////////////////////////
+static unsigned char round8(unsigned int u16_y)
+{
+    return((u16_y + 0x80) >> 8);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           movingAverage / exponential / oneEuro
+//  Description:    The filters, each takes a sample and returns the output
+///////////////////////////////////////////////////////////////////////////////
+static unsigned char movingAverage(FILTER_AXIS* pAxis, unsigned char u8_x)
+{
+    pAxis->u16_maSum += u8_x - pAxis->ucMa[pAxis->ucMaIdx];
+    pAxis->ucMa[pAxis->ucMaIdx] = u8_x;
+    pAxis->ucMaIdx = (pAxis->ucMaIdx + 1) & (FILTER_MA_LEN - 1);
+    
+    return((pAxis->u16_maSum + FILTER_MA_LEN / 2) / FILTER_MA_LEN);
+}
+
+static unsigned char exponential(FILTER_AXIS* pAxis, unsigned char u8_x)
+{
+    pAxis->u16_y = smooth(pAxis->u16_y, (unsigned int)u8_x << 8, FILTER_EMA_ALPHA);
+    
+    return(round8(pAxis->u16_y));
+}
+
+static unsigned char oneEuro(FILTER_AXIS* pAxis, unsigned char u8_x)
+{
+    unsigned int u16_dx, u16_w, u16_alpha;
+    unsigned long u32_w;
+    
+    // smoothed speed in counts per sample
+    u16_dx = (u8_x > pAxis->ucLast)? u8_x - pAxis->ucLast : pAxis->ucLast - u8_x;
+    pAxis->u16_speed = smooth(pAxis->u16_speed, u16_dx << 8, FILTER_EURO_DALPHA);
+    
+    // cutoff from the speed, then the weight of the sample
+    u32_w = FILTER_EURO_WMIN + (((unsigned long)FILTER_EURO_BETA * pAxis->u16_speed) >> 8);
+    u16_w = (u32_w > 0x7FFF)? 0x7FFF : (unsigned int)u32_w;
+    u16_alpha = ((unsigned long)u16_w << 8) / (u16_w + 256);
+    
+    pAxis->u16_y = smooth(pAxis->u16_y, (unsigned int)u8_x << 8, u16_alpha);
+    return(round8(pAxis->u16_y));
+}
+
+static unsigned char none(FILTER_AXIS* pAxis, unsigned char u8_x)
+{
+    return(u8_x);
+}
+
+static unsigned char (*const pfFilters[FILTER_COUNT])(FILTER_AXIS*, unsigned char) = {
+    none, movingAverage, exponential, oneEuro
+};
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           FILTER_Select / FILTER_Selected
+//  Description:    Sets or reads the filter used by FILTER_Apply(); axes 
+//                  must be reset after a change
+//      Accepts:    - unsigned char u8_kind:    FILTER_ value
+//      Returns:    - unsigned char:            FILTER_Selected(), the filter
+///////////////////////////////////////////////////////////////////////////////
+void FILTER_Select(unsigned char u8_kind)
+{
+    if(u8_kind < FILTER_COUNT)
+        u8_selected = u8_kind;
+}
+
+unsigned char FILTER_Selected(void)
+{
+    return(u8_selected);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           FILTER_Reset
+//  Description:    Forgets the history of an axis, the next sample is taken
+//                  as is
+//      Accepts:    - FILTER_AXIS* pAxis:   axis state
+//      Returns:    None
+///////////////////////////////////////////////////////////////////////////////
+void FILTER_Reset(FILTER_AXIS* pAxis)
+{
+    pAxis->ucPrimed = 0;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           FILTER_Apply
+//  Description:    Filters one sample of an axis
+//      Accepts:    - FILTER_AXIS* pAxis:   axis state
+//                  - unsigned char u8_x:   sensor coordinate
+//      Returns:    - unsigned char:        filtered coordinate
+///////////////////////////////////////////////////////////////////////////////
+unsigned char FILTER_Apply(FILTER_AXIS* pAxis, unsigned char u8_x)
+{
+    unsigned char u8_i, u8_y;
+    
+    // start every filter settled on the first sample
+    if(!pAxis->ucPrimed)
+    {
+        for(u8_i = 0; u8_i < FILTER_MA_LEN; u8_i++)
+            pAxis->ucMa[u8_i] = u8_x;
+        pAxis->ucMaIdx = 0;
+        pAxis->u16_maSum = (unsigned int)u8_x * FILTER_MA_LEN;
+        pAxis->u16_y = (unsigned int)u8_x << 8;
+        pAxis->u16_speed = 0;
+        pAxis->ucLast = u8_x;
+        pAxis->ucPrimed = 1;
+    }
+    
+    u8_y = pfFilters[u8_selected](pAxis, u8_x);
+    pAxis->ucLast = u8_x;
+    return(u8_y);
+}
@@ -0,0 +1,70 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+//  Filename:       filter.h
+//
+//  Description:    Header file for the filter.c sample noise filters
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef _FILTER_H
+#define _FILTER_H
+
+/////////////////////////////////// MACROS ///////////////////////////////////
+
+// filters, see FILTER_Select()
+#define FILTER_NONE     0       // raw samples
+#define FILTER_MA       1       // moving average
+#define FILTER_EMA      2       // exponential smoothing
+#define FILTER_EURO     3       // 1-euro, adaptive exponential smoothing
+#define FILTER_COUNT    4
+
+#ifndef FILTER_DEFAULT
+#define FILTER_DEFAULT  FILTER_EURO
+#endif
+
+// moving average length in samples, a power of two
+#define FILTER_MA_LEN   4
+
+// exponential smoothing weight of a new sample, Q0.8
+#ifndef FILTER_EMA_ALPHA
+#define FILTER_EMA_ALPHA    64
+#endif
+
+// 1-euro parameters, per sample rather than per second, so they hold for 
+// the sensor's sample rate (100 Hz): the smoothing of a sample is w/(w+1), 
+// with w = 2*pi*fc/rate in Q8.8 and the cutoff fc rising with the speed in
+// counts per sample, which is smoothed with a fixed weight
+#ifndef FILTER_EURO_WMIN
+#define FILTER_EURO_WMIN    16      // fc min = 1 Hz
+#endif
+#ifndef FILTER_EURO_BETA
+#define FILTER_EURO_BETA    72      // w per count/sample, Q8.8
+#endif
+#define FILTER_EURO_DALPHA  15      // speed weight, Q0.8, 1 Hz cutoff
+
+#if FILTER_MA_LEN & (FILTER_MA_LEN - 1)
+#error "FILTER_MA_LEN must be a power of two"
+#endif
+
+/////////////////////////////////// TYPES ////////////////////////////////////
+
+// state of one axis, shared by the filters
+typedef struct
+{
+    unsigned char ucPrimed;                 // 0 until the first sample
+    unsigned char ucLast;                   // previous input
+    unsigned char ucMaIdx;
+    unsigned char ucMa[FILTER_MA_LEN];
+    unsigned int u16_maSum;
+    unsigned int u16_y;                     // smoothed value, Q8.8
+    unsigned int u16_speed;                 // smoothed |dx|, Q8.8
+} FILTER_AXIS;
+
+///////////////////////////// FUNCTION PROTOTYPES /////////////////////////////
+
+void FILTER_Select(unsigned char u8_kind);
+unsigned char FILTER_Selected(void);
+void FILTER_Reset(FILTER_AXIS* pAxis);
+unsigned char FILTER_Apply(FILTER_AXIS* pAxis, unsigned char u8_x);
+
+#endif  // _FILTER_H
@@ -0,0 +1,178 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+//  Filename:       fmt.c
+//
+//  Description:    
+//  Allocation-free number and escape sequence formatting. Every function 
+//  writes into a caller buffer, adds no terminating null and returns the
+//  number of characters written, so sequences can be appended with 
+//  "n += FMT_...(pBuff + n, ...)". The matching ...Len functions return
+//  the same length without writing, for picking the shortest encoding.
+//
+//  Bytes are converted through a BCD table held in program memory instead
+//  of dividing by 10 and 100.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "fmt.h"
+
+// u16BcdTable[v]: v in BCD, hundreds in bits 11-8, tens 7-4, units 3-0
+static const unsigned int u16BcdTable[256] = {
+    0x000, 0x001, 0x002, 0x003, 0x004, 0x005, 0x006, 0x007, 0x008, 0x009,
+    0x010, 0x011, 0x012, 0x013, 0x014, 0x015, 0x016, 0x017, 0x018, 0x019,
+    0x020, 0x021, 0x022, 0x023, 0x024, 0x025, 0x026, 0x027, 0x028, 0x029,
+    0x030, 0x031, 0x032, 0x033, 0x034, 0x035, 0x036, 0x037, 0x038, 0x039,
+    0x040, 0x041, 0x042, 0x043, 0x044, 0x045, 0x046, 0x047, 0x048, 0x049,
+    0x050, 0x051, 0x052, 0x053, 0x054, 0x055, 0x056, 0x057, 0x058, 0x059,
+    0x060, 0x061, 0x062, 0x063, 0x064, 0x065, 0x066, 0x067, 0x068, 0x069,
+    0x070, 0x071, 0x072, 0x073, 0x074, 0x075, 0x076, 0x077, 0x078, 0x079,
+    0x080, 0x081, 0x082, 0x083, 0x084, 0x085, 0x086, 0x087, 0x088, 0x089,
+    0x090, 0x091, 0x092, 0x093, 0x094, 0x095, 0x096, 0x097, 0x098, 0x099,
+    0x100, 0x101, 0x102, 0x103, 0x104, 0x105, 0x106, 0x107, 0x108, 0x109,
+    0x110, 0x111, 0x112, 0x113, 0x114, 0x115, 0x116, 0x117, 0x118, 0x119,
+    0x120, 0x121, 0x122, 0x123, 0x124, 0x125, 0x126, 0x127, 0x128, 0x129,
+    0x130, 0x131, 0x132, 0x133, 0x134, 0x135, 0x136, 0x137, 0x138, 0x139,
+    0x140, 0x141, 0x142, 0x143, 0x144, 0x145, 0x146, 0x147, 0x148, 0x149,
+    0x150, 0x151, 0x152, 0x153, 0x154, 0x155, 0x156, 0x157, 0x158, 0x159,
+    0x160, 0x161, 0x162, 0x163, 0x164, 0x165, 0x166, 0x167, 0x168, 0x169,
+    0x170, 0x171, 0x172, 0x173, 0x174, 0x175, 0x176, 0x177, 0x178, 0x179,
+    0x180, 0x181, 0x182, 0x183, 0x184, 0x185, 0x186, 0x187, 0x188, 0x189,
+    0x190, 0x191, 0x192, 0x193, 0x194, 0x195, 0x196, 0x197, 0x198, 0x199,
+    0x200, 0x201, 0x202, 0x203, 0x204, 0x205, 0x206, 0x207, 0x208, 0x209,
+    0x210, 0x211, 0x212, 0x213, 0x214, 0x215, 0x216, 0x217, 0x218, 0x219,
+    0x220, 0x221, 0x222, 0x223, 0x224, 0x225, 0x226, 0x227, 0x228, 0x229,
+    0x230, 0x231, 0x232, 0x233, 0x234, 0x235, 0x236, 0x237, 0x238, 0x239,
+    0x240, 0x241, 0x242, 0x243, 0x244, 0x245, 0x246, 0x247, 0x248, 0x249,
+    0x250, 0x251, 0x252, 0x253, 0x254, 0x255
+};
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           FMT_U8Len
+//  Description:    Number of decimal digits of a byte
+//      Accepts:    - unsigned char u8_v:   value
+//      Returns:    - unsigned int:         1 to FMT_U8_MAX
+///////////////////////////////////////////////////////////////////////////////
+unsigned int FMT_U8Len(unsigned char u8_v)
+{
+    return((u8_v >= 100)? 3 : (u8_v >= 10)? 2 : 1);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           FMT_U8
+//  Description:    Writes a byte in decimal without leading zeros
+//      Accepts:    - char* pBuff:          buffer of at least FMT_U8_MAX
+//                  - unsigned char u8_v:   value
+//      Returns:    - unsigned int:         characters written
+///////////////////////////////////////////////////////////////////////////////
+unsigned int FMT_U8(char* pBuff, unsigned char u8_v)
+{
+    unsigned int u16_bcd = u16BcdTable[u8_v];
+    unsigned int u16_n = 0;
+    
+    if(u8_v >= 100)
+        pBuff[u16_n++] = '0' + (u16_bcd >> 8);
+    if(u8_v >= 10)
+        pBuff[u16_n++] = '0' + ((u16_bcd >> 4) & 0x0F);
+    pBuff[u16_n++] = '0' + (u16_bcd & 0x0F);
+    
+    return(u16_n);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           FMT_U32
+//  Description:    Writes a 32-bit value in decimal, right aligned in a 
+//                  field of spaces. Two digits are taken per division, from 
+//                  the BCD table. Meant for reports, not the paint output.
+//      Accepts:    - char* pBuff:              buffer of at least 
+//                                              max(FMT_U32_MAX, u16_width)
+//                  - unsigned long u32_v:      value
+//                  - unsigned int u16_width:   field width, 0 for none
+//      Returns:    - unsigned int:             characters written
+///////////////////////////////////////////////////////////////////////////////
+unsigned int FMT_U32(char* pBuff, unsigned long u32_v, unsigned int u16_width)
+{
+    char digits[FMT_U32_MAX];
+    unsigned int u16_bcd, u16_d = FMT_U32_MAX, u16_n = 0;
+    
+    // two digits at a time from the right
+    do
+    {
+        u16_bcd = u16BcdTable[(unsigned char)(u32_v % 100)];
+        u32_v /= 100;
+        digits[--u16_d] = '0' + (u16_bcd & 0x0F);
+        digits[--u16_d] = '0' + ((u16_bcd >> 4) & 0x0F);
+    } while(u32_v);
+    
+    // one leading zero of the last pair, unless the value is 0
+    if(digits[u16_d] == '0' && u16_d < FMT_U32_MAX - 1)
+        u16_d++;
+    
+    while(u16_width > FMT_U32_MAX - u16_d + u16_n)
+        pBuff[u16_n++] = ' ';
+    while(u16_d < FMT_U32_MAX)
+        pBuff[u16_n++] = digits[u16_d++];
+    
+    return(u16_n);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           FMT_CsiLen / FMT_Csi
+//  Description:    Control sequence with one count, "\033[<n><final>", e.g.
+//                  CUF/CUB/CUU/CUD, REP or ECH. The count is omitted for 1,
+//                  the default of those sequences.
+//      Accepts:    - char* pBuff:          buffer of at least FMT_CSI_MAX
+//                  - unsigned char u8_n:   count
+//                  - char final:           final byte, e.g. 'C' for CUF
+//      Returns:    - unsigned int:         sequence length
+///////////////////////////////////////////////////////////////////////////////
+unsigned int FMT_CsiLen(unsigned char u8_n)
+{
+    return((u8_n == 1)? 3 : 3 + FMT_U8Len(u8_n));
+}
+
+unsigned int FMT_Csi(char* pBuff, unsigned char u8_n, char final)
+{
+    unsigned int u16_n = 2;
+    
+    pBuff[0] = '\033';
+    pBuff[1] = '[';
+    if(u8_n != 1)
+        u16_n += FMT_U8(pBuff + 2, u8_n);
+    pBuff[u16_n++] = final;
+    
+    return(u16_n);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           FMT_CupLen / FMT_Cup
+//  Description:    Cursor position "\033[<row>;<col>H", 1-based, defaults 
+//                  of 1 omitted
+//      Accepts:    - char* pBuff:          buffer of at least FMT_CUP_MAX
+//                  - unsigned char row:    1-based row
+//                  - unsigned char col:    1-based column
+//      Returns:    - unsigned int:         sequence length
+///////////////////////////////////////////////////////////////////////////////
+unsigned int FMT_CupLen(unsigned char row, unsigned char col)
+{
+    if(col == 1)
+        return((row == 1)? 3 : 3 + FMT_U8Len(row));
+    return(4 + FMT_U8Len(col) + ((row == 1)? 0 : FMT_U8Len(row)));
+}
+
+unsigned int FMT_Cup(char* pBuff, unsigned char row, unsigned char col)
+{
+    unsigned int u16_n = 2;
+    
+    pBuff[0] = '\033';
+    pBuff[1] = '[';
+    if(row != 1)
+        u16_n += FMT_U8(pBuff + u16_n, row);
+    if(col != 1)
+    {
+        pBuff[u16_n++] = ';';
+        u16_n += FMT_U8(pBuff + u16_n, col);
+    }
+    pBuff[u16_n++] = 'H';
+    
+    return(u16_n);
+}
@@ -0,0 +1,30 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+//  Filename:       fmt.h
+//
+//  Description:    Header file for the fmt.c number and escape formatting
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef _FMT_H
+#define _FMT_H
+
+/////////////////////////////////// MACROS ///////////////////////////////////
+
+// longest outputs: "255", "4294967295", "\033[255C", "\033[255;255H"
+#define FMT_U8_MAX      3
+#define FMT_U32_MAX     10
+#define FMT_CSI_MAX     6
+#define FMT_CUP_MAX     10
+
+///////////////////////////// FUNCTION PROTOTYPES /////////////////////////////
+
+unsigned int FMT_U8Len(unsigned char u8_v);
+unsigned int FMT_U8(char* pBuff, unsigned char u8_v);
+unsigned int FMT_U32(char* pBuff, unsigned long u32_v, unsigned int u16_width);
+unsigned int FMT_CsiLen(unsigned char u8_n);
+unsigned int FMT_Csi(char* pBuff, unsigned char u8_n, char final);
+unsigned int FMT_CupLen(unsigned char row, unsigned char col);
+unsigned int FMT_Cup(char* pBuff, unsigned char row, unsigned char col);
+
+#endif  // _FMT_H
@@ -0,0 +1,46 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+//  Filename:       hal.c
+//
+//  Description:    
+//  Board wiring of the Explorer16, see hal.h. On the host the pins are 
+//  driven by sim/sim_app.c.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "hal.h"
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           HAL_ButtonsInit
+//  Description:    Makes the push button pins inputs and enables the change
+//                  notification of those on CN inputs, the CN interrupt is
+//                  left to the caller
+//      Accepts:    None
+//      Returns:    None
+///////////////////////////////////////////////////////////////////////////////
+void HAL_ButtonsInit(void)
+{
+    TRISDbits.TRISD6 = 1;       // pushbutton S3
+    TRISDbits.TRISD13 = 1;      // pushbutton S4
+    TRISAbits.TRISA7 = 1;       // pushbutton S5
+    
+    CNEN1bits.CN15IE = 1;       // S3 on RD6
+    CNEN2bits.CN19IE = 1;       // S4 on RD13
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           HAL_Buttons
+//  Description:    Reads the push buttons, only the port of those asked for
+//      Accepts:    - unsigned char ucWhich:    HAL_BTN_ bits to read
+//      Returns:    - unsigned char:    HAL_BTN_ bits of the pressed buttons
+///////////////////////////////////////////////////////////////////////////////
+unsigned char HAL_Buttons(unsigned char ucWhich)
+{
+    unsigned char ucPressed = 0;
+    
+    if((ucWhich & HAL_BTN_S3) && !S3) ucPressed |= HAL_BTN_S3;
+    if((ucWhich & HAL_BTN_S4) && !S4) ucPressed |= HAL_BTN_S4;
+    if((ucWhich & HAL_BTN_S5) && !S5) ucPressed |= HAL_BTN_S5;
+    
+    return(ucPressed);
+}
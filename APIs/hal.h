@@ -0,0 +1,44 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+//  Filename:       hal.h
+//
+//  Description:    
+//  Hardware abstraction of Terminal Paint. The drivers reach the hardware 
+//  only through the special function registers declared by <xc.h>: the 
+//  XC16 device header on the PIC24FJ128GA010, sim/xc.h on a workstation, 
+//  where the registers are backed by the peripheral models in sim/. So 
+//  i2c1.c, uart2.c and sched.c are the I2C1, UART2 and Timer1 layers of 
+//  both targets, and the same object code paths are tested on the host.
+//  This header adds the board wiring, the Explorer16 push buttons.
+//  S3 and S4 are on change notification inputs, CN15 and CN19; RA7 has
+//  none, so S5 can only be polled.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef _HAL_H
+#define _HAL_H
+
+#include <xc.h>
+
+/////////////////////////////////// MACROS ///////////////////////////////////
+
+// push button pins, read low while pressed
+#define S3          PORTDbits.RD6
+#define S4          PORTDbits.RD13
+#define S5          PORTAbits.RA7
+
+// HAL_Buttons() bits
+#define HAL_BTN_S3  0x01
+#define HAL_BTN_S4  0x02
+#define HAL_BTN_S5  0x04
+#define HAL_BTN_ALL (HAL_BTN_S3 | HAL_BTN_S4 | HAL_BTN_S5)
+
+// buttons whose change raises the CN interrupt once HAL_ButtonsInit() ran
+#define HAL_BTN_CN  (HAL_BTN_S3 | HAL_BTN_S4)
+
+///////////////////////////// FUNCTION PROTOTYPES /////////////////////////////
+
+void HAL_ButtonsInit(void);
+unsigned char HAL_Buttons(unsigned char ucWhich);
+
+#endif  // _HAL_H
@@ -13,11 +13,65 @@
 //  I2C1. It contains functions that perform basic general I2C operations and transactions. 
 //  No device specific code should be added into this generic functions.
 //
+//  Every transaction is timed by Timer4. One that outlives its budget (see
+//  I2C1_STRETCH_US) is aborted, whatever a slave does to the bus, and the
+//  bus is recovered: the module is switched off, SCL is clocked by hand
+//  until a slave holding SDA low lets go, and a STOP is sent. Blocking 
+//  operations stop waiting once the budget is gone and the STOP of the 
+//  transaction recovers the bus instead.
+//
 ///////////////////////////////////////////////////////////////////////////////
 
 #include "i2c1.h"
 #include <xc.h>
 
+// use interrupt no_auto_psv attribute to reduce interrupt overhead
+#define ISR_NO_PSV __attribute__((__interrupt__, no_auto_psv))
+
+// I2C1 pins, driven as open drain port pins during a bus recovery
+#define SCL1_TRIS   TRISGbits.TRISG2
+#define SCL1_LAT    LATGbits.LATG2
+#define SDA1_TRIS   TRISGbits.TRISG3
+#define SDA1_LAT    LATGbits.LATG3
+#define SDA1        PORTGbits.RG3
+
+// states of the interrupt driven transfer engine, each one names the bus
+// event whose completion raises the next MI2C1 interrupt
+#define I2C_ST_IDLE     0
+#define I2C_ST_START    1
+#define I2C_ST_WADDR    2
+#define I2C_ST_WRITE    3
+#define I2C_ST_RESTART  4
+#define I2C_ST_RADDR    5
+#define I2C_ST_READ     6
+#define I2C_ST_ACK      7
+#define I2C_ST_STOP     8
+#define I2C_ST_BLOCK    9       // the blocking operations own the bus
+
+// transfer queue, written by submitI2C1() and drained by the ISR
+static I2C1_XFER* volatile pQueue[I2C1_QUEUE_SIZE];
+static volatile unsigned char ucQHead = 0, ucQTail = 0;
+
+// engine state, only touched by the ISR once a transfer has been started
+static volatile unsigned char ucState = I2C_ST_IDLE;
+static unsigned char ucIdx;
+
+// bus speed, and one SCL period in Timer4 counts
+static unsigned int uiKhz = 0;
+static unsigned int uiBitCounts = 1;
+
+// set by the Timer4 ISR when the transaction in progress ran out of time
+static volatile char cExpired = 0;
+
+// a blocking transaction got a NAK, and how the last one ended
+static char cNak = 0;
+static unsigned char ucLastStatus = I2C_XFER_DONE;
+
+// statistics, the times in Timer4 counts
+static unsigned long ulXfers = 0, ulNaks = 0, ulTimeouts = 0, ulRecoveries = 0;
+static unsigned long ulTimeSum = 0;
+static unsigned int uiTimeMax = 0;
+
 ///////////////////////////////////////////////////////////////////////////////
 //      Name:       I2C1_Initialize
 //
@@ -29,8 +83,12 @@
 ///////////////////////////////////////////////////////////////////////////////
 void I2C1_Initialize(unsigned int uiSpeed_Khz) 
 {   
-    // BRG = Fcy / Fscl - Fcy / 10,000,000 - 1 **Fscl must be converted to Hz**
-    I2C1BRG = FCY/(uiSpeed_Khz*1000L) - FCY/10000000L - 1;
+    // Timer4 times the transactions at Fcy/8, stopped between them
+    T4CON = 0x0010;
+    TMR4 = 0;
+    IPC6bits.T4IP = 5;
+    IFS1bits.T4IF = 0;
+    IEC1bits.T4IE = 1;
     
 	// Initialiaze the I2C1 Peripherial for Master Mode,
 	// 7-bit Slave Address and Slew Rate Control Disabled,
@@ -41,14 +99,226 @@ void I2C1_Initialize(unsigned int uiSpeed_Khz)
     I2C1RCV = 0x0000; 		
 	I2C1TRN = 0x0000; 		
     
-    // Enables the I2Cx module and configures the SDAx and SCLx pins as serial port pins
-    I2C1CONbits.I2CEN = 1;	
+    // recovery drives the pins low through the port, released they float
+    SCL1_LAT = 0;
+    SDA1_LAT = 0;
+    
+    // sets the speed and enables the I2Cx module, the SDAx and SCLx pins
+    // become serial port pins
+    if(!I2C1_SetSpeed(uiSpeed_Khz))
+        I2C1_SetSpeed(100);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//      Name:       I2C1_SetSpeed
+//
+//  Operation:      Change the bus speed, between transactions. Waits for the
+//                  queued transfers to complete first.
+//
+//      Accepts:    - unsigned int uiSpeed_Khz:  desired speed of I2C communication
+//
+//      Returns:    - char:     1 if set, 0 if the speed is out of range and
+//                              the bus was left as it was
+///////////////////////////////////////////////////////////////////////////////
+char I2C1_SetSpeed(unsigned int uiSpeed_Khz) 
+{
+    unsigned long ulBrg;
+    
+    if(uiSpeed_Khz == 0 || uiSpeed_Khz > I2C1_KHZ_MAX)
+        return(0);
+    
+    // BRG = Fcy / Fscl - Fcy / 10,000,000 - 1 **Fscl must be converted to Hz**
+    ulBrg = FCY/(uiSpeed_Khz*1000L) - FCY/10000000L - 1;
+    if(ulBrg < I2C1_BRG_MIN || ulBrg > I2C1_BRG_MAX)
+        return(0);
+    
+    waitI2C1();
+    I2C1CONbits.I2CEN = 0;
+    I2C1BRG = ulBrg;
+    
+    // slew rate control is meant for 400 kHz, disabled at 100 kHz and 1 MHz
+    I2C1CONbits.DISSLW = (uiSpeed_Khz <= 100 || uiSpeed_Khz > 400);
+    I2C1CONbits.I2CEN = 1;
+    
+    uiKhz = uiSpeed_Khz;
+    uiBitCounts = (FCY / 8 / 1000L + uiSpeed_Khz - 1) / uiSpeed_Khz;
+    return(1);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//      Name:       I2C1_Speed
+//
+//  Operation:      Reports the bus speed.
+//
+//      Accepts:    None
+//
+//      Returns:    - unsigned int:     speed in kHz
+///////////////////////////////////////////////////////////////////////////////
+unsigned int I2C1_Speed(void) 
+{
+    return(uiKhz);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//      Name:       armI2C1
+//  
+//  Operation:      Start timing a transaction of <uiBytes> bytes, addresses
+//                  not counted. The Timer4 interrupt marks it expired after
+//                  twice the bus time of its bytes and conditions plus 
+//                  I2C1_STRETCH_US.
+//
+//      Accepts:    - unsigned int uiBytes:     bytes of the transaction
+//
+//      Returns:    None
+///////////////////////////////////////////////////////////////////////////////
+static void armI2C1(unsigned int uiBytes)
+{
+    // 9 clocks per byte and address, START, RESTART, STOP and a spare
+    unsigned long ulCounts = 2UL * (9 * (uiBytes + 2) + 4) * uiBitCounts 
+            + I2C1_US(I2C1_STRETCH_US);
+    
+    T4CONbits.TON = 0;
+    IFS1bits.T4IF = 0;
+    cExpired = 0;
+    cNak = 0;
+    TMR4 = 0;
+    PR4 = (ulCounts > 0xFFFF)? 0xFFFF : ulCounts;
+    T4CONbits.TON = 1;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//      Name:       halfBitI2C1
+//  
+//  Operation:      Wait I2C1_RECOVER_US on Timer4, which runs free during a
+//                  bus recovery.
+//
+//      Accepts:    None
+//
+//      Returns:    None
+///////////////////////////////////////////////////////////////////////////////
+static void halfBitI2C1(void)
+{
+    unsigned int uiStart = TMR4;
+    
+    while((unsigned int)(TMR4 - uiStart) < I2C1_US(I2C1_RECOVER_US));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//      Name:       recoverI2C1
+//  
+//  Operation:      Free the bus after a timeout. With the module off the pins
+//                  are open drain port pins: up to 9 SCL clocks let a slave
+//                  holding SDA low finish the byte it was sending, then a 
+//                  STOP resets every slave. A slave holding SCL low cannot
+//                  be helped from here, the next transaction times out too.
+//
+//      Accepts:    None
+//
+//      Returns:    None
+///////////////////////////////////////////////////////////////////////////////
+static void recoverI2C1(void)
+{
+    unsigned char i;
+    
+    I2C1CONbits.I2CEN = 0;
+    
+    T4CONbits.TON = 0;
+    PR4 = 0xFFFF;
+    T4CONbits.TON = 1;
+    
+    SCL1_TRIS = 1;
+    SDA1_TRIS = 1;
+    halfBitI2C1();
+    if(!SDA1)
+        ulRecoveries++;
+    for(i = 0; i < 9 && !SDA1; i++)
+    {
+        SCL1_TRIS = 0;
+        halfBitI2C1();
+        SCL1_TRIS = 1;
+        halfBitI2C1();
+    }
+    
+    // STOP: SDA rises while SCL is high
+    SCL1_TRIS = 0;
+    SDA1_TRIS = 0;
+    halfBitI2C1();
+    SCL1_TRIS = 1;
+    halfBitI2C1();
+    SDA1_TRIS = 1;
+    halfBitI2C1();
+    
+    T4CONbits.TON = 0;
+    I2C1CONbits.I2CEN = 1;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//      Name:       endI2C1
+//  
+//  Operation:      End the timing of a transaction and count it, recovering
+//                  the bus if it ran out of time.
+//
+//      Accepts:    - unsigned char ucStatus:   I2C_XFER_DONE or I2C_XFER_NAK
+//
+//      Returns:    - unsigned char:    ucStatus, or I2C_XFER_TIMEOUT
+///////////////////////////////////////////////////////////////////////////////
+static unsigned char endI2C1(unsigned char ucStatus)
+{
+    unsigned int uiTime;
+    
+    T4CONbits.TON = 0;
+    uiTime = TMR4;
+    ulXfers++;
+    
+    if(cExpired)
+    {
+        ulTimeouts++;
+        recoverI2C1();
+        return(I2C_XFER_TIMEOUT);
+    }
+    
+    if(ucStatus == I2C_XFER_NAK)
+        ulNaks++;
+    ulTimeSum += uiTime;
+    if(uiTime > uiTimeMax)
+        uiTimeMax = uiTime;
+    return(ucStatus);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//      Name:       kickI2C1
+//  
+//  Operation:      Start the transfer at the tail of the queue by issuing a
+//                  START, and enable the MI2C1 interrupt to drive the rest.
+//                  Called with the queue non-empty and the engine idle.
+//
+//      Accepts:    None
+//
+//      Returns:    None
+///////////////////////////////////////////////////////////////////////////////
+static void kickI2C1(void)
+{
+    I2C1_XFER* pXfer = pQueue[ucQTail & (I2C1_QUEUE_SIZE - 1)];
+    
+    pXfer->ucStatus = I2C_XFER_BUSY;
+    ucState = I2C_ST_START;
+    
+    // the timer is stopped first, so no timeout of the last transfer can
+    // raise MI2C1IF once it is cleared
+    armI2C1(pXfer->ucWriteCnt + pXfer->ucReadCnt);
+    IFS1bits.MI2C1IF = 0;
+    IEC1bits.MI2C1IE = 1;
+    I2C1CONbits.SEN = 1;
 }
 
 ///////////////////////////////////////////////////////////////////////////////
 //      Name:       startI2C1
 //  
-//  Operation:      Perform an I2C start operation.
+//  Operation:      Perform an I2C start operation. Waits for the queued 
+//                  transfers to finish first, then keeps the queue from
+//                  starting another one until stopI2C1(): the transfers an
+//                  ISR submits meanwhile wait in the queue, and the engine
+//                  leaves Timer4 and its flags to this transaction.
 //
 //      Accepts:    None
 //
@@ -56,17 +326,38 @@ void I2C1_Initialize(unsigned int uiSpeed_Khz)
 ///////////////////////////////////////////////////////////////////////////////
 void startI2C1(void) 
 {
+    int iIpl;
+    char cOwned = 0;
+    
+    while(!cOwned)
+    {
+        waitI2C1();
+        SET_AND_SAVE_CPU_IPL(iIpl, 7);
+        if(ucState == I2C_ST_IDLE)
+        {
+            ucState = I2C_ST_BLOCK;
+            cOwned = 1;
+        }
+        RESTORE_CPU_IPL(iIpl);
+    }
+    
+    // the transaction starts, its time with it
+    armI2C1(I2C1_BLOCK_BYTES);
+    
     // initiate start on I2C
     I2C1CONbits.SEN = 1; 
     
     // wait until start finished
-    while (I2C1CONbits.SEN);
+    while (I2C1CONbits.SEN && !cExpired);
 }
 
 ///////////////////////////////////////////////////////////////////////////////
 //      Name:       stopI2C1
 //  
-//  Operation:      Perform an I2C stop operation.
+//  Operation:      Perform an I2C stop operation, which ends the transaction,
+//                  or recover the bus if it ran out of time. Then hands the
+//                  bus back to the queue, starting a transfer submitted
+//                  during the transaction.
 //
 //      Accepts:    None
 //
@@ -74,18 +365,65 @@ void startI2C1(void)
 ///////////////////////////////////////////////////////////////////////////////
 void stopI2C1(void) 
 {
-    // initiate stop condition on I2C
-    I2C1CONbits.PEN=1;   
+    int iIpl;
+    
+    if(!cExpired)
+    {
+        // initiate stop condition on I2C
+        I2C1CONbits.PEN=1;   
+    
+        // wait until stop finished
+        while (I2C1CONbits.PEN && !cExpired);  
+    }
+    
+    ucLastStatus = endI2C1(cNak? I2C_XFER_NAK : I2C_XFER_DONE);
+    
+    SET_AND_SAVE_CPU_IPL(iIpl, 7);
+    ucState = I2C_ST_IDLE;
+    if(ucQHead != ucQTail)
+        kickI2C1();
+    RESTORE_CPU_IPL(iIpl);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//      Name:       statusI2C1
+//  
+//  Operation:      Tell how the last blocking transaction ended.
+//
+//      Accepts:    None
+//
+//      Returns:    - unsigned char:    I2C_XFER_DONE, I2C_XFER_NAK or 
+//                                      I2C_XFER_TIMEOUT
+///////////////////////////////////////////////////////////////////////////////
+unsigned char statusI2C1(void)
+{
+    return(ucLastStatus);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//      Name:       restartI2C1
+//  
+//  Operation:      Perform an I2C repeated start operation, turning the bus
+//                  around without releasing it between a write and a read.
+//
+//      Accepts:    None
+//
+//      Returns:    None
+///////////////////////////////////////////////////////////////////////////////
+void restartI2C1(void) 
+{
+    // initiate repeated start on I2C
+    I2C1CONbits.RSEN = 1; 
     
-    // wait until stop finished
-    while (I2C1CONbits.PEN);  
+    // wait until repeated start finished
+    while (I2C1CONbits.RSEN && !cExpired);
 }
 
 ///////////////////////////////////////////////////////////////////////////////
 //      Name:       putI2C1
 //  
-//  Operation:      Send one byte <cSendByte>, if NAK is returned use outString() 
-//                  function to display the error via UART interface.
+//  Operation:      Send one byte <cSendByte>. A NAK is recorded for the
+//                  transaction, stopI2C1() counts it in statsI2C1().
 //
 //      Accepts:    - char cSendByte:    The byte to be sent
 //
@@ -93,15 +431,19 @@ void stopI2C1(void)
 ///////////////////////////////////////////////////////////////////////////////
 void putI2C1(char cSendByte) 
 {
+    // nothing more goes out once the transaction is out of time
+    if (cExpired)
+        return;
+    
     I2C1TRN = cSendByte; 
   
     // wait for 8bits+ack bit from slave to finish
-    while (I2C1STATbits.TRSTAT);
+    while (I2C1STATbits.TRSTAT && !cExpired);
     
-    if (I2C1STATbits.ACKSTAT != I2C_ACK) 
+    if (!cExpired && I2C1STATbits.ACKSTAT != I2C_ACK) 
     {
         //NAK returned
-        outString("*** I2C1PUT, NAK returned ***");
+        cNak = 1;
     }
 }
 
@@ -121,21 +463,25 @@ char getI2C1(char cAck2Send)
     char cRcvByte;
 
     //wait for idle condition, lower 5 bits must be 0
-    while (I2C1CON & 0x1F);   
+    while ((I2C1CON & 0x1F) && !cExpired);   
+    
+    // a transaction out of time reads 0xFF, a released SDA
+    if (cExpired)
+        return((char)0xFF);
     
     // enable receiving
     I2C1CONbits.RCEN = 1;    
-	while (!I2C1STATbits.RBF);		//wait for receive to complete     
+	while (!I2C1STATbits.RBF && !cExpired);		//wait for receive to complete     
 
 	//read byte;
     cRcvByte = I2C1RCV;           
     
     //wait for idle condition before attempting ACK
-    while (I2C1CON & 0x1F);         
+    while ((I2C1CON & 0x1F) && !cExpired);         
     
     I2C1CONbits.ACKDT = cAck2Send; 
     I2C1CONbits.ACKEN = 1;          //enable ACKbit transmittion
-    while (I2C1CONbits.ACKEN);      //wait for completion
+    while (I2C1CONbits.ACKEN && !cExpired);      //wait for completion
     
     return(cRcvByte);                  
 }
@@ -230,4 +576,298 @@ void readNI2C1(char cAddr, char* pcArrayData, int iCnt)
     
     *(pcArrayData + i) = getI2C1(I2C_NAK);
     stopI2C1();
-}
\ No newline at end of file
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//      Name:       readRegNI2C1
+//  
+//  Transaction:    Read <iCnt> number of consecutive registers starting at 
+//                  <cReg> from I2C slave at address <cAddr> in one transaction:
+//                  the register pointer is written, then a repeated start 
+//                  turns the bus around for the read, so no STOP/START pair
+//                  or second transaction is needed. The slave must auto 
+//                  increment its register pointer.
+//
+//      Accepts:    - char cAddr:           address of slave
+//                  - char cReg:            first register to read
+//                  - char* pcArrayData:    buffer to store received bytes
+//                  - int iCnt:             number of bytes
+//
+//      Returns:    None
+///////////////////////////////////////////////////////////////////////////////
+void readRegNI2C1(char cAddr, char cReg, char* pcArrayData, int iCnt) 
+{
+    int i;
+    startI2C1();
+    putI2C1(I2C_WADDR(cAddr));
+    putI2C1(cReg);
+    
+    restartI2C1();
+    putI2C1(I2C_RADDR(cAddr));
+    
+    for(i = 0; i < iCnt - 1; i++) *(pcArrayData + i) = getI2C1(I2C_ACK);
+    
+    *(pcArrayData + i) = getI2C1(I2C_NAK);
+    stopI2C1();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//      Name:       submitI2C1
+//  
+//  Transaction:    Queue the transfer described by <pXfer> and return at once.
+//                  If the bus is idle the transfer is started immediately,
+//                  otherwise it runs after the transfers queued before it.
+//                  May be called from main, from any ISR (INT0, INT1) and
+//                  from a completion callback: the CPU priority is raised
+//                  to 7 while the queue is updated and the bus started, so
+//                  no other submitter or ISR can come in between.
+//
+//      Accepts:    - I2C1_XFER* pXfer:     transfer descriptor
+//
+//      Returns:    - char:     1 if queued, 0 if the queue was full
+///////////////////////////////////////////////////////////////////////////////
+char submitI2C1(I2C1_XFER* pXfer) 
+{
+    int iIpl;
+    char cQueued = 0;
+    
+    // every interrupt held off while the slot is taken and the bus started
+    SET_AND_SAVE_CPU_IPL(iIpl, 7);
+    
+    // head and tail run freely, their difference is the queue depth
+    if((unsigned char)(ucQHead - ucQTail) < I2C1_QUEUE_SIZE)
+    {
+        pXfer->ucStatus = I2C_XFER_QUEUED;
+        pQueue[ucQHead & (I2C1_QUEUE_SIZE - 1)] = pXfer;
+        ucQHead++;
+        
+        if(ucState == I2C_ST_IDLE)
+            kickI2C1();
+        cQueued = 1;
+    }
+    
+    RESTORE_CPU_IPL(iIpl);
+    return(cQueued);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//      Name:       busyI2C1
+//  
+//  Operation:      Reports whether queued transfers are still pending.
+//
+//      Accepts:    None
+//
+//      Returns:    - char:     1 while the engine owns the bus, 0 when idle
+///////////////////////////////////////////////////////////////////////////////
+char busyI2C1(void) 
+{
+    return(ucState != I2C_ST_IDLE);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//      Name:       waitI2C1
+//  
+//  Operation:      Wait until every queued transfer has completed. The
+//                  blocking operations do so in startI2C1(); not to be 
+//                  called inside a blocking transaction.
+//                  Bounded, as every transfer ends by its timeout at last.
+//
+//      Accepts:    None
+//
+//      Returns:    None
+///////////////////////////////////////////////////////////////////////////////
+void waitI2C1(void) 
+{
+    // the ISR does the work, Nop() keeps the loop from being a pure RAM spin
+    // so the host simulation (sim/xc.h) can advance while waiting
+    while(ucState != I2C_ST_IDLE) Nop();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//      Name:       statsI2C1
+//  
+//  Operation:      Reports the transaction statistics.
+//
+//      Accepts:    - I2C1_STATS* pStats:   returns the statistics
+//
+//      Returns:    None
+///////////////////////////////////////////////////////////////////////////////
+void statsI2C1(I2C1_STATS* pStats) 
+{
+    char cIE = IEC1bits.MI2C1IE;
+    unsigned long ulTimed;
+    
+    // a consistent set, the ISR counts too
+    IEC1bits.MI2C1IE = 0;
+    pStats->ulXfers = ulXfers;
+    pStats->ulNaks = ulNaks;
+    pStats->ulTimeouts = ulTimeouts;
+    pStats->ulRecoveries = ulRecoveries;
+    ulTimed = ulXfers - ulTimeouts;
+    pStats->ulMeanUs = ulTimed? ulTimeSum / ulTimed / I2C1_US(1) : 0;
+    pStats->ulMaxUs = uiTimeMax / I2C1_US(1);
+    IEC1bits.MI2C1IE = cIE;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//      Name:       finishI2C1
+//  
+//  Operation:      Complete the transfer on the bus, run its callback and
+//                  start the next one. Called from the ISR.
+//
+//      Accepts:    - I2C1_XFER* pXfer:     transfer descriptor
+//
+//      Returns:    None
+///////////////////////////////////////////////////////////////////////////////
+static void finishI2C1(I2C1_XFER* pXfer)
+{
+    pXfer->ucStatus = endI2C1((pXfer->ucStatus == I2C_XFER_BUSY)? 
+            I2C_XFER_DONE : pXfer->ucStatus);
+    ucQTail++;
+    
+    // callback may queue a follow-up transfer, engine is not idle yet
+    if(pXfer->pfDone)
+        pXfer->pfDone(pXfer);
+    
+    if(ucQHead != ucQTail)
+        kickI2C1();
+    else
+    {
+        ucState = I2C_ST_IDLE;
+        IEC1bits.MI2C1IE = 0;
+        IFS1bits.MI2C1IF = 0;
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           T4Interrupt
+//  Description:    ISR for the Timer4 period match, the transaction in 
+//                  progress is out of time. The queued one is aborted in the
+//                  MI2C1 ISR, where the engine state may change; the 
+//                  blocking operations see the flag.
+///////////////////////////////////////////////////////////////////////////////
+void ISR_NO_PSV _T4Interrupt(void)
+{
+    IFS1bits.T4IF = 0;
+    T4CONbits.TON = 0;
+    cExpired = 1;
+    
+    if(ucState != I2C_ST_IDLE && ucState != I2C_ST_BLOCK)
+        IFS1bits.MI2C1IF = 1;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           MI2C1Interrupt
+//  Description:    ISR for the I2C1 master events. Each START, RESTART, STOP,
+//                  ACK sequence and byte transmitted or received raises this
+//                  interrupt, which issues the next bus event of the current
+//                  transfer, then completes it and starts the next one.
+//                  A transfer out of time is ended here with the bus 
+//                  recovered, whatever it was waiting for.
+///////////////////////////////////////////////////////////////////////////////
+void ISR_NO_PSV _MI2C1Interrupt(void)
+{
+    I2C1_XFER* pXfer = pQueue[ucQTail & (I2C1_QUEUE_SIZE - 1)];
+    
+    IFS1bits.MI2C1IF = 0;
+    
+    if(cExpired && ucState != I2C_ST_IDLE)
+    {
+        finishI2C1(pXfer);
+        return;
+    }
+    
+    switch(ucState)
+    {
+        case I2C_ST_START:
+            ucIdx = 0;
+            
+            // an empty transfer is sent as a write to probe the address
+            if(pXfer->ucWriteCnt > 0 || pXfer->ucReadCnt == 0)
+            {
+                ucState = I2C_ST_WADDR;
+                I2C1TRN = I2C_WADDR(pXfer->cAddr);
+            }
+            else
+            {
+                ucState = I2C_ST_RADDR;
+                I2C1TRN = I2C_RADDR(pXfer->cAddr);
+            }
+            break;
+            
+        case I2C_ST_WADDR:
+        case I2C_ST_WRITE:
+            if(I2C1STATbits.ACKSTAT != I2C_ACK)
+            {
+                pXfer->ucStatus = I2C_XFER_NAK;
+                ucState = I2C_ST_STOP;
+                I2C1CONbits.PEN = 1;
+            }
+            else if(ucIdx < pXfer->ucWriteCnt)
+            {
+                ucState = I2C_ST_WRITE;
+                I2C1TRN = pXfer->pcWrite[ucIdx++];
+            }
+            else if(pXfer->ucReadCnt > 0)
+            {
+                ucState = I2C_ST_RESTART;
+                I2C1CONbits.RSEN = 1;
+            }
+            else
+            {
+                ucState = I2C_ST_STOP;
+                I2C1CONbits.PEN = 1;
+            }
+            break;
+            
+        case I2C_ST_RESTART:
+            ucIdx = 0;
+            ucState = I2C_ST_RADDR;
+            I2C1TRN = I2C_RADDR(pXfer->cAddr);
+            break;
+            
+        case I2C_ST_RADDR:
+            if(I2C1STATbits.ACKSTAT != I2C_ACK)
+            {
+                pXfer->ucStatus = I2C_XFER_NAK;
+                ucState = I2C_ST_STOP;
+                I2C1CONbits.PEN = 1;
+            }
+            else
+            {
+                ucState = I2C_ST_READ;
+                I2C1CONbits.RCEN = 1;
+            }
+            break;
+            
+        case I2C_ST_READ:
+            pXfer->pcRead[ucIdx++] = I2C1RCV;
+            
+            // NAK the last byte, ACK all others
+            I2C1CONbits.ACKDT = (ucIdx < pXfer->ucReadCnt)? I2C_ACK : I2C_NAK;
+            ucState = I2C_ST_ACK;
+            I2C1CONbits.ACKEN = 1;
+            break;
+            
+        case I2C_ST_ACK:
+            if(ucIdx < pXfer->ucReadCnt)
+            {
+                ucState = I2C_ST_READ;
+                I2C1CONbits.RCEN = 1;
+            }
+            else
+            {
+                ucState = I2C_ST_STOP;
+                I2C1CONbits.PEN = 1;
+            }
+            break;
+            
+        case I2C_ST_STOP:
+            finishI2C1(pXfer);
+            break;
+            
+        default:
+            IEC1bits.MI2C1IE = 0;
+            break;
+    }
+}
@@ -24,18 +24,89 @@
 #define I2C_WADDR(x) (x & 0xFE) //clear R/W bit of I2C addr
 #define I2C_RADDR(x) (x | 0x01) //set R/W bit of I2C addr
 
+// bus speed limits: I2C1BRG is 9 bits and must be at least 2, and 1000 kHz
+// is Fast-mode Plus, which every slave on the bus has to support
+#define I2C1_BRG_MIN    2
+#define I2C1_BRG_MAX    0x1FF
+#define I2C1_KHZ_MAX    1000
+
+// Timer4 times every transaction at Fcy/8, converts microseconds to counts
+#define I2C1_US(us)     ((unsigned int)((us) * (FCY / 8 / 1000000L)))
+
+// a transaction times out after twice its length at the bus speed plus
+// this allowance for clock stretching by the slave
+#define I2C1_STRETCH_US 1000
+
+// bytes budgeted for a transaction made of the blocking operations, whose
+// length is not known when it starts
+#define I2C1_BLOCK_BYTES 16
+
+// half SCL period of the bus recovery clocks, 100 kHz for any slave
+#define I2C1_RECOVER_US 5
+
 // I2C Operations
 void I2C1_Initialize(unsigned int uiSpeed_Khz);
+char I2C1_SetSpeed(unsigned int uiSpeed_Khz);
+unsigned int I2C1_Speed(void);
 void startI2C1(void);
 void stopI2C1(void);
+void restartI2C1(void);
 void putI2C1(char cSendByte);
 char getI2C1(char cAck2Send);
+unsigned char statusI2C1(void);
 
 // I2C Transactions
 void write1I2C1(char cAddr, char cSendByte);
 void writeNI2C1(char cAddr, char* pcArraydata, int iCnt); 
 void read1I2C1(char cAddr, char* pcRcvByte);
 void readNI2C1(char cAddr, char* pcArrayData, int iCnt);
+void readRegNI2C1(char cAddr, char cReg, char* pcArrayData, int iCnt);
+
+// number of queued transfer descriptors, must be a power of two
+#define I2C1_QUEUE_SIZE 8
+
+// status of a queued transfer descriptor
+#define I2C_XFER_QUEUED 0   // waiting in the queue
+#define I2C_XFER_BUSY   1   // currently on the bus
+#define I2C_XFER_DONE   2   // completed, all bytes acknowledged
+#define I2C_XFER_NAK    3   // aborted, slave returned a NAK
+#define I2C_XFER_TIMEOUT 4  // aborted after its time, the bus was recovered
+
+// Queued transfer descriptor: START, address + write bytes, then (if
+// ucReadCnt > 0) RESTART, address + read bytes, STOP. A descriptor with no
+// write bytes skips straight to the read phase. The descriptor and its
+// buffers must stay valid until ucStatus leaves I2C_XFER_QUEUED/BUSY.
+typedef struct I2C1_XFER I2C1_XFER;
+typedef void (*I2C1_CALLBACK)(I2C1_XFER* pXfer);
+
+struct I2C1_XFER
+{
+    char cAddr;                     // slave address, R/W bit set by engine
+    const char* pcWrite;            // bytes sent after the write address
+    unsigned char ucWriteCnt;       // number of bytes in pcWrite
+    char* pcRead;                   // buffer for bytes read from the slave
+    unsigned char ucReadCnt;        // number of bytes to read into pcRead
+    I2C1_CALLBACK pfDone;           // called from the ISR when done, or NULL
+    void* pvUser;                   // free for use by the submitter
+    volatile unsigned char ucStatus;// one of I2C_XFER_xxx
+};
+
+// transaction statistics since I2C1_Initialize(), blocking and queued ones
+typedef struct
+{
+    unsigned long ulXfers;          // transactions ended
+    unsigned long ulNaks;           // of which a slave did not acknowledge
+    unsigned long ulTimeouts;       // of which ran out of time
+    unsigned long ulRecoveries;     // times SDA was found held low and freed
+    unsigned long ulMeanUs;         // mean time of the others, START to STOP
+    unsigned long ulMaxUs;          // longest of the others
+} I2C1_STATS;
+
+// I2C Interrupt Driven Transactions
+char submitI2C1(I2C1_XFER* pXfer);
+char busyI2C1(void);
+void waitI2C1(void);
+void statsI2C1(I2C1_STATS* pStats);
 
 #endif //_I2C1_H
 
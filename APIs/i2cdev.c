@@ -0,0 +1,285 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+//  Filename:       i2cdev.c
+//
+//  Description:
+//  Register access of I2C1 slave devices through a device handle, see
+//  i2cdev.h. Built on the blocking operations of i2c1.c: a write is one
+//  START, address, register address, data and STOP; a read turns the bus
+//  around with a repeated start. startI2C1() waits for the queued
+//  transfers and holds the queue off until the STOP, so the handles may be
+//  used while other devices on I2C1 run queued transfers. The shadow cache is write-through, an
+//  entry is only kept once the slave has acknowledged the write, and any
+//  failed transaction drops the entries it touched.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "i2cdev.h"
+#include "i2c1.h"
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           slot
+//  Description:    Index of a register in the cache window, -1 outside it
+///////////////////////////////////////////////////////////////////////////////
+static int slot(I2CDEV* pDev, unsigned int uiReg)
+{
+    if(uiReg < pDev->uiCacheBase || uiReg - pDev->uiCacheBase >= pDev->ucCacheCnt)
+        return(-1);
+    return(uiReg - pDev->uiCacheBase);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           shadow
+//  Description:    Keeps or drops the shadow of a register, if it is cached
+///////////////////////////////////////////////////////////////////////////////
+static void shadow(I2CDEV* pDev, unsigned int uiReg, unsigned char ucValue, char cKeep)
+{
+    int i = slot(pDev, uiReg);
+
+    if(i < 0)
+        return;
+    if(cKeep)
+    {
+        pDev->pucCache[i] = ucValue;
+        pDev->pucValid[i >> 3] |= 1 << (i & 7);
+    }
+    else
+        pDev->pucValid[i >> 3] &= ~(1 << (i & 7));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           holds
+//  Description:    Tells whether the shadow knows a register holds <ucValue>
+///////////////////////////////////////////////////////////////////////////////
+static char holds(I2CDEV* pDev, unsigned int uiReg, unsigned char ucValue)
+{
+    unsigned char ucCached;
+
+    return(I2CDEV_Cached(pDev, uiReg, &ucCached) && ucCached == ucValue);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           regAddr
+//  Description:    Puts the register address, MSB first, in <pcBuff>
+//      Returns:    bytes written
+///////////////////////////////////////////////////////////////////////////////
+static unsigned int regAddr(I2CDEV* pDev, unsigned int uiReg, char* pcBuff)
+{
+    if(pDev->ucRegWidth == 2)
+    {
+        pcBuff[0] = uiReg >> 8;
+        pcBuff[1] = uiReg & 0xFF;
+        return(2);
+    }
+    pcBuff[0] = uiReg & 0xFF;
+    return(1);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           send
+//  Description:    Writes <ucCnt> bytes from <uiReg> in one transaction and
+//                  keeps them in the shadow if <cShadow> and acknowledged
+//      Returns:    1 if acknowledged
+///////////////////////////////////////////////////////////////////////////////
+static char send(I2CDEV* pDev, unsigned int uiReg, const unsigned char* pucData,
+                 unsigned char ucCnt, char cShadow)
+{
+    char data_w[2 + I2CDEV_RUN_MAX];
+    unsigned int i, n = regAddr(pDev, uiReg, data_w);
+    char cOk;
+
+    for(i = 0; i < ucCnt; i++)
+        data_w[n + i] = pucData[i];
+
+    writeNI2C1(pDev->cAddr, data_w, n + ucCnt);
+    pDev->ulWrites++;
+    cOk = (statusI2C1() == I2C_XFER_DONE);
+
+    for(i = 0; i < ucCnt; i++)
+        shadow(pDev, uiReg + i, pucData[i], cOk && cShadow);
+    return(cOk);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           I2CDEV_Invalidate
+//  Description:    Forgets the whole shadow, e.g. after the device was reset
+//      Accepts:    - I2CDEV* pDev:     device
+//      Returns:    None
+///////////////////////////////////////////////////////////////////////////////
+void I2CDEV_Invalidate(I2CDEV* pDev)
+{
+    unsigned int i;
+
+    for(i = 0; i < I2CDEV_VALID_BYTES(pDev->ucCacheCnt); i++)
+        pDev->pucValid[i] = 0;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           I2CDEV_Write
+//  Description:    Writes a configuration register, nothing is sent when
+//                  the shadow knows it holds the value already
+//      Accepts:    - I2CDEV* pDev:             device
+//                  - unsigned int uiReg:       register
+//                  - unsigned char ucValue:    value
+//      Returns:    - char:     1 if the register holds the value, 0 if the
+//                              write was not acknowledged
+///////////////////////////////////////////////////////////////////////////////
+char I2CDEV_Write(I2CDEV* pDev, unsigned int uiReg, unsigned char ucValue)
+{
+    return(I2CDEV_WriteN(pDev, uiReg, &ucValue, 1));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           I2CDEV_WriteN
+//  Description:    Writes consecutive configuration registers. The ones at
+//                  either end the shadow knows to hold their value are left
+//                  out, the rest go in one auto-increment transaction, or
+//                  one per register on a device without auto-increment.
+//      Accepts:    - I2CDEV* pDev:                 device
+//                  - unsigned int uiReg:           first register
+//                  - const unsigned char* pucData: values
+//                  - unsigned char ucCnt:          count, at most
+//                                                  I2CDEV_RUN_MAX
+//      Returns:    - char:     1 if all registers hold their values, 0 if a
+//                              write was not acknowledged
+///////////////////////////////////////////////////////////////////////////////
+char I2CDEV_WriteN(I2CDEV* pDev, unsigned int uiReg, const unsigned char* pucData, unsigned char ucCnt)
+{
+    char cOk = 1;
+    unsigned char i;
+
+    while(ucCnt && holds(pDev, uiReg, pucData[0]))
+    {
+        uiReg++;
+        pucData++;
+        ucCnt--;
+        pDev->ulSkipped++;
+    }
+    while(ucCnt && holds(pDev, uiReg + ucCnt - 1, pucData[ucCnt - 1]))
+    {
+        ucCnt--;
+        pDev->ulSkipped++;
+    }
+    if(ucCnt == 0)
+        return(1);
+
+    if(pDev->ucAutoInc)
+        return(send(pDev, uiReg, pucData, ucCnt, 1));
+
+    for(i = 0; i < ucCnt; i++)
+        if(!send(pDev, uiReg + i, pucData + i, 1, 1))
+            cOk = 0;
+    return(cOk);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           I2CDEV_Send
+//  Description:    Writes a command register, always sent and not kept in
+//                  the shadow
+//      Accepts:    - I2CDEV* pDev:             device
+//                  - unsigned int uiReg:       register
+//                  - unsigned char ucValue:    value
+//      Returns:    - char:     1 if acknowledged
+///////////////////////////////////////////////////////////////////////////////
+char I2CDEV_Send(I2CDEV* pDev, unsigned int uiReg, unsigned char ucValue)
+{
+    return(send(pDev, uiReg, &ucValue, 1, 0));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           I2CDEV_Update
+//  Description:    Read-modify-write of a configuration register: the bits
+//                  in <ucMask> take those of <ucBits>. The old value comes
+//                  from the shadow when it has it, so a cached register
+//                  costs no read, and an unchanged one no write.
+//      Accepts:    - I2CDEV* pDev:             device
+//                  - unsigned int uiReg:       register
+//                  - unsigned char ucMask:     bits to change
+//                  - unsigned char ucBits:     their new values
+//      Returns:    - char:     1 if the register holds the new value
+///////////////////////////////////////////////////////////////////////////////
+char I2CDEV_Update(I2CDEV* pDev, unsigned int uiReg, unsigned char ucMask, unsigned char ucBits)
+{
+    unsigned char ucValue;
+
+    if(!I2CDEV_Cached(pDev, uiReg, &ucValue) && !I2CDEV_ReadN(pDev, uiReg, &ucValue, 1))
+        return(0);
+    return(I2CDEV_Write(pDev, uiReg, (ucValue & ~ucMask) | (ucBits & ucMask)));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           I2CDEV_Read
+//  Description:    Reads a register from the device
+//      Accepts:    - I2CDEV* pDev:             device
+//                  - unsigned int uiReg:       register
+//      Returns:    - unsigned char:            value, 0xFF if the read failed
+///////////////////////////////////////////////////////////////////////////////
+unsigned char I2CDEV_Read(I2CDEV* pDev, unsigned int uiReg)
+{
+    unsigned char ucValue;
+
+    if(!I2CDEV_ReadN(pDev, uiReg, &ucValue, 1))
+        return(0xFF);
+    return(ucValue);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           I2CDEV_ReadN
+//  Description:    Reads consecutive registers from the device, in one
+//                  transaction when it auto-increments, and refreshes the
+//                  shadow of those in the cache window
+//      Accepts:    - I2CDEV* pDev:             device
+//                  - unsigned int uiReg:       first register
+//                  - unsigned char* pucData:   buffer for the values
+//                  - unsigned char ucCnt:      count
+//      Returns:    - char:     1 if read, 0 if the transaction failed
+///////////////////////////////////////////////////////////////////////////////
+char I2CDEV_ReadN(I2CDEV* pDev, unsigned int uiReg, unsigned char* pucData, unsigned char ucCnt)
+{
+    char data_w[2];
+    unsigned int i, n;
+    char cOk;
+
+    if(!pDev->ucAutoInc && ucCnt > 1)
+    {
+        for(i = 0; i < ucCnt; i++)
+            if(!I2CDEV_ReadN(pDev, uiReg + i, pucData + i, 1))
+                return(0);
+        return(1);
+    }
+
+    n = regAddr(pDev, uiReg, data_w);
+    startI2C1();
+    putI2C1(I2C_WADDR(pDev->cAddr));
+    for(i = 0; i < n; i++)
+        putI2C1(data_w[i]);
+
+    restartI2C1();
+    putI2C1(I2C_RADDR(pDev->cAddr));
+    for(i = 0; i < ucCnt; i++)
+        pucData[i] = getI2C1((i == ucCnt - 1u)? I2C_NAK : I2C_ACK);
+    stopI2C1();
+
+    cOk = (statusI2C1() == I2C_XFER_DONE);
+    for(i = 0; i < ucCnt; i++)
+        shadow(pDev, uiReg + i, pucData[i], cOk);
+    return(cOk);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           I2CDEV_Cached
+//  Description:    Looks a register up in the shadow, without bus traffic
+//      Accepts:    - I2CDEV* pDev:             device
+//                  - unsigned int uiReg:       register
+//                  - unsigned char* pucValue:  returns the value if known
+//      Returns:    - char:     1 if the shadow knows the value
+///////////////////////////////////////////////////////////////////////////////
+char I2CDEV_Cached(I2CDEV* pDev, unsigned int uiReg, unsigned char* pucValue)
+{
+    int i = slot(pDev, uiReg);
+
+    if(i < 0 || !(pDev->pucValid[i >> 3] & (1 << (i & 7))))
+        return(0);
+    *pucValue = pDev->pucCache[i];
+    return(1);
+}
@@ -0,0 +1,60 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+//  Filename:       i2cdev.h
+//
+//  Description:    Header file for the i2cdev.c register access of I2C1
+//                  slave devices
+//
+//  A device handle holds the slave address, the width of its register
+//  addresses and whether it auto-increments them, so one driver serves the
+//  XZ sensor (8-bit registers) and the VL6180 (16-bit registers) on the
+//  same bus. Writable configuration registers in the cache window are
+//  shadowed: a write of the value a register already holds is skipped, and
+//  a read-modify-write takes the old value from the shadow. Command
+//  registers, whose writes start something or clear themselves, go through
+//  I2CDEV_Send() and are never shadowed.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef _I2CDEV_H
+#define _I2CDEV_H
+
+/////////////////////////////////// MACROS ///////////////////////////////////
+
+// longest run I2CDEV_WriteN() sends in one transaction
+#define I2CDEV_RUN_MAX      8
+
+// bytes of valid bits for a cache window of <n> registers
+#define I2CDEV_VALID_BYTES(n)   (((n) + 7) / 8)
+
+/////////////////////////////////// TYPES ////////////////////////////////////
+
+typedef struct
+{
+    char cAddr;                     // slave address, R/W bit clear
+    unsigned char ucRegWidth;       // register address bytes, 1 or 2
+    unsigned char ucAutoInc;        // 1 if a transaction may span registers
+
+    // shadow cache of the registers from uiCacheBase on
+    unsigned int uiCacheBase;
+    unsigned char ucCacheCnt;       // registers in the window, may be 0
+    unsigned char* pucCache;        // ucCacheCnt shadow values
+    unsigned char* pucValid;        // I2CDEV_VALID_BYTES(ucCacheCnt) bits
+
+    // traffic counters
+    unsigned long ulWrites;         // write transactions sent
+    unsigned long ulSkipped;        // register writes the shadow made useless
+} I2CDEV;
+
+///////////////////////////// FUNCTION PROTOTYPES /////////////////////////////
+
+void I2CDEV_Invalidate(I2CDEV* pDev);
+char I2CDEV_Write(I2CDEV* pDev, unsigned int uiReg, unsigned char ucValue);
+char I2CDEV_WriteN(I2CDEV* pDev, unsigned int uiReg, const unsigned char* pucData, unsigned char ucCnt);
+char I2CDEV_Send(I2CDEV* pDev, unsigned int uiReg, unsigned char ucValue);
+char I2CDEV_Update(I2CDEV* pDev, unsigned int uiReg, unsigned char ucMask, unsigned char ucBits);
+unsigned char I2CDEV_Read(I2CDEV* pDev, unsigned int uiReg);
+char I2CDEV_ReadN(I2CDEV* pDev, unsigned int uiReg, unsigned char* pucData, unsigned char ucCnt);
+char I2CDEV_Cached(I2CDEV* pDev, unsigned int uiReg, unsigned char* pucValue);
+
+#endif  // _I2CDEV_H
@@ -0,0 +1,138 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+//  Filename:       motion.c
+//
+//  Description:    
+//  Cursor velocity model. The displacement of a sensor coordinate from 
+//  MIDPOINT beyond DEADZONE is turned into a velocity in Q8.8 cells per 
+//  MOTION_PERIOD_MS through an acceleration curve: slow near the deadzone for
+//  fine control, up to MOTION_VMAX at full reach. Each axis accumulates 
+//  the velocity and the cursor moves by the whole cells accumulated, the
+//  fraction is carried to the next update.
+//
+//  The curve is set at compile time with MOTION_GAIN, MOTION_ACCEL and 
+//  MOTION_VMAX, or at run time with MOTION_SetCurve(). A gain of one cell
+//  with no acceleration and a one cell limit gives the original one cell 
+//  per update motion.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "motion.h"
+
+static MOTION_CURVE sCurve = { MOTION_GAIN, MOTION_ACCEL, MOTION_VMAX };
+
+// cursor update period over MOTION_PERIOD_MS, Q4.12 so that short periods
+// keep their precision
+#define SCALE_SHIFT     12
+#define SCALE_ONE       (1U << SCALE_SHIFT)
+
+static unsigned int u16_scale = SCALE_ONE;
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           MOTION_SetCurve / MOTION_GetCurve
+//  Description:    Sets or reads the acceleration curve, the limit is held
+//                  to MOTION_VLIMIT
+//      Accepts:    - MOTION_CURVE* pCurve:     curve to set or to fill
+//      Returns:    None
+///////////////////////////////////////////////////////////////////////////////
+void MOTION_SetCurve(const MOTION_CURVE* pCurve)
+{
+    sCurve = *pCurve;
+    if(sCurve.u16_vmax > MOTION_VLIMIT)
+        sCurve.u16_vmax = MOTION_VLIMIT;
+}
+
+void MOTION_GetCurve(MOTION_CURVE* pCurve)
+{
+    *pCurve = sCurve;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           MOTION_SetPeriod
+//  Description:    Sets the cursor update period, each update moves by the
+//                  share of the velocity its period is of MOTION_PERIOD_MS
+//      Accepts:    - unsigned int u16_ms:  update period, 1 to 
+//                                          MOTION_PERIOD_MS
+//      Returns:    None
+///////////////////////////////////////////////////////////////////////////////
+void MOTION_SetPeriod(unsigned int u16_ms)
+{
+    if(u16_ms > MOTION_PERIOD_MS)
+        u16_ms = MOTION_PERIOD_MS;
+    u16_scale = (unsigned int)(((unsigned long)u16_ms * SCALE_ONE 
+                + MOTION_PERIOD_MS / 2) / MOTION_PERIOD_MS);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           MOTION_Velocity
+//  Description:    Evaluates the acceleration curve
+//      Accepts:    - unsigned char u8_d:   counts past the deadzone edge, 
+//                                          0 inside the deadzone
+//      Returns:    - unsigned int:         Q8.8 cells per MOTION_PERIOD_MS
+///////////////////////////////////////////////////////////////////////////////
+unsigned int MOTION_Velocity(unsigned char u8_d)
+{
+    unsigned long u32_v;
+    
+    u32_v = (unsigned long)sCurve.u16_gain * u8_d
+            + (((unsigned long)sCurve.u16_accel * u8_d * u8_d) >> 8);
+    
+    return((u32_v > sCurve.u16_vmax)? sCurve.u16_vmax : (unsigned int)u32_v);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           MOTION_Step
+//  Description:    Advances an axis by one cursor update. Inside the 
+//                  deadzone the axis stops and its fraction is dropped.
+//      Accepts:    - MOTION_AXIS* pAxis:   axis state
+//                  - unsigned char u8_pos: sensor coordinate
+//      Returns:    - int:                  whole cells to move, positive 
+//                                          above MIDPOINT
+///////////////////////////////////////////////////////////////////////////////
+int MOTION_Step(MOTION_AXIS* pAxis, unsigned char u8_pos)
+{
+    unsigned int u16_v;
+    int i16_cells;
+    
+    if(u8_pos > MIDPOINT - DEADZONE && u8_pos < MIDPOINT + DEADZONE)
+    {
+        pAxis->i16_acc = 0;
+        return(0);
+    }
+    
+    // the deadzone edge counts as 1, as it starts moving
+    if(u8_pos >= MIDPOINT)
+        u16_v = MOTION_Velocity(u8_pos - (MIDPOINT + DEADZONE) + 1);
+    else
+        u16_v = MOTION_Velocity((MIDPOINT - DEADZONE) - u8_pos + 1);
+    
+    // the share of one update period
+    if(u16_scale != SCALE_ONE)
+        u16_v = (unsigned int)(((unsigned long)u16_v * u16_scale) >> SCALE_SHIFT);
+    
+    if(u8_pos >= MIDPOINT)
+        pAxis->i16_acc += u16_v;
+    else
+        pAxis->i16_acc -= u16_v;
+    
+    // whole cells toward zero, the fraction keeps its sign
+    if(pAxis->i16_acc >= 0)
+        i16_cells = pAxis->i16_acc >> 8;
+    else
+        i16_cells = -(-pAxis->i16_acc >> 8);
+    pAxis->i16_acc -= i16_cells * MOTION_ONE;
+    
+    return(i16_cells);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           MOTION_Stop
+//  Description:    Drops the fraction of an axis, e.g. at a screen edge or
+//                  when the sensor stops reporting
+//      Accepts:    - MOTION_AXIS* pAxis:   axis state
+//      Returns:    None
+///////////////////////////////////////////////////////////////////////////////
+void MOTION_Stop(MOTION_AXIS* pAxis)
+{
+    pAxis->i16_acc = 0;
+}
@@ -0,0 +1,65 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+//  Filename:       motion.h
+//
+//  Description:    Header file for the motion.c cursor velocity model
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef _MOTION_H
+#define _MOTION_H
+
+#include "XZsensor.h"
+
+/////////////////////////////////// MACROS ///////////////////////////////////
+
+// default acceleration curve, velocities in Q8.8 cells per MOTION_PERIOD_MS
+// and d the sensor counts past the deadzone edge, 1 at the edge:
+//   v(d) = MOTION_GAIN * d + MOTION_ACCEL * d * d / 256, at most MOTION_VMAX
+// 1/16 cell at the edge, the full 12 cells from d = 93 on
+#ifndef MOTION_GAIN
+#define MOTION_GAIN     16
+#endif
+#ifndef MOTION_ACCEL
+#define MOTION_ACCEL    48
+#endif
+#ifndef MOTION_VMAX
+#define MOTION_VMAX     (12 * 256)
+#endif
+
+// cursor update period the curve is given for, the original one; other
+// periods set with MOTION_SetPeriod() move the cursor by a part of it per
+// update, at the same speed
+#define MOTION_PERIOD_MS    100
+
+// largest velocity a curve may set, the accumulator is a signed Q8.8 int
+#define MOTION_VLIMIT   (100 * 256)
+
+// one Q8.8 cell
+#define MOTION_ONE      256
+
+/////////////////////////////////// TYPES ////////////////////////////////////
+
+typedef struct
+{
+    unsigned int u16_gain;      // Q8.8 cells per period per count
+    unsigned int u16_accel;     // Q8.8 cells per period per 256 counts squared
+    unsigned int u16_vmax;      // Q8.8 cells per period
+} MOTION_CURVE;
+
+// per axis state: the fraction of a cell not moved yet
+typedef struct
+{
+    int i16_acc;                // Q8.8 cells, signed
+} MOTION_AXIS;
+
+///////////////////////////// FUNCTION PROTOTYPES /////////////////////////////
+
+void MOTION_SetCurve(const MOTION_CURVE* pCurve);
+void MOTION_GetCurve(MOTION_CURVE* pCurve);
+void MOTION_SetPeriod(unsigned int u16_ms);
+unsigned int MOTION_Velocity(unsigned char u8_d);
+int MOTION_Step(MOTION_AXIS* pAxis, unsigned char u8_pos);
+void MOTION_Stop(MOTION_AXIS* pAxis);
+
+#endif  // _MOTION_H
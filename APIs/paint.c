@@ -0,0 +1,200 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+//  Filename:       paint.c
+//
+//  Description:    
+//  The Terminal Paint cursor update: filters the XZ samples, turns the 
+//  newest one into a cursor move and performs the push button actions at
+//  the cursor. Called by the tasks of main.c on the target and by 
+//  sim/replay.c on the host, so recorded traces go through the same code.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "paint.h"
+#include "XZsensor.h"
+#include "hal.h"
+#include "prof.h"
+#include "stroke.h"
+#include "brush.h"
+#include "fill.h"
+#include "filter.h"
+#include "motion.h"
+#include "term.h"
+#include "fmt.h"
+
+// InitMsg: string with clearscreen and cursor home commands + Initialization message
+// txtBuff: char array to hold string to output to Tera Term
+static char InitMsg[32] = "\033[2J\033[HSystem initialized!\n\r";
+
+// column after the init message on the first row
+#define BOOT_COL    20
+static char txtBuff[64] = "";
+
+// xCoord: X Position from XZ Sensor
+// zCoord: Z Position from XZ Sensor
+// LastX: last X Position from XZ Sensor
+// LastZ: last Z Position from XZ Sensor
+// xCursor: cursor X position in Tera Term window, initialized to middle
+// zCursor: cursor Z position in Tera Term window, initialized to middle
+static unsigned char xCoord = 0, zCoord = 0, LastX, LastZ, xCursor = 92, zCursor = 39;
+
+// xSample, zSample: newest filtered X-Z values, taken by the cursor update
+static unsigned char xSample = 0, zSample = 0;
+static FILTER_AXIS sxFilter, szFilter;
+
+// xPrev, zPrev: coordinates before their last change, and the cursor 
+// updates since. With several updates per MOTION_PERIOD_MS a coordinate
+// only counts as repeated once it held for a whole period, as at the 
+// original rate, and not each time no new sample came in between.
+static unsigned char xPrev = 0, zPrev = 0, ucSameX = 0, ucSameZ = 0;
+static unsigned char ucPeriodFrames = 1;
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           PAINT_Initialize
+//  Description:    Clears the screen and the canvas, writes the init message
+//      Accepts:    None
+//      Returns:    None
+///////////////////////////////////////////////////////////////////////////////
+void PAINT_Initialize(void)
+{
+    clrScr(InitMsg);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           PAINT_SetPeriod
+//  Description:    Sets the cursor update period, the cursor keeps its 
+//                  speed in cells per second
+//      Accepts:    - unsigned int u16_ms:  update period, 1 to 
+//                                          MOTION_PERIOD_MS
+//      Returns:    None
+///////////////////////////////////////////////////////////////////////////////
+void PAINT_SetPeriod(unsigned int u16_ms)
+{
+    MOTION_SetPeriod(u16_ms);
+    ucPeriodFrames = (u16_ms && u16_ms < MOTION_PERIOD_MS)? MOTION_PERIOD_MS / u16_ms : 1;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           lastCoord
+//  Description:    The last coordinate for the same coordinates check of 
+//                  checkDir(): the one before the last change, or the new
+//                  one itself once it held for a motion period
+///////////////////////////////////////////////////////////////////////////////
+static unsigned char lastCoord(unsigned char ucOld, unsigned char ucNew, unsigned char* pucPrev, unsigned char* pucSame)
+{
+    if(ucNew != ucOld)
+    {
+        *pucPrev = ucOld;
+        *pucSame = 0;
+    }
+    else if(*pucSame < 255)
+        (*pucSame)++;
+    
+    return((*pucSame >= ucPeriodFrames)? ucNew : *pucPrev);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           PAINT_Sample
+//  Description:    Filters a new sample from the sensor, the next cursor 
+//                  update takes the newest result
+//      Accepts:    - unsigned char x:          X position from sensor
+//                  - unsigned char z:          Z position from sensor
+//      Returns:    None
+///////////////////////////////////////////////////////////////////////////////
+void PAINT_Sample(unsigned char x, unsigned char z)
+{
+    PROF_BEGIN(PROF_FILTER);
+    xSample = FILTER_Apply(&sxFilter, x);
+    zSample = FILTER_Apply(&szFilter, z);
+    PROF_END(PROF_FILTER);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           PAINT_Frame
+//  Description:    One cursor update: moves the cursor by the velocity of 
+//                  the sample and outputs it, drawing or erasing the cells 
+//                  on the way, or clears, as the buttons ask
+//      Accepts:    - unsigned char ucButtons:  HAL_BTN_ bits, since the last
+//                                              update: S3 pressed, S4 and S5
+//                                              pressed or held
+//      Returns:    None
+///////////////////////////////////////////////////////////////////////////////
+void PAINT_Frame(unsigned char ucButtons)
+{
+    // cursor position before the move, start of a stroke
+    unsigned char ucRow = zCursor, ucCol = xCursor;
+    
+    // save previous coordinates, take the newest sample
+    LastX = lastCoord(xCoord, xSample, &xPrev, &ucSameX);
+    LastZ = lastCoord(zCoord, zSample, &zPrev, &ucSameZ);
+    xCoord = xSample;
+    zCoord = zSample;
+
+    // checks cursor movement direction
+    PROF_BEGIN(PROF_CHECKDIR);
+    checkDir(LastX, LastZ, xCoord, zCoord, &xCursor, &zCursor);
+    PROF_END(PROF_CHECKDIR);
+
+    // outputs cursor position to Tera Term window, drawing or erasing with
+    // the brush along the move while a push button is held
+    PROF_BEGIN(PROF_OUTPUT);
+    if(!(ucButtons & (HAL_BTN_S4 | HAL_BTN_S5)))
+    {
+        BRUSH_Lift();
+        moveCursor(txtBuff, zCursor, xCursor);
+    }
+    if(ucButtons & HAL_BTN_S4) BRUSH_Stroke(ucRow, ucCol, zCursor, xCursor, CANVAS_INK);     // draw along the move
+    if(ucButtons & HAL_BTN_S5) BRUSH_Stroke(ucRow, ucCol, zCursor, xCursor, CANVAS_BLANK);   // erase along the move
+    if(ucButtons & HAL_BTN_S3)
+    {
+        BRUSH_Lift();
+        FILL_Cancel();
+        clrScr(InitMsg);    // clears the screen and write init message
+    }
+    PROF_END(PROF_OUTPUT);
+
+    // debugging: displays X-Z positions from XZ sensor
+    // (does not work when outputting cursor position to screen)
+//    sprintf(txtBuff, "\t X position: %3u \t Z position: %3u \t\r", xCoord, zCoord);
+//    outString(txtBuff);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           PAINT_Cursor
+//  Description:    Reads the cursor position
+//      Accepts:    - unsigned char* pucRow:    returns the 1-based row
+//                  - unsigned char* pucCol:    returns the 1-based column
+//      Returns:    None
+///////////////////////////////////////////////////////////////////////////////
+void PAINT_Cursor(unsigned char* pucRow, unsigned char* pucCol)
+{
+    *pucRow = zCursor;
+    *pucCol = xCursor;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           PAINT_ShowBoot
+//  Description:    Reports the boot time after the init message
+//      Accepts:    - unsigned long u32_us:     time from reset to the first
+//                                              cursor update, microseconds
+//      Returns:    None
+///////////////////////////////////////////////////////////////////////////////
+void PAINT_ShowBoot(unsigned long u32_us)
+{
+    static const char szLabel[] = " Boot time: ";
+    char msg[sizeof(szLabel) + FMT_U32_MAX + 5];
+    unsigned int u16_n;
+    
+    for(u16_n = 0; szLabel[u16_n] != '\0'; u16_n++)
+        msg[u16_n] = szLabel[u16_n];
+    u16_n += FMT_U32(msg + u16_n, u32_us / 1000, 0);
+    msg[u16_n++] = '.';
+    msg[u16_n++] = '0' + (u32_us / 100) % 10;
+    msg[u16_n++] = ' ';
+    msg[u16_n++] = 'm';
+    msg[u16_n++] = 's';
+    msg[u16_n] = '\0';
+    
+    TERM_MoveCursor(1, BOOT_COL);
+    TERM_PutString(msg);
+}
@@ -0,0 +1,21 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+//  Filename:       paint.h
+//
+//  Description:    Header file for the paint.c cursor update
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef _PAINT_H
+#define _PAINT_H
+
+///////////////////////////// FUNCTION PROTOTYPES /////////////////////////////
+
+void PAINT_Initialize(void);
+void PAINT_SetPeriod(unsigned int u16_ms);
+void PAINT_Sample(unsigned char x, unsigned char z);
+void PAINT_Frame(unsigned char ucButtons);
+void PAINT_Cursor(unsigned char* pucRow, unsigned char* pucCol);
+void PAINT_ShowBoot(unsigned long u32_us);
+
+#endif  // _PAINT_H
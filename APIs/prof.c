@@ -0,0 +1,277 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+//  Filename:       prof.c
+//
+//  Description:    
+//  Stage profiler on Timer2/3 as one free running 32-bit timer at Fcy, so
+//  times are in instruction cycles and wrap after 268 s. PROF_BEGIN() and
+//  PROF_END() around a stage add its duration to the stage's count, min, 
+//  max, sum and a power-of-two histogram, less the cost of the markers.
+//  A stage interrupted by an ISR includes the ISR's time. PROF_CMD on the
+//  terminal dumps the table through the UART2 Tx ring a line at a time 
+//  and starts a new measurement window. A last line gives the I2C1 
+//  transaction statistics, counted since reset.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "prof.h"
+
+#if PROF_ENABLE
+
+#include <xc.h>
+#include "i2c1.h"
+#include "uart2.h"
+#include "fmt.h"
+
+#define NAME_W      10
+#define NUM_W       11
+#define BIN_W       6
+
+// longest dump line: name, 4 numbers, the histogram and "\r\n"
+#define LINE_MAX    (NAME_W + 4 * NUM_W + PROF_BINS * BIN_W + 2)
+
+// accumulators of one stage, in cycles
+typedef struct
+{
+    unsigned long u32_count;
+    unsigned long u32_min;
+    unsigned long u32_max;
+    unsigned long long u64_sum;
+    unsigned long u32_bins[PROF_BINS];
+} PROF_STAGE;
+
+static const char* const pszNames[PROF_STAGES] = {
+    "xz read", "checkDir", "output", "buttons", "command", "filter"
+};
+
+volatile unsigned long u32_profStart[PROF_STAGES];
+static volatile PROF_STAGE sStages[PROF_STAGES];
+static unsigned long u32_overhead = 0;      // cycles of an empty BEGIN/END
+static unsigned long u32_window;            // PROF_Now() of the last reset
+
+// dump state, -1 when idle, else the next line
+static int iDumpLine = -1;
+static char cLine[LINE_MAX];
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           PROF_Initialize
+//  Description:    Starts Timer2/3 in 32-bit mode at Fcy, 1:1, and measures
+//                  the marker overhead
+//      Accepts:    None
+//      Returns:    None
+///////////////////////////////////////////////////////////////////////////////
+void PROF_Initialize(void)
+{
+    unsigned long u32_t;
+    int i;
+    
+    T2CON = 0x0000;             // stop timers, internal Fcy clock, 1:1
+    T3CON = 0x0000;
+    T2CONbits.T32 = 1;          // Timer2/3 pair as one 32-bit timer
+    TMR3 = 0;
+    TMR2 = 0;
+    PR3 = 0xFFFF;               // free running over the full 32 bits
+    PR2 = 0xFFFF;
+    T2CONbits.TON = 1;
+    
+    // cheapest of a few empty stages
+    u32_overhead = 0xFFFFFFFF;
+    for(i = 0; i < 8; i++)
+    {
+        u32_profStart[0] = PROF_Now();
+        u32_t = PROF_Now() - u32_profStart[0];
+        if(u32_t < u32_overhead)
+            u32_overhead = u32_t;
+    }
+    
+    PROF_Reset();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           PROF_Now
+//  Description:    Reads the 32-bit timer, the high word is read again to 
+//                  catch a carry between the two halves, without the 
+//                  TMR3HLD latch an ISR read could overwrite
+//      Accepts:    None
+//      Returns:    - unsigned long:    instruction cycles
+///////////////////////////////////////////////////////////////////////////////
+unsigned long PROF_Now(void)
+{
+    unsigned int u16_hi, u16_lo;
+    
+    do
+    {
+        u16_hi = TMR3;
+        u16_lo = TMR2;
+    }
+    while(u16_hi != TMR3);
+    
+    return(((unsigned long)u16_hi << 16) | u16_lo);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           PROF_Record
+//  Description:    Adds a stage duration, called by PROF_END()
+//      Accepts:    - unsigned int u16_stage:   PROF_ stage
+//                  - unsigned long u32_cycles: measured cycles, markers 
+//                                              included
+//      Returns:    None
+///////////////////////////////////////////////////////////////////////////////
+void PROF_Record(unsigned int u16_stage, unsigned long u32_cycles)
+{
+    volatile PROF_STAGE* pStage = &sStages[u16_stage];
+    unsigned long u32_bin;
+    unsigned int u16_bin = 0;
+    
+    u32_cycles = (u32_cycles > u32_overhead)? u32_cycles - u32_overhead : 0;
+    
+    pStage->u32_count++;
+    pStage->u64_sum += u32_cycles;
+    if(u32_cycles < pStage->u32_min)
+        pStage->u32_min = u32_cycles;
+    if(u32_cycles > pStage->u32_max)
+        pStage->u32_max = u32_cycles;
+    
+    for(u32_bin = u32_cycles; u32_bin >= PROF_BIN0_CYCLES && u16_bin < PROF_BINS - 1; u32_bin >>= 1)
+        u16_bin++;
+    pStage->u32_bins[u16_bin]++;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           PROF_Reset
+//  Description:    Clears the accumulators and starts a new window
+//      Accepts:    None
+//      Returns:    None
+///////////////////////////////////////////////////////////////////////////////
+void PROF_Reset(void)
+{
+    unsigned int u16_s, u16_b;
+    
+    for(u16_s = 0; u16_s < PROF_STAGES; u16_s++)
+    {
+        sStages[u16_s].u32_count = 0;
+        sStages[u16_s].u32_min = 0xFFFFFFFF;
+        sStages[u16_s].u32_max = 0;
+        sStages[u16_s].u64_sum = 0;
+        for(u16_b = 0; u16_b < PROF_BINS; u16_b++)
+            sStages[u16_s].u32_bins[u16_b] = 0;
+    }
+    u32_window = PROF_Now();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           putText
+//  Description:    Appends a string, padded with spaces to <u16_width>
+///////////////////////////////////////////////////////////////////////////////
+static unsigned int putText(char* pBuff, const char* psz, unsigned int u16_width)
+{
+    unsigned int u16_n = 0;
+    
+    while(*psz)
+        pBuff[u16_n++] = *psz++;
+    while(u16_n < u16_width)
+        pBuff[u16_n++] = ' ';
+    
+    return(u16_n);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           dumpLine
+//  Description:    Formats line <iLine> of the dump: title, column header,
+//                  one line per stage, then the I2C1 statistics
+//      Returns:    line length
+///////////////////////////////////////////////////////////////////////////////
+static unsigned int dumpLine(char* pBuff, int iLine)
+{
+    volatile PROF_STAGE* pStage;
+    unsigned long u32_count;
+    unsigned int u16_n = 0, u16_b;
+    I2C1_STATS sI2C;
+    
+    if(iLine == 0)
+    {
+        u16_n += putText(pBuff, "\033[2J\033[Hstage cycles at Fcy over ", 0);
+        u16_n += FMT_U32(pBuff + u16_n, (PROF_Now() - u32_window) / (FCY / 1000), 0);
+        u16_n += putText(pBuff + u16_n, " ms, bin k < 16 << k cycles", 0);
+    }
+    else if(iLine == 1)
+    {
+        u16_n += putText(pBuff, "stage", NAME_W);
+        u16_n += putText(pBuff + u16_n, "      count", 0);
+        u16_n += putText(pBuff + u16_n, "        min", 0);
+        u16_n += putText(pBuff + u16_n, "       mean", 0);
+        u16_n += putText(pBuff + u16_n, "        max", 0);
+        for(u16_b = 0; u16_b < PROF_BINS; u16_b++)
+            u16_n += FMT_U32(pBuff + u16_n, u16_b, BIN_W);
+    }
+    else if(iLine == PROF_STAGES + 2)
+    {
+        statsI2C1(&sI2C);
+        u16_n += putText(pBuff, "i2c at ", 0);
+        u16_n += FMT_U32(pBuff + u16_n, I2C1_Speed(), 0);
+        u16_n += putText(pBuff + u16_n, " kHz: ", 0);
+        u16_n += FMT_U32(pBuff + u16_n, sI2C.ulXfers, 0);
+        u16_n += putText(pBuff + u16_n, " transactions, ", 0);
+        u16_n += FMT_U32(pBuff + u16_n, sI2C.ulNaks, 0);
+        u16_n += putText(pBuff + u16_n, " NAK, ", 0);
+        u16_n += FMT_U32(pBuff + u16_n, sI2C.ulTimeouts, 0);
+        u16_n += putText(pBuff + u16_n, " timeouts, ", 0);
+        u16_n += FMT_U32(pBuff + u16_n, sI2C.ulRecoveries, 0);
+        u16_n += putText(pBuff + u16_n, " recoveries, mean ", 0);
+        u16_n += FMT_U32(pBuff + u16_n, sI2C.ulMeanUs, 0);
+        u16_n += putText(pBuff + u16_n, " us, max ", 0);
+        u16_n += FMT_U32(pBuff + u16_n, sI2C.ulMaxUs, 0);
+        u16_n += putText(pBuff + u16_n, " us", 0);
+    }
+    else
+    {
+        pStage = &sStages[iLine - 2];
+        u32_count = pStage->u32_count;
+        u16_n += putText(pBuff, pszNames[iLine - 2], NAME_W);
+        u16_n += FMT_U32(pBuff + u16_n, u32_count, NUM_W);
+        u16_n += FMT_U32(pBuff + u16_n, u32_count? pStage->u32_min : 0, NUM_W);
+        u16_n += FMT_U32(pBuff + u16_n, u32_count? pStage->u64_sum / u32_count : 0, NUM_W);
+        u16_n += FMT_U32(pBuff + u16_n, pStage->u32_max, NUM_W);
+        for(u16_b = 0; u16_b < PROF_BINS; u16_b++)
+            u16_n += FMT_U32(pBuff + u16_n, pStage->u32_bins[u16_b], BIN_W);
+    }
+    
+    pBuff[u16_n++] = '\r';
+    pBuff[u16_n++] = '\n';
+    return(u16_n);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           PROF_DumpStart / PROF_DumpStep
+//  Description:    Sends the table over UART2. PROF_DumpStep() sends the 
+//                  next lines while the Tx ring has room for a whole line,
+//                  nothing else may be sent meanwhile. After the last line 
+//                  the accumulators are reset.
+//      Accepts:    None
+//      Returns:    - char:     PROF_DumpStep(), 1 once the table is sent
+///////////////////////////////////////////////////////////////////////////////
+void PROF_DumpStart(void)
+{
+    iDumpLine = 0;
+}
+
+char PROF_DumpStep(void)
+{
+    unsigned int u16_n;
+    
+    while(iDumpLine >= 0 && txFreeUART2() >= LINE_MAX)
+    {
+        u16_n = dumpLine(cLine, iDumpLine);
+        outBytes(cLine, u16_n);
+        
+        if(++iDumpLine == PROF_STAGES + 3)
+        {
+            iDumpLine = -1;
+            PROF_Reset();
+        }
+    }
+    
+    return(iDumpLine < 0);
+}
+
+#endif  // PROF_ENABLE
@@ -0,0 +1,62 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+//  Filename:       prof.h
+//
+//  Description:    
+//  Header file for the prof.c stage profiler. Build with PROF_ENABLE set to
+//  1 (e.g. -DPROF_ENABLE=1) to profile; otherwise PROF_BEGIN/PROF_END and
+//  the other calls expand to nothing and Timer2/3 stays free.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef _PROF_H
+#define _PROF_H
+
+/////////////////////////////////// MACROS ///////////////////////////////////
+
+#ifndef PROF_ENABLE
+#define PROF_ENABLE     0
+#endif
+
+// profiled stages
+#define PROF_XZ_READ    0       // XZ burst read, DR edge to completion in DR mode
+#define PROF_CHECKDIR   1       // cursor direction, checkDir()
+#define PROF_OUTPUT     2       // cursor and paint output to the Tx ring
+#define PROF_BUTTONS    3       // button debounce and events
+#define PROF_COMMAND    4       // terminal commands and canvas repaint
+#define PROF_FILTER     5       // sample noise filter, both axes
+#define PROF_STAGES     6
+
+// histogram: bin 0 counts stages under PROF_BIN0_CYCLES cycles, each next
+// bin twice as wide, the last bin everything longer (16.4 ms at 16 MHz)
+#define PROF_BINS       16
+#define PROF_BIN0_CYCLES 16UL
+
+// dump command received on UART2
+#define PROF_CMD        'p'
+
+#if PROF_ENABLE
+
+#define PROF_BEGIN(s)   (u32_profStart[s] = PROF_Now())
+#define PROF_END(s)     PROF_Record((s), PROF_Now() - u32_profStart[s])
+
+extern volatile unsigned long u32_profStart[PROF_STAGES];
+
+///////////////////////////// FUNCTION PROTOTYPES /////////////////////////////
+
+void PROF_Initialize(void);
+unsigned long PROF_Now(void);
+void PROF_Record(unsigned int u16_stage, unsigned long u32_cycles);
+void PROF_Reset(void);
+void PROF_DumpStart(void);
+char PROF_DumpStep(void);
+
+#else
+
+#define PROF_BEGIN(s)       ((void)0)
+#define PROF_END(s)         ((void)0)
+#define PROF_Initialize()   ((void)0)
+
+#endif  // PROF_ENABLE
+
+#endif  // _PROF_H
@@ -0,0 +1,101 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+//  Filename:       range.c
+//
+//  Description:
+//  The third input axis: the distance of the hand over the VL6180 sets the
+//  pen state or the brush size. The distance goes through a piecewise
+//  linear curve with knots at powers of two apart, so the interpolation is
+//  a multiply and a shift. Both outputs have hysteresis, a hand held at a
+//  threshold does not make the pen or the brush flicker with the sensor
+//  noise of a few mm.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "range.h"
+
+// level at 0, 32, ... 256 mm: full within a hand's width of the sensor,
+// steepest in the middle where the hand is easiest to hold steady
+static const unsigned char ucCurve[RANGE_KNOTS] =
+{
+    255, 255, 224, 168, 112, 64, 28, 8, 0
+};
+
+static unsigned char ucLevel = 0;
+static char cPen = 0;
+static unsigned char ucBrush = 1;
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           curve
+//  Description:    Level of a distance, interpolated between the knots
+///////////////////////////////////////////////////////////////////////////////
+static unsigned char curve(unsigned char ucMm)
+{
+    unsigned int i = ucMm >> RANGE_KNOT_SHIFT;
+    int iFrac = ucMm & ((1 << RANGE_KNOT_SHIFT) - 1);
+    int iRise = (int)ucCurve[i + 1] - ucCurve[i];
+
+    return(ucCurve[i] + ((iRise * iFrac) >> RANGE_KNOT_SHIFT));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           RANGE_Sample
+//  Description:    Takes a new distance and updates the pen and the brush
+//      Accepts:    - unsigned char ucMm:   distance in mm, RANGE_NONE if
+//                                          there is no target
+//      Returns:    None
+///////////////////////////////////////////////////////////////////////////////
+void RANGE_Sample(unsigned char ucMm)
+{
+    unsigned int uiScaled;
+
+    ucLevel = (ucMm == RANGE_NONE)? 0 : curve(ucMm);
+
+    if(ucLevel >= RANGE_PEN_DOWN)
+        cPen = 1;
+    else if(ucLevel < RANGE_PEN_UP)
+        cPen = 0;
+
+    // size - 1 in 1/256 steps, rounded to the nearest size once it is
+    // RANGE_BRUSH_HYST past the middle
+    uiScaled = (unsigned int)ucLevel * (RANGE_BRUSH_MAX - 1);
+    while(ucBrush < RANGE_BRUSH_MAX
+          && uiScaled >= ((unsigned int)(ucBrush - 1) << 8) + 128 + RANGE_BRUSH_HYST)
+        ucBrush++;
+    while(ucBrush > 1
+          && uiScaled + 128 + RANGE_BRUSH_HYST <= ((unsigned int)(ucBrush - 1) << 8))
+        ucBrush--;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           RANGE_Level
+//  Description:    Reads the level of the last distance
+//      Accepts:    None
+//      Returns:    - unsigned char:    0 far or no target to 255 close
+///////////////////////////////////////////////////////////////////////////////
+unsigned char RANGE_Level(void)
+{
+    return(ucLevel);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           RANGE_PenDown
+//  Description:    Reads the pen state
+//      Accepts:    None
+//      Returns:    - char:     1 if the pen is down
+///////////////////////////////////////////////////////////////////////////////
+char RANGE_PenDown(void)
+{
+    return(cPen);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           RANGE_Brush
+//  Description:    Reads the brush size
+//      Accepts:    None
+//      Returns:    - unsigned char:    1 to RANGE_BRUSH_MAX cells
+///////////////////////////////////////////////////////////////////////////////
+unsigned char RANGE_Brush(void)
+{
+    return(ucBrush);
+}
@@ -0,0 +1,48 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+//  Filename:       range.h
+//
+//  Description:    Header file for the range.c third input axis
+//
+//  The VL6180 distance of the hand is mapped through a fixed-point curve to
+//  a level, 0 far away to 255 close to the sensor, which sets either the
+//  pen state or the brush size.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef _RANGE_H
+#define _RANGE_H
+
+/////////////////////////////////// MACROS ///////////////////////////////////
+
+// what the axis controls, RANGE_AXIS in main.c
+#define RANGE_AXIS_OFF      0
+#define RANGE_AXIS_PEN      1       // hand close draws like S4 held
+#define RANGE_AXIS_BRUSH    2       // hand closer paints with a bigger brush
+
+// distance of no target; main.c also feeds it when no valid range came 
+// for RANGE_LOST_MS, e.g. the hand left and the sensor reports errors
+#define RANGE_NONE          0xFF
+#define RANGE_LOST_MS       100
+
+// curve knots, every 1 << RANGE_KNOT_SHIFT mm from 0 to 256 mm
+#define RANGE_KNOT_SHIFT    5
+#define RANGE_KNOTS         ((256 >> RANGE_KNOT_SHIFT) + 1)
+
+// pen down from this level on, up again below RANGE_PEN_UP
+#define RANGE_PEN_DOWN      160
+#define RANGE_PEN_UP        112
+
+// brush sizes 1 to RANGE_BRUSH_MAX; a size changes once the level is this
+// many 1/256 of a size step past the middle between two sizes
+#define RANGE_BRUSH_MAX     8
+#define RANGE_BRUSH_HYST    64
+
+///////////////////////////// FUNCTION PROTOTYPES /////////////////////////////
+
+void RANGE_Sample(unsigned char ucMm);
+unsigned char RANGE_Level(void);
+char RANGE_PenDown(void);
+unsigned char RANGE_Brush(void);
+
+#endif  // _RANGE_H
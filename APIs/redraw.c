@@ -0,0 +1,172 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+//  Filename:       redraw.c
+//
+//  Description:    
+//  Repaints dirty canvas rows on the terminal. REDRAW_Start() erases the 
+//  screen and marks every row dirty, e.g. after the terminal was resized or
+//  reconnected; rows whose paint output was dropped are dirty too. 
+//  REDRAW_Step() sends the dirty rows while the UART2 Tx ring has room.
+//
+//  A row is sent as runs of equal cells. An ink run is one block character
+//  and REP for the rest; a blank run is skipped with a cursor move when the
+//  terminal row was cleared, otherwise it is overwritten with a space and 
+//  REP (or ECH and a move); the blank tail of a row is skipped or erased 
+//  with EL. Each run takes whichever is shorter, the encoded run or plain 
+//  characters. An empty screen redraws in under 100 bytes instead of one
+//  byte or more for each of the 14,536 cells.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "redraw.h"
+#include "uart2.h"
+#include "fmt.h"
+
+#define INK_CHAR    '\xDB'
+#define BLANK_CHAR  ' '
+
+// the screen erase is held back until the Tx ring has room for it
+static const char szClear[] = "\033[2J";
+static char cClearPending = 0;
+
+static char cRowBuff[REDRAW_ROW_MAX];
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           putRepeat
+//  Description:    Writes <u8_n> times <c>, as <c> and REP when shorter
+//      Returns:    number of characters written
+///////////////////////////////////////////////////////////////////////////////
+static unsigned int putRepeat(char* pBuff, char c, unsigned char u8_n)
+{
+    unsigned int u16_i;
+    
+    pBuff[0] = c;
+#if REDRAW_USE_REP
+    if(u8_n > 2 && FMT_CsiLen(u8_n - 1) < u8_n - 1)
+        return(1 + FMT_Csi(pBuff + 1, u8_n - 1, 'b'));
+#endif
+    for(u16_i = 1; u16_i < u8_n; u16_i++)
+        pBuff[u16_i] = c;
+    return(u8_n);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           putBlank
+//  Description:    Blanks <u8_n> cells from the cursor and leaves the cursor
+//                  after them
+//      Returns:    number of characters written
+///////////////////////////////////////////////////////////////////////////////
+static unsigned int putBlank(char* pBuff, unsigned char u8_n)
+{
+#if REDRAW_USE_ECH && !REDRAW_USE_REP
+    unsigned int u16_n;
+    
+    if(2 * FMT_CsiLen(u8_n) < u8_n)
+    {
+        u16_n = FMT_Csi(pBuff, u8_n, 'X');
+        return(u16_n + FMT_Csi(pBuff + u16_n, u8_n, 'C'));
+    }
+#endif
+    return(putRepeat(pBuff, BLANK_CHAR, u8_n));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           REDRAW_RowSeq
+//  Description:    Builds the output repainting one row, starting with the 
+//                  move to its first column, and records where it leaves 
+//                  the terminal cursor. Blank cells are skipped if the row
+//                  is marked cleared.
+//      Accepts:    - char* pBuff:          buffer of at least REDRAW_ROW_MAX
+//                  - unsigned char row:    1-based row, 1 to SCREEN_H
+//      Returns:    - unsigned int:         output length
+///////////////////////////////////////////////////////////////////////////////
+unsigned int REDRAW_RowSeq(char* pBuff, unsigned char row)
+{
+    const unsigned char* pu8_row = CANVAS_Row(row);
+    char cCleared = CANVAS_IsCleared(row);
+    unsigned char u8_col = 1, u8_cur = 1, u8_end;
+    unsigned int u16_n;
+    char state;
+    
+    u16_n = TERM_CursorSeq(pBuff, row, 1);
+    
+    while(u8_col <= SCREEN_W)
+    {
+        state = (pu8_row[(u8_col - 1) >> 3] >> ((u8_col - 1) & 7)) & 1;
+        u8_end = CANVAS_RunEnd(row, u8_col, state);
+        
+        if(state)
+        {
+            // blanks skipped before the run
+            if(u8_cur < u8_col)
+                u16_n += (u8_col - u8_cur < FMT_CsiLen(u8_col - u8_cur))?
+                    putRepeat(pBuff + u16_n, BLANK_CHAR, u8_col - u8_cur) :
+                    FMT_Csi(pBuff + u16_n, u8_col - u8_cur, 'C');
+            u16_n += putRepeat(pBuff + u16_n, INK_CHAR, u8_end - u8_col);
+            u8_cur = u8_end;
+        }
+        else if(!cCleared)
+        {
+            if(u8_end > SCREEN_W && SCREEN_W + 1 - u8_col > 3)
+            {
+                // erase in line, cursor to the end of the line
+                pBuff[u16_n++] = '\033';
+                pBuff[u16_n++] = '[';
+                pBuff[u16_n++] = 'K';
+            }
+            else
+            {
+                u16_n += putBlank(pBuff + u16_n, u8_end - u8_col);
+                u8_cur = u8_end;
+            }
+        }
+        u8_col = u8_end;
+    }
+    
+    TERM_SetPosition(row, u8_cur);
+    return(u16_n);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           REDRAW_Start
+//  Description:    Requests a repaint of the whole canvas: the screen is 
+//                  erased and every row redrawn by the next REDRAW_Step()s
+//      Accepts:    None
+//      Returns:    None
+///////////////////////////////////////////////////////////////////////////////
+void REDRAW_Start(void)
+{
+    cClearPending = 1;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           REDRAW_Step
+//  Description:    Sends dirty rows while the UART2 Tx ring has room for a 
+//                  whole row, the rest waits for the next call. Nothing is
+//                  dropped so paint output keeps its place in the ring.
+//      Accepts:    None
+//      Returns:    - char:     1 while rows remain to be sent
+///////////////////////////////////////////////////////////////////////////////
+char REDRAW_Step(void)
+{
+    unsigned char row;
+    
+    if(cClearPending)
+    {
+        if(txFreeUART2() < sizeof(szClear) - 1)
+            return(1);
+        TERM_PutString(szClear);
+        CANVAS_MarkAllCleared();
+        cClearPending = 0;
+    }
+    
+    for(row = CANVAS_NextDirty(1); row != 0; row = CANVAS_NextDirty(row + 1))
+    {
+        if(txFreeUART2() < REDRAW_ROW_MAX)
+            return(1);
+        outBytes(cRowBuff, REDRAW_RowSeq(cRowBuff, row));
+        CANVAS_CleanRow(row);
+    }
+    
+    return(0);
+}
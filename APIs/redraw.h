@@ -0,0 +1,36 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+//  Filename:       redraw.h
+//
+//  Description:    Header file for the redraw.c canvas repaint
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef _REDRAW_H
+#define _REDRAW_H
+
+#include "canvas.h"
+#include "term.h"
+
+/////////////////////////////////// MACROS ///////////////////////////////////
+
+// set to 0 for terminals without REP ("\033[<n>b", repeat last character)
+// or ECH ("\033[<n>X", erase characters), plain characters are sent instead
+#define REDRAW_USE_REP  TERM_USE_REP
+#define REDRAW_USE_ECH  1
+
+// longest encoding of one row: move to its start, then at most one byte
+// per cell since every run is sent the cheapest way, plain characters 
+// included
+#define REDRAW_ROW_MAX  (TERM_SEQ_MAX + SCREEN_W)
+
+// resync command received on UART2
+#define REDRAW_CMD      'r'
+
+///////////////////////////// FUNCTION PROTOTYPES /////////////////////////////
+
+void REDRAW_Start(void);
+char REDRAW_Step(void);
+unsigned int REDRAW_RowSeq(char* pBuff, unsigned char row);
+
+#endif  // _REDRAW_H
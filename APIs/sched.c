@@ -0,0 +1,246 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+//  Filename:       sched.c
+//
+//  Description:    
+//  Fixed-rate cooperative scheduler for the pic24FJ128GA010. Timer1 raises a
+//  tick every 1/SCHED_TICK_HZ s; SCHED_Run() starts every task whose period
+//  has elapsed, in the order the tasks were added, and puts the CPU in Idle()
+//  until the next interrupt when nothing is due. Task periods are counted 
+//  from the due tick, not from when the task actually ran, so a slow task 
+//  delays the others but never makes the rate drift.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "sched.h"
+#include "i2c1.h"
+#include <xc.h>
+
+// use interrupt no_auto_psv attribute to reduce interrupt overhead
+#define ISR_NO_PSV __attribute__((__interrupt__, no_auto_psv))
+
+// periodic task table
+typedef struct
+{
+    SCHED_FN pfTask;
+    unsigned int uiPeriod;      // ticks between runs
+    unsigned int uiDue;         // tick of the next run
+    unsigned long ulLateMax;    // release jitter accumulators, in cycles
+    unsigned long ulLateSum;
+    unsigned long ulRuns;
+} SCHED_TASK;
+
+static SCHED_TASK sTasks[SCHED_MAX_TASKS];
+static int iTaskCnt = 0;
+
+// ticks since SCHED_Initialize(), wraps after 65.5 s at 1 kHz
+static volatile unsigned int u16_ticks = 0;
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           lateness
+//  Description:    Cycles elapsed since the start of tick <u16_due>, taken 
+//                  modulo the tick counter so it is correct across a wrap
+///////////////////////////////////////////////////////////////////////////////
+static unsigned long lateness(unsigned int u16_due)
+{
+    unsigned int u16_t;
+    unsigned int u16_count;
+    
+    do
+    {
+        u16_t = u16_ticks;
+        u16_count = TMR1;
+    }
+    while(u16_t != u16_ticks);
+    
+    return((unsigned long)(unsigned int)(u16_t - u16_due) * SCHED_TICK_CYCLES
+            + u16_count);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           T1Interrupt
+//  Description:    ISR for the Timer1 period match, counts scheduler ticks
+///////////////////////////////////////////////////////////////////////////////
+void ISR_NO_PSV _T1Interrupt(void)
+{
+    u16_ticks++;
+    IFS0bits.T1IF = 0;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           SCHED_Initialize
+//  Description:    Starts Timer1 at SCHED_TICK_HZ and clears the task table
+//      Accepts:    None
+//      Returns:    None
+///////////////////////////////////////////////////////////////////////////////
+void SCHED_Initialize(void)
+{
+    T1CON = 0x0000;             // stop timer, internal Fcy clock, 1:1
+    TMR1 = 0;
+    PR1 = SCHED_TICK_CYCLES - 1;
+    
+    iTaskCnt = 0;
+    u16_ticks = 0;
+    
+    IPC0bits.T1IP = 3;
+    IFS0bits.T1IF = 0;
+    IEC0bits.T1IE = 1;
+    
+    T1CONbits.TON = 1;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           SCHED_AddTask
+//  Description:    Adds a periodic task, first run on the next tick
+//      Accepts:    - SCHED_FN pfTask:          task function
+//                  - unsigned int uiPeriod:    period in ticks, see SCHED_MS()
+//      Returns:    - int:  task number, -1 if the table is full
+///////////////////////////////////////////////////////////////////////////////
+int SCHED_AddTask(SCHED_FN pfTask, unsigned int uiPeriod)
+{
+    SCHED_TASK* pTask;
+    
+    if(iTaskCnt >= SCHED_MAX_TASKS)
+        return(-1);
+    
+    pTask = &sTasks[iTaskCnt];
+    pTask->pfTask = pfTask;
+    pTask->uiPeriod = uiPeriod? uiPeriod : 1;
+    pTask->uiDue = u16_ticks + 1;
+    pTask->ulLateMax = 0;
+    pTask->ulLateSum = 0;
+    pTask->ulRuns = 0;
+    
+    return(iTaskCnt++);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           SCHED_SetPeriod
+//  Description:    Changes the period of a task, effective after its next run
+//      Accepts:    - int iTask:                task number
+//                  - unsigned int uiPeriod:    period in ticks
+//      Returns:    None
+///////////////////////////////////////////////////////////////////////////////
+void SCHED_SetPeriod(int iTask, unsigned int uiPeriod)
+{
+    if(iTask >= 0 && iTask < iTaskCnt)
+        sTasks[iTask].uiPeriod = uiPeriod? uiPeriod : 1;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           SCHED_Release
+//  Description:    Makes a task due at once, its period then counts from 
+//                  this run
+//      Accepts:    - int iTask:                task number
+//      Returns:    None
+///////////////////////////////////////////////////////////////////////////////
+void SCHED_Release(int iTask)
+{
+    if(iTask >= 0 && iTask < iTaskCnt)
+        sTasks[iTask].uiDue = u16_ticks;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           SCHED_Ticks
+//  Description:    Returns the tick counter
+//      Accepts:    None
+//      Returns:    - unsigned int:     ticks since SCHED_Initialize()
+///////////////////////////////////////////////////////////////////////////////
+unsigned int SCHED_Ticks(void)
+{
+    return(u16_ticks);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           SCHED_Now
+//  Description:    Returns a cycle accurate timestamp from the tick counter
+//                  and TMR1, rereading if a tick happens in between
+//      Accepts:    None
+//      Returns:    - unsigned long:    instruction cycles, wraps with ticks
+///////////////////////////////////////////////////////////////////////////////
+unsigned long SCHED_Now(void)
+{
+    unsigned int u16_t;
+    unsigned int u16_count;
+    
+    do
+    {
+        u16_t = u16_ticks;
+        u16_count = TMR1;
+    }
+    while(u16_t != u16_ticks);
+    
+    return((unsigned long)u16_t * SCHED_TICK_CYCLES + u16_count);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           SCHED_Jitter
+//  Description:    Reports the release jitter measured for a task
+//      Accepts:    - int iTask:                task number
+//                  - SCHED_JITTER* pJitter:    returns the statistics, all 
+//                                              0 for an unknown task
+//      Returns:    None
+///////////////////////////////////////////////////////////////////////////////
+void SCHED_Jitter(int iTask, SCHED_JITTER* pJitter)
+{
+    SCHED_TASK* pTask;
+    
+    if(iTask < 0 || iTask >= iTaskCnt)
+    {
+        pJitter->ulMax = pJitter->ulMean = pJitter->ulRuns = 0;
+        return;
+    }
+    
+    pTask = &sTasks[iTask];
+    pJitter->ulMax = pTask->ulLateMax;
+    pJitter->ulRuns = pTask->ulRuns;
+    pJitter->ulMean = pTask->ulRuns? pTask->ulLateSum / pTask->ulRuns : 0;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           SCHED_Run
+//  Description:    Runs the tasks forever, idling the CPU between ticks
+//      Accepts:    None
+//      Returns:    Never
+///////////////////////////////////////////////////////////////////////////////
+void SCHED_Run(void)
+{
+    SCHED_TASK* pTask;
+    unsigned long ulLate;
+    int iRan;
+    int i;
+    
+    while(1)
+    {
+        iRan = 0;
+        
+        for(i = 0; i < iTaskCnt; i++)
+        {
+            pTask = &sTasks[i];
+            
+            // signed difference handles the tick counter wrapping
+            if((int)(u16_ticks - pTask->uiDue) < 0)
+                continue;
+            
+            ulLate = lateness(pTask->uiDue);
+            if(ulLate > pTask->ulLateMax)
+                pTask->ulLateMax = ulLate;
+            pTask->ulLateSum += ulLate;
+            pTask->ulRuns++;
+            
+            pTask->pfTask();
+            
+            // skip whole periods that were missed rather than bursting
+            do
+                pTask->uiDue += pTask->uiPeriod;
+            while((int)(u16_ticks - pTask->uiDue) >= 0);
+            
+            iRan = 1;
+        }
+        
+        // sleep until the next tick, a tick arriving after the check above 
+        // only delays the tasks due on it by one tick
+        if(!iRan)
+            Idle();
+    }
+}
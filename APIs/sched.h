@@ -0,0 +1,48 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+//  Filename:       sched.h
+//
+//  Description:    Header file for the sched.c Timer1 tick and cooperative
+//                  periodic task scheduler
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef _SCHED_H
+#define _SCHED_H
+
+/////////////////////////////////// MACROS ///////////////////////////////////
+
+#define SCHED_TICK_HZ   1000    // Timer1 tick rate, 1 ms resolution
+#define SCHED_MAX_TASKS 8       // max number of periodic tasks
+
+// Timer1 counts per tick, Timer1 runs from Fcy with a 1:1 prescaler
+#define SCHED_TICK_CYCLES   (FCY / SCHED_TICK_HZ)
+
+// converts milliseconds to ticks
+#define SCHED_MS(ms)    ((unsigned int)((ms) * (unsigned long)SCHED_TICK_HZ / 1000))
+
+/////////////////////////////////// TYPES ////////////////////////////////////
+
+typedef void (*SCHED_FN)(void);
+
+// release jitter of a task: how late it started after its due tick, in
+// instruction cycles
+typedef struct
+{
+    unsigned long ulMax;        // worst lateness
+    unsigned long ulMean;       // mean lateness
+    unsigned long ulRuns;       // number of runs measured
+} SCHED_JITTER;
+
+///////////////////////////// FUNCTION PROTOTYPES /////////////////////////////
+
+void SCHED_Initialize(void);
+int SCHED_AddTask(SCHED_FN pfTask, unsigned int uiPeriod);
+void SCHED_SetPeriod(int iTask, unsigned int uiPeriod);
+void SCHED_Release(int iTask);
+unsigned int SCHED_Ticks(void);
+unsigned long SCHED_Now(void);
+void SCHED_Jitter(int iTask, SCHED_JITTER* pJitter);
+void SCHED_Run(void);
+
+#endif  // _SCHED_H
@@ -0,0 +1,129 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+//  Filename:       stroke.c
+//
+//  Description:    
+//  Paints the cells of a cursor move, so a pen or eraser held while the 
+//  cursor moves several cells per update leaves a connected stroke. The 
+//  line is rasterized with Bresenham's algorithm and cut into runs of 
+//  cells on one row. Each run is sent left to right as one character and
+//  REP, or plain characters, with only the cells that change; an erased 
+//  run is one ECH. Between runs term.c picks the shortest move, e.g. a 
+//  line feed and a backspace to the cell below the one just painted, or a
+//  single line feed down a diagonal.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "stroke.h"
+#include "term.h"
+
+#define INK_CHAR    '\xDB'
+
+// last cell sent by STROKE_Span(), row 0 if none
+static unsigned char u8_lastRow, u8_lastCol;
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           STROKE_Span
+//  Description:    Sets cells <u8_lo> to <u8_hi> of <u8_row> and sends the 
+//                  ones that changed, each run of them after one cursor 
+//                  move; a row whose output is dropped is left dirty for 
+//                  the redraw. The runs are found and set a byte of cells
+//                  at a time.
+//      Accepts:    - unsigned char u8_row:     1-based row, 1 to SCREEN_H
+//                  - unsigned char u8_lo:      first 1-based column
+//                  - unsigned char u8_hi:      last 1-based column, u8_lo
+//                                              to SCREEN_W
+//                  - char state:               CANVAS_INK or CANVAS_BLANK
+//      Returns:    None
+///////////////////////////////////////////////////////////////////////////////
+void STROKE_Span(unsigned char u8_row, unsigned char u8_lo, unsigned char u8_hi, char state)
+{
+    char cSent;
+
+    unsigned char u8_start, u8_end;
+    
+    for(u8_start = u8_lo; ; u8_start = u8_end)
+    {
+        // skip the cells that hold <state>, the run of the others changes
+        u8_start = CANVAS_RunEnd(u8_row, u8_start, state);
+        if(u8_start > u8_hi)
+            break;
+        u8_end = CANVAS_RunEnd(u8_row, u8_start, !state);
+        if(u8_end > u8_hi + 1)
+            u8_end = u8_hi + 1;
+        CANVAS_SetRun(u8_row, u8_start, u8_end - 1, state);
+        
+        TERM_MoveCursor(u8_row, u8_start);
+        if(state == CANVAS_INK)
+            cSent = TERM_PutRun(INK_CHAR, u8_end - u8_start);
+        else
+            cSent = TERM_EraseRun(u8_end - u8_start);
+        if(!cSent)
+            CANVAS_MarkDirty(u8_row);
+        u8_lastRow = u8_row;
+        u8_lastCol = u8_end - 1;
+        if(u8_end > u8_hi)
+            break;
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           STROKE_Line
+//  Description:    Sets the cells from one cursor position to the next, both
+//                  included, and sends those that changed. The terminal 
+//                  cursor is left after the last cell, or moved to the end 
+//                  of the line if that cell was not the last one sent or 
+//                  an ECH left the cursor at the start of its run.
+//      Accepts:    - unsigned char row0:   1-based row of the start
+//                  - unsigned char col0:   1-based column of the start
+//                  - unsigned char row1:   1-based row of the end
+//                  - unsigned char col1:   1-based column of the end
+//                  - char state:           CANVAS_INK or CANVAS_BLANK
+//      Returns:    None
+///////////////////////////////////////////////////////////////////////////////
+void STROKE_Line(unsigned char row0, unsigned char col0, unsigned char row1, unsigned char col1, char state)
+{
+    int iDc = (col1 > col0)? col1 - col0 : col0 - col1;
+    int iDr = (row1 > row0)? row0 - row1 : row1 - row0;     // negative
+    int iErr = iDc + iDr, iErr2;
+    unsigned char u8_row = row0, u8_col = col0;
+    unsigned char u8_runRow = row0, u8_lo = col0, u8_hi = col0;
+    unsigned char u8_termRow, u8_termCol;
+    
+    u8_lastRow = 0;
+    
+    while(u8_row != row1 || u8_col != col1)
+    {
+        iErr2 = 2 * iErr;
+        if(iErr2 >= iDr)
+        {
+            iErr += iDr;
+            u8_col += (col1 > col0)? 1 : -1;
+        }
+        if(iErr2 <= iDc)
+        {
+            iErr += iDc;
+            u8_row += (row1 > row0)? 1 : -1;
+        }
+        
+        // same row: grow the run, else send it and start the next
+        if(u8_row == u8_runRow)
+        {
+            if(u8_col < u8_lo) u8_lo = u8_col;
+            if(u8_col > u8_hi) u8_hi = u8_col;
+        }
+        else
+        {
+            STROKE_Span(u8_runRow, u8_lo, u8_hi, state);
+            u8_runRow = u8_row;
+            u8_lo = u8_col;
+            u8_hi = u8_col;
+        }
+    }
+    STROKE_Span(u8_runRow, u8_lo, u8_hi, state);
+    
+    TERM_Position(&u8_termRow, &u8_termCol);
+    if(u8_lastRow != row1 || u8_lastCol != col1
+       || (u8_termCol != TERM_UNKNOWN && u8_termCol != col1 + 1))
+        TERM_MoveCursor(row1, col1);
+}
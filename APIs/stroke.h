@@ -0,0 +1,19 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+//  Filename:       stroke.h
+//
+//  Description:    Header file for the stroke.c line rasterizer
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef _STROKE_H
+#define _STROKE_H
+
+#include "canvas.h"
+
+///////////////////////////// FUNCTION PROTOTYPES /////////////////////////////
+
+void STROKE_Span(unsigned char u8_row, unsigned char u8_lo, unsigned char u8_hi, char state);
+void STROKE_Line(unsigned char row0, unsigned char col0, unsigned char row1, unsigned char col1, char state);
+
+#endif  // _STROKE_H
@@ -0,0 +1,324 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+//  Filename:       term.c
+//
+//  Description:    
+//  Keeps track of where the terminal's cursor is and moves it with the 
+//  fewest UART bytes. A move to the current position sends nothing; other
+//  moves pick the shortest of relative steps (CUU/CUD/CUF/CUB, reverse index,
+//  backspace, line feed, carriage return) and absolute positioning (CUP), 
+//  e.g. one cell left is a single backspace instead of up to 10 bytes of 
+//  "\033[z;xH". Rows and columns are 1-based as in ANSI; 0 is treated as 1
+//  like the terminal does.
+//
+//  All output that moves the terminal cursor must go through this module,
+//  or TERM_Invalidate() must be called afterwards.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "term.h"
+#include "uart2.h"
+#include "fmt.h"
+#include "XZsensor.h"
+
+// terminal cursor position, TERM_UNKNOWN until the first absolute move
+static unsigned char ucRow = TERM_UNKNOWN, ucCol = TERM_UNKNOWN;
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           vertLen / putVert
+//  Description:    Cheapest relative vertical move by <i16_d> rows, down if
+//                  positive: line feeds, reverse index, CUD or CUU
+///////////////////////////////////////////////////////////////////////////////
+static unsigned int vertLen(int i16_d)
+{
+    unsigned int u16_n = (i16_d < 0)? -i16_d : i16_d;
+    
+    if(i16_d == 0)
+        return(0);
+    if(i16_d < 0)
+        return((u16_n == 1)? 2 : FMT_CsiLen(u16_n));
+    return((u16_n < FMT_CsiLen(u16_n))? u16_n : FMT_CsiLen(u16_n));
+}
+
+static unsigned int putVert(char* pBuff, int i16_d)
+{
+    unsigned int u16_n = (i16_d < 0)? -i16_d : i16_d;
+    unsigned int u16_i;
+    
+    if(i16_d == 0)
+        return(0);
+    
+    if(i16_d < 0)
+    {
+        if(u16_n == 1)
+        {
+            // reverse index, never scrolls as the target row is >= 1
+            pBuff[0] = '\033';
+            pBuff[1] = 'M';
+            return(2);
+        }
+        return(FMT_Csi(pBuff, u16_n, 'A'));
+    }
+    
+    if(u16_n < FMT_CsiLen(u16_n))
+    {
+        for(u16_i = 0; u16_i < u16_n; u16_i++)
+            pBuff[u16_i] = '\n';
+        return(u16_n);
+    }
+    return(FMT_Csi(pBuff, u16_n, 'B'));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           horzLen / putHorz
+//  Description:    Cheapest horizontal move from column <u8_from> to <u8_to>:
+//                  carriage return, backspaces, CUB or CUF
+///////////////////////////////////////////////////////////////////////////////
+static unsigned int horzLen(unsigned char u8_from, unsigned char u8_to)
+{
+    unsigned int u16_n;
+    
+    if(u8_to == u8_from)
+        return(0);
+    if(u8_to == 1)
+        return(1);
+    if(u8_to > u8_from)
+        return(FMT_CsiLen(u8_to - u8_from));
+    
+    u16_n = u8_from - u8_to;
+    return((u16_n <= FMT_CsiLen(u16_n))? u16_n : FMT_CsiLen(u16_n));
+}
+
+static unsigned int putHorz(char* pBuff, unsigned char u8_from, unsigned char u8_to)
+{
+    unsigned int u16_n;
+    unsigned int u16_i;
+    
+    if(u8_to == u8_from)
+        return(0);
+    
+    if(u8_to == 1)
+    {
+        pBuff[0] = '\r';
+        return(1);
+    }
+    
+    if(u8_to > u8_from)
+        return(FMT_Csi(pBuff, u8_to - u8_from, 'C'));
+    
+    u16_n = u8_from - u8_to;
+    if(u16_n <= FMT_CsiLen(u16_n))
+    {
+        for(u16_i = 0; u16_i < u16_n; u16_i++)
+            pBuff[u16_i] = '\b';
+        return(u16_n);
+    }
+    return(FMT_Csi(pBuff, u16_n, 'D'));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           TERM_Invalidate
+//  Description:    Forgets the terminal cursor position, the next move will
+//                  be absolute. Call after any output not made through this
+//                  module, e.g. a clear screen.
+//      Accepts:    None
+//      Returns:    None
+///////////////////////////////////////////////////////////////////////////////
+void TERM_Invalidate(void)
+{
+    ucRow = TERM_UNKNOWN;
+    ucCol = TERM_UNKNOWN;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           TERM_SetPosition
+//  Description:    Records where output built outside this module left the
+//                  terminal cursor. Past the right edge the terminal may 
+//                  wrap, so the position is forgotten.
+//      Accepts:    - unsigned char row:    1-based row
+//                  - unsigned char col:    1-based column
+//      Returns:    None
+///////////////////////////////////////////////////////////////////////////////
+void TERM_SetPosition(unsigned char row, unsigned char col)
+{
+    if(row == 0) row = 1;
+    if(col == 0) col = 1;
+    
+    if(col > SCREEN_W)
+        TERM_Invalidate();
+    else
+    {
+        ucRow = row;
+        ucCol = col;
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           TERM_Position
+//  Description:    Reads where the terminal cursor is
+//      Accepts:    - unsigned char* pRow:  returns the 1-based row
+//                  - unsigned char* pCol:  returns the 1-based column
+//      Returns:    None, both are TERM_UNKNOWN if the position is not known
+///////////////////////////////////////////////////////////////////////////////
+void TERM_Position(unsigned char* pRow, unsigned char* pCol)
+{
+    *pRow = ucRow;
+    *pCol = ucCol;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           TERM_CursorSeq
+//  Description:    Builds the shortest sequence moving the terminal cursor to
+//                  <row>, <col> and records the new position
+//      Accepts:    - char* pBuff:          buffer of at least TERM_SEQ_MAX
+//                  - unsigned char row:    1-based row
+//                  - unsigned char col:    1-based column
+//      Returns:    - unsigned int:         sequence length, 0 if no move
+///////////////////////////////////////////////////////////////////////////////
+unsigned int TERM_CursorSeq(char* pBuff, unsigned char row, unsigned char col)
+{
+    unsigned int u16_n;
+    
+    if(row == 0) row = 1;
+    if(col == 0) col = 1;
+    
+    if(ucRow == TERM_UNKNOWN || ucCol == TERM_UNKNOWN)
+        u16_n = FMT_Cup(pBuff, row, col);
+    else if(vertLen(row - ucRow) + horzLen(ucCol, col) < FMT_CupLen(row, col))
+    {
+        u16_n = putVert(pBuff, row - ucRow);
+        u16_n += putHorz(pBuff + u16_n, ucCol, col);
+    }
+    else
+        u16_n = FMT_Cup(pBuff, row, col);
+    
+    ucRow = row;
+    ucCol = col;
+    return(u16_n);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           TERM_MoveCursor
+//  Description:    Moves the terminal cursor through UART2, sending nothing
+//                  if it is already there
+//      Accepts:    - unsigned char row:    1-based row
+//                  - unsigned char col:    1-based column
+//      Returns:    None
+///////////////////////////////////////////////////////////////////////////////
+void TERM_MoveCursor(unsigned char row, unsigned char col)
+{
+    char seq[TERM_SEQ_MAX];
+    unsigned int u16_n = TERM_CursorSeq(seq, row, col);
+    
+    // a dropped sequence leaves the terminal somewhere else
+    if(u16_n && !outBytes(seq, u16_n))
+        TERM_Invalidate();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           TERM_PutChar
+//  Description:    Prints a character at the cursor, which then advances by
+//                  one column. At the right edge of the canvas the terminal 
+//                  may wrap, so the position is forgotten. Nothing is sent
+//                  while the position is unknown, the character would land
+//                  in an unknown cell.
+//      Accepts:    - char c:   printable character
+//      Returns:    - char:     1 if sent, 0 if not
+///////////////////////////////////////////////////////////////////////////////
+char TERM_PutChar(char c)
+{
+    return(TERM_PutRun(c, 1));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           TERM_PutRun
+//  Description:    Prints a character <u8_n> times from the cursor, as the 
+//                  character and REP when shorter, like TERM_PutChar()
+//      Accepts:    - char c:               printable character
+//                  - unsigned char u8_n:   count
+//      Returns:    - char:                 1 if sent, 0 if not
+///////////////////////////////////////////////////////////////////////////////
+char TERM_PutRun(char c, unsigned char u8_n)
+{
+    char seq[1 + FMT_CSI_MAX];
+    unsigned int u16_left, u16_len;
+    
+    if(ucRow == TERM_UNKNOWN || ucCol == TERM_UNKNOWN)
+        return(0);
+    
+    seq[0] = c;
+#if TERM_USE_REP
+    if(u8_n > 2 && FMT_CsiLen(u8_n - 1) < u8_n - 1)
+    {
+        u16_len = 1 + FMT_Csi(seq + 1, u8_n - 1, 'b');
+        if(!outBytes(seq, u16_len))
+        {
+            TERM_Invalidate();
+            return(0);
+        }
+    }
+    else
+#endif
+    {
+        // plain characters, a buffer at a time
+        for(u16_len = 1; u16_len < sizeof(seq); u16_len++)
+            seq[u16_len] = c;
+        for(u16_left = u8_n; u16_left; u16_left -= u16_len)
+        {
+            u16_len = (u16_left < sizeof(seq))? u16_left : sizeof(seq);
+            if(!outBytes(seq, u16_len))
+            {
+                TERM_Invalidate();
+                return(0);
+            }
+        }
+    }
+    
+    if((unsigned int)ucCol + u8_n > SCREEN_W)
+        TERM_Invalidate();
+    else
+        ucCol += u8_n;
+    return(1);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           TERM_EraseRun
+//  Description:    Blanks <u8_n> cells from the cursor with ECH, which 
+//                  leaves the cursor where it is, or with spaces when they
+//                  are shorter, which advance it as TERM_PutRun() does
+//      Accepts:    - unsigned char u8_n:   count
+//      Returns:    - char:                 1 if sent, 0 if not
+///////////////////////////////////////////////////////////////////////////////
+char TERM_EraseRun(unsigned char u8_n)
+{
+#if TERM_USE_ECH
+    char seq[FMT_CSI_MAX];
+    
+    if(ucRow == TERM_UNKNOWN || ucCol == TERM_UNKNOWN)
+        return(0);
+    
+    if(FMT_CsiLen(u8_n) <= u8_n)
+    {
+        if(!outBytes(seq, FMT_Csi(seq, u8_n, 'X')))
+        {
+            TERM_Invalidate();
+            return(0);
+        }
+        return(1);
+    }
+#endif
+    return(TERM_PutRun(' ', u8_n));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           TERM_PutString
+//  Description:    Sends a string that moves the cursor in ways not tracked
+//                  here (messages, clear screen), the position is forgotten
+//      Accepts:    - const char* psz_s:    string to send
+//      Returns:    None
+///////////////////////////////////////////////////////////////////////////////
+void TERM_PutString(const char* psz_s)
+{
+    outString(psz_s);
+    TERM_Invalidate();
+}
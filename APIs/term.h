@@ -0,0 +1,42 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+//  Filename:       term.h
+//
+//  Description:    Header file for the term.c terminal cursor encoder
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef _TERM_H
+#define _TERM_H
+
+#include "fmt.h"
+
+/////////////////////////////////// MACROS ///////////////////////////////////
+
+// set to 0 for terminals without REP ("\033[<n>b", repeat last character),
+// runs of a character are then sent in full
+#define TERM_USE_REP    1
+
+// set to 0 for terminals without ECH ("\033[<n>X", erase characters), 
+// blanked cells are then overwritten with spaces
+#define TERM_USE_ECH    1
+
+// longest sequence built by TERM_CursorSeq(), "\033[255;255H"
+#define TERM_SEQ_MAX    FMT_CUP_MAX
+
+// marks the terminal cursor position as unknown
+#define TERM_UNKNOWN    0
+
+///////////////////////////// FUNCTION PROTOTYPES /////////////////////////////
+
+void TERM_Invalidate(void);
+void TERM_SetPosition(unsigned char row, unsigned char col);
+void TERM_Position(unsigned char* pRow, unsigned char* pCol);
+unsigned int TERM_CursorSeq(char* pBuff, unsigned char row, unsigned char col);
+void TERM_MoveCursor(unsigned char row, unsigned char col);
+char TERM_PutChar(char c);
+char TERM_PutRun(char c, unsigned char u8_n);
+char TERM_EraseRun(unsigned char u8_n);
+void TERM_PutString(const char* psz_s);
+
+#endif  // _TERM_H
@@ -0,0 +1,115 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+//  Filename:       trace.c
+//
+//  Description:    
+//  Streams raw XZ samples and button states over UART2 in the binary trace
+//  format of trace.h, 4 bytes per sample: 400 bytes/s at 100 Hz, a fifth of
+//  the 19200 baud line. Time is taken from the scheduler tick. A record 
+//  that does not fit in the Tx ring is dropped, the next one carries 
+//  TRACE_F_LOST and the time since the last record sent, so timestamps 
+//  stay exact.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "trace.h"
+#include "uart2.h"
+#include "sched.h"
+
+#if SCHED_TICK_HZ != 1000
+#error "trace timestamps are in scheduler ticks, they must be milliseconds"
+#endif
+
+static char cActive = 0;
+static char cLost = 0;
+static unsigned int u16_recs = 0;       // records since the last magic
+static unsigned int u16_last;           // SCHED_Ticks() of the last record
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           putRecord
+//  Description:    Sends one record, preceded by the magic when it is due
+//      Returns:    1 if sent, 0 if dropped
+///////////////////////////////////////////////////////////////////////////////
+static char putRecord(unsigned char u8_dt, unsigned char x, unsigned char z, unsigned char u8_flags)
+{
+    char rec[TRACE_MAGIC_LEN + TRACE_REC_LEN] = TRACE_MAGIC;
+    unsigned int u16_n = 0;
+    
+    if(u16_recs == 0)
+        u16_n = TRACE_MAGIC_LEN;
+    
+    rec[u16_n++] = u8_dt;
+    rec[u16_n++] = x;
+    rec[u16_n++] = z;
+    rec[u16_n++] = u8_flags | (cLost? TRACE_F_LOST : 0);
+    
+    if(!outBytes(rec, u16_n))
+    {
+        cLost = 1;
+        return(0);
+    }
+    
+    cLost = 0;
+    if(++u16_recs == TRACE_SYNC_RECS)
+        u16_recs = 0;
+    return(1);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           TRACE_Start / TRACE_Stop
+//  Description:    Starts or stops the stream. While it runs nothing else
+//                  may be sent on UART2.
+//      Accepts:    None
+//      Returns:    None
+///////////////////////////////////////////////////////////////////////////////
+void TRACE_Start(void)
+{
+    cActive = 1;
+    cLost = 0;
+    u16_recs = 0;
+    u16_last = SCHED_Ticks();
+}
+
+void TRACE_Stop(void)
+{
+    cActive = 0;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           TRACE_Active
+//  Description:    Tells whether the stream runs
+//      Accepts:    None
+//      Returns:    - char:     1 while streaming
+///////////////////////////////////////////////////////////////////////////////
+char TRACE_Active(void)
+{
+    return(cActive);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           TRACE_Sample
+//  Description:    Records a sample read from the sensor, with gap records
+//                  first if more than 255 ms passed since the last record
+//      Accepts:    - unsigned char x:          X position from XZ sensor
+//                  - unsigned char z:          Z position from XZ sensor
+//                  - unsigned char ucButtons:  HAL_BTN_ bits, pressed now
+//      Returns:    None
+///////////////////////////////////////////////////////////////////////////////
+void TRACE_Sample(unsigned char x, unsigned char z, unsigned char ucButtons)
+{
+    unsigned int u16_now;
+    
+    if(!cActive)
+        return;
+    
+    u16_now = SCHED_Ticks();
+    while((unsigned int)(u16_now - u16_last) > 255)
+    {
+        if(!putRecord(255, 0, 0, TRACE_F_GAP))
+            return;
+        u16_last += 255;
+    }
+    
+    if(putRecord(u16_now - u16_last, x, z, ucButtons & TRACE_F_BUTTONS))
+        u16_last = u16_now;
+}
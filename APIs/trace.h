@@ -0,0 +1,43 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+//  Filename:       trace.h
+//
+//  Description:    Header file for the trace.c raw sample streaming
+//
+//  Trace format, shared with the host replayer (sim/replay.c):
+//      TRACE_MAGIC, then TRACE_REC_LEN byte records
+//          byte 0: milliseconds since the previous record
+//          byte 1: X position from the XZ sensor
+//          byte 2: Z position from the XZ sensor
+//          byte 3: flags, HAL_BTN_ bits of the pressed buttons, TRACE_F_
+//      TRACE_MAGIC is repeated before every TRACE_SYNC_RECS records so a 
+//      capture started in the middle of the stream can be aligned.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef _TRACE_H
+#define _TRACE_H
+
+/////////////////////////////////// MACROS ///////////////////////////////////
+
+#define TRACE_MAGIC         "XZT1"
+#define TRACE_MAGIC_LEN     4
+#define TRACE_REC_LEN       4
+#define TRACE_SYNC_RECS     256
+
+// record flags
+#define TRACE_F_BUTTONS     0x07    // HAL_BTN_ bits
+#define TRACE_F_LOST        0x40    // records were dropped before this one
+#define TRACE_F_GAP         0x80    // no sample, only time passing
+
+// trace streaming command received on UART2, toggles the stream
+#define TRACE_CMD           't'
+
+///////////////////////////// FUNCTION PROTOTYPES /////////////////////////////
+
+void TRACE_Start(void);
+void TRACE_Stop(void);
+char TRACE_Active(void);
+void TRACE_Sample(unsigned char x, unsigned char z, unsigned char ucButtons);
+
+#endif  // _TRACE_H
@@ -15,34 +15,86 @@
 #include "uart2.h"
 #include <xc.h>
 
-// global variables
-char fifoBuffer[FIFO_SIZE];         // software FIFO buffer
+// software Rx FIFO, a single-producer/single-consumer ring: the head is only
+// written by _U2RXInterrupt() and the tail only by the main program, so no
+// interrupt masking is needed. Indices run freely and are masked on use.
+static char fifoBuffer[FIFO_SIZE];
+static volatile unsigned int u16_rxHead = 0, u16_rxTail = 0;
 
-// pointers to head and tail of software FIFO stack
-char* pHead = fifoBuffer, * pTail = fifoBuffer;
+// bytes lost to a full software FIFO or a hardware Rx buffer overrun
+static volatile unsigned long u32_rxOverruns = 0;
+
+// software Tx FIFO, filled by outBytes() and drained by _U2TXInterrupt().
+// Head and tail are free running indices masked on use, the head is only
+// written by the main program and the tail only by the ISR.
+static char txBuffer[TX_FIFO_SIZE];
+static volatile unsigned int u16_txHead = 0, u16_txTail = 0;
+
+// nominal baud rate set by UART2_Initialize() or setBaudUART2()
+static unsigned long u32_baud = UART2_BOOT_BAUD;
+
+// Tx FIFO statistics
+static unsigned int u16_txHighWater = 0;    // max bytes ever queued at once
+static unsigned long u32_txDropped = 0;     // bytes dropped on a full FIFO
 
 ///////////////////////////////////////////////////////////////////////////////
-//  Name:           U2RXInterrupt
-//  Description:    ISR for UART2 Rx Interrupt when a character enters the Rx
-//                  buffer. The character is store in a software FIFO buffer.
+//  Name:           U2TXInterrupt
+//  Description:    ISR for UART2 Tx Interrupt when a character moves from the
+//                  Tx buffer to the shift register. Refills the hardware Tx
+//                  buffer from the software FIFO and disables itself once the
+//                  software FIFO is empty.
 ///////////////////////////////////////////////////////////////////////////////
-void ISR_NO_PSV _U2RXInterrupt()
+void ISR_NO_PSV _U2TXInterrupt()
 {
-    pHead++;            // increment head
+    unsigned int u16_tail = u16_txTail;
     
-    if(pHead >= fifoBuffer + FIFO_SIZE)     //
-        pHead = fifoBuffer;                 // wrap head pointer around buffer
+    // clear UART2 Tx interrupt flag
+    IFS1bits.U2TXIF = 0;
     
-    // print error if new char overruns FIFO stack
-    if(pHead == pTail)
-        outString("\nSOFTWARE FIFO receive buffer overrun error\n");
+    // top up the hardware Tx buffer
+    while(u16_tail != u16_txHead && !U2STAbits.UTXBF)
+    {
+        U2TXREG = txBuffer[u16_tail & (TX_FIFO_SIZE - 1)];
+        u16_tail++;
+    }
+    u16_txTail = u16_tail;
     
-    // save data in U2RXREG into FIFO buffer pointed by pHead
-    else
-        *pHead = U2RXREG;
+    // nothing left to send, wait for the next outBytes()
+    if(u16_tail == u16_txHead)
+        IEC1bits.U2TXIE = 0;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           U2RXInterrupt
+//  Description:    ISR for UART2 Rx Interrupt when a character enters the Rx
+//                  buffer. Every character waiting in the hardware Rx buffer
+//                  is stored in the software FIFO; characters that do not fit
+//                  are discarded and counted as overruns.
+///////////////////////////////////////////////////////////////////////////////
+void ISR_NO_PSV _U2RXInterrupt()
+{
+    unsigned int u16_head = u16_rxHead;
+    char c;
     
     // clear UART2 Rx interrupt flag
     IFS1bits.U2RXIF = 0;
+    
+    while(U2STAbits.URXDA)
+    {
+        c = U2RXREG;
+        
+        if(u16_head - u16_rxTail >= FIFO_SIZE)
+            u32_rxOverruns++;
+        else
+        {
+            fifoBuffer[u16_head & (FIFO_SIZE - 1)] = c;
+            u16_head++;
+        }
+    }
+    u16_rxHead = u16_head;
+    
+    // reception stops while OERR is set
+    checkRxErrorUART2();
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -54,17 +106,18 @@ void ISR_NO_PSV _U2RXInterrupt()
 void UART2_Initialize(void) 
 {
     // UART2 Mode Register
-    U2MODE = 0x8800;        // bit 15: 1, UART2 Enable bit
+    U2MODE = 0x8808;        // bit 15: 1, UART2 Enable bit
                             // bit 11: 1, U2RTS pin in simplex mode
-                            // bit  3: 0, BRG generates 16 clocks/bit period
+                            // bit  3: 1, BRG generates 4 clocks/bit period
                             // bit <2:1>: 00, 8-bit data, no parity
                             // bit  0: 0, one stop bit
     
     // UART2 Status and Control Register
     U2STA = 0x0000;         // clear register / reset settings
  
-	// Set up your BRG register for Baud Rate = 19200
-    U2BRG = 51;
+	// Set up your BRG register for Baud Rate = 19200, 207 in high-speed mode
+    U2BRG = UART2_BRG(UART2_BOOT_BAUD);
+    u32_baud = UART2_BOOT_BAUD;
 
 	// clear transmit buffer 
     U2TXREG = 0x0000;
@@ -72,6 +125,13 @@ void UART2_Initialize(void)
 	// enable UART2 transmission 
     U2STAbits.UTXEN = 1;
     
+    // Tx interrupt when a character is transferred to the shift register,
+    // enabled by outBytes() only while the software Tx FIFO holds data
+    U2STAbits.UTXISEL1 = 0;
+    U2STAbits.UTXISEL0 = 0;
+    IEC1bits.U2TXIE = 0;
+    u16_txHead = u16_txTail = 0;
+    
     // interrupt flag set when any character is in the Rx buffer
     U2STAbits.URXISEL = 0;
     
@@ -82,53 +142,166 @@ void UART2_Initialize(void)
     IEC1bits.U2RXIE = 1;
 }
 
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           setBaudUART2 / baudUART2
+//  Description:    Changes or reads the baud rate. A character still being 
+//                  sent is garbled by the change, wait for txIdleUART2() 
+//                  first. Rates off by more than UART2_ERROR_MAX are only
+//                  good for a peer with the same error.
+//      Accepts:    - unsigned long u32_rate:   new rate in bits per second
+//      Returns:    - unsigned long:            baudUART2(), the nominal rate
+///////////////////////////////////////////////////////////////////////////////
+void setBaudUART2(unsigned long u32_rate)
+{
+    U2BRG = (unsigned int)UART2_BRG(u32_rate);
+    u32_baud = u32_rate;
+}
+
+unsigned long baudUART2(void)
+{
+    return(u32_baud);
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 //  Name:           outChar
-//  Description:    Transmits a byte of data using UART2 module
+//  Description:    Queues a byte of data for transmission by UART2 module
 //      Accepts:    - unsigned char c:  character to transmit
 //      Returns:    None
 ///////////////////////////////////////////////////////////////////////////////
 void outChar(unsigned char c)
 {
-    while (U2STAbits.UTXBF);        // wait if Tx buffer is full
-    U2TXREG = c;                    // send byte
+    outBytes((const char*)&c, 1);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           outBytes
+//  Description:    Copies a block of bytes into the software Tx FIFO and
+//                  returns without waiting for transmission. A block that 
+//                  does not fit is dropped whole and counted, so a partial
+//                  escape sequence never reaches the terminal.
+//      Accepts:    - const char* pc_data:      bytes to transmit
+//                  - unsigned int u16_cnt:     number of bytes
+//      Returns:    - unsigned int:             bytes queued, 0 or u16_cnt
+///////////////////////////////////////////////////////////////////////////////
+unsigned int outBytes(const char* pc_data, unsigned int u16_cnt)
+{
+    unsigned int u16_head = u16_txHead;
+    unsigned int u16_used = u16_head - u16_txTail;
+    unsigned int u16_i;
+    
+    if(u16_cnt > TX_FIFO_SIZE - u16_used)
+    {
+        u32_txDropped += u16_cnt;
+        return(0);
+    }
+    
+    for(u16_i = 0; u16_i < u16_cnt; u16_i++)
+    {
+        txBuffer[u16_head & (TX_FIFO_SIZE - 1)] = pc_data[u16_i];
+        u16_head++;
+    }
+    u16_txHead = u16_head;
+    
+    u16_used += u16_cnt;
+    if(u16_used > u16_txHighWater)
+        u16_txHighWater = u16_used;
+    
+    // (re)start the ISR, setting the flag makes it run at once if the 
+    // hardware Tx buffer has room
+    if(!IEC1bits.U2TXIE)
+    {
+        IEC1bits.U2TXIE = 1;
+        if(!U2STAbits.UTXBF)
+            IFS1bits.U2TXIF = 1;
+    }
+    
+    return(u16_cnt);
 }
 
 ///////////////////////////////////////////////////////////////////////////////
 //  Name:           inChar
-//  Description:    Reads a byte of data from the software FIFO buffer
+//  Description:    Reads a byte of data from the software FIFO buffer, waits
+//                  for one if the FIFO is empty
 //      Accepts:    None
-//      Returns:    - char* pTail   pointer to byte on bottom of FIFO stack
+//      Returns:    - unsigned char c:  oldest byte in the FIFO
 ///////////////////////////////////////////////////////////////////////////////
 unsigned char inChar(void)
 {
-	while(pHead == pTail);      // loop while buffer is empty
+    unsigned char c;
     
-    // check for Rx buffer overrun error
-    checkRxErrorUART2();
+	while(u16_rxHead == u16_rxTail) Nop();      // loop while buffer is empty
+    
+    c = fifoBuffer[u16_rxTail & (FIFO_SIZE - 1)];
+    u16_rxTail++;               // release the slot to the ISR
+    
+    return(c);
+}
 
-    pTail++;            // increment tail pointer
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           inBytes
+//  Description:    Copies up to u16_maxCount bytes out of the software FIFO
+//                  without waiting
+//      Accepts:    - char* pc_buff:                buffer for received bytes
+//                  - unsigned int u16_maxCount:    size of pc_buff
+//      Returns:    - unsigned int u16_i:           bytes copied, 0 if empty
+///////////////////////////////////////////////////////////////////////////////
+unsigned int inBytes(char* pc_buff, unsigned int u16_maxCount)
+{
+    unsigned int u16_tail = u16_rxTail;
+    unsigned int u16_cnt = u16_rxHead - u16_tail;
+    unsigned int u16_i;
+    
+    if(u16_cnt > u16_maxCount)
+        u16_cnt = u16_maxCount;
     
-    if(pTail >= fifoBuffer + FIFO_SIZE)     //
-        pTail = fifoBuffer;                 // wrap tail pointer around buffer
+    for(u16_i = 0; u16_i < u16_cnt; u16_i++)
+    {
+        pc_buff[u16_i] = fifoBuffer[u16_tail & (FIFO_SIZE - 1)];
+        u16_tail++;
+    }
+    u16_rxTail = u16_tail;
     
-    return(*pTail);            // Implement return of received data to caller
+    return(u16_i);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           rxCountUART2
+//  Description:    Returns the number of bytes waiting in the software FIFO
+//      Accepts:    None
+//      Returns:    - unsigned int:     bytes available to inChar()/inBytes()
+///////////////////////////////////////////////////////////////////////////////
+unsigned int rxCountUART2(void)
+{
+    return(u16_rxHead - u16_rxTail);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           rxOverrunsUART2
+//  Description:    Returns the number of received bytes lost to overruns of
+//                  the software FIFO or the hardware Rx buffer
+//      Accepts:    None
+//      Returns:    - unsigned long:    lost bytes
+///////////////////////////////////////////////////////////////////////////////
+unsigned long rxOverrunsUART2(void)
+{
+    return(u32_rxOverruns);
 }
 
 ///////////////////////////////////////////////////////////////////////////////
 //  Name:           outString
-//  Description:    Transmits a string using the UART2 module and outChar()
+//  Description:    Queues a string for transmission using outBytes()
 //      Accepts:    - const char* psz_s:    pointer to string
 //      Returns:    None
 ///////////////////////////////////////////////////////////////////////////////
 void outString(const char* psz_s) 
 {
-    // loop until null byte
-    while(*psz_s != '\0')
-    {
-        outChar(*psz_s);        // transmit char
-        psz_s++;                // increment pointer to next char
-    }
+    // find null byte, then queue the whole string at once
+    const char* psz_end = psz_s;
+    
+    while(*psz_end != '\0')
+        psz_end++;
+    
+    outBytes(psz_s, psz_end - psz_s);
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -164,7 +337,8 @@ unsigned int inString(char* psz_buff, unsigned int u16_maxCount) {
 
 ///////////////////////////////////////////////////////////////////////////////
 //  Name:           checkRxErrorUART2
-//  Description:    checks UART2 OERR bit for Rx buffer overrun
+//  Description:    checks UART2 OERR bit for Rx buffer overrun, counts it and
+//                  clears it so reception can resume
 //      Accepts:    None
 //      Returns:    None
 ///////////////////////////////////////////////////////////////////////////////
@@ -176,7 +350,66 @@ void checkRxErrorUART2(void)
         // clear error flag
 		U2STAbits.OERR = 0;
         
-        // error message
-        outString("UART2 receive buffer overrun error\n");
+        // at least one byte was lost
+        u32_rxOverruns++;
     }
-}
\ No newline at end of file
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           txFreeUART2
+//  Description:    Returns the free space in the software Tx FIFO, so bulk
+//                  output can be paced instead of dropped
+//      Accepts:    None
+//      Returns:    - unsigned int:     free bytes
+///////////////////////////////////////////////////////////////////////////////
+unsigned int txFreeUART2(void)
+{
+    return(TX_FIFO_SIZE - (u16_txHead - u16_txTail));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           txFlushUART2
+//  Description:    Waits until the software Tx FIFO and the UART2 transmit
+//                  shift register are empty
+//      Accepts:    None
+//      Returns:    None
+///////////////////////////////////////////////////////////////////////////////
+void txFlushUART2(void)
+{
+    while(u16_txHead != u16_txTail) Nop();
+    while(!U2STAbits.TRMT);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           txIdleUART2
+//  Description:    Tells if the software Tx FIFO and the UART2 transmit 
+//                  shift register are empty, the non-blocking txFlushUART2()
+//      Accepts:    None
+//      Returns:    - char:     1 when everything queued has been sent
+///////////////////////////////////////////////////////////////////////////////
+char txIdleUART2(void)
+{
+    return(u16_txHead == u16_txTail && U2STAbits.TRMT);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           txHighWaterUART2
+//  Description:    Returns the highest software Tx FIFO occupancy seen
+//      Accepts:    None
+//      Returns:    - unsigned int:     high-water mark in bytes
+///////////////////////////////////////////////////////////////////////////////
+unsigned int txHighWaterUART2(void)
+{
+    return(u16_txHighWater);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           txDroppedUART2
+//  Description:    Returns the number of bytes dropped on a full Tx FIFO
+//      Accepts:    None
+//      Returns:    - unsigned long:    dropped bytes
+///////////////////////////////////////////////////////////////////////////////
+unsigned long txDroppedUART2(void)
+{
+    return(u32_txDropped);
+}
@@ -20,19 +20,59 @@
 // use interrupt no_auto_psv attribute to reduce interrupt overhead
 #define ISR_NO_PSV __attribute__((__interrupt__, no_auto_psv))
 
-#define FIFO_SIZE   16      // max software FIFO stack size
+#define FIFO_SIZE       16      // software Rx FIFO size, must be a power of two
+
+#define TX_FIFO_SIZE    256     // software Tx FIFO size, must be a power of two
+
+#if (FIFO_SIZE & (FIFO_SIZE - 1)) || (TX_FIFO_SIZE & (TX_FIFO_SIZE - 1))
+#error "FIFO_SIZE and TX_FIFO_SIZE must be powers of two"
+#endif
 
 #define ONESEC    16000000UL
 
+// BRG value for a baud rate in high-speed mode (BRGH = 1, 4 clocks per bit),
+// rounded to the nearest, and the rate it actually gives
+#define UART2_BRG(baud)         ((ONESEC + 2UL * (baud)) / (4UL * (baud)) - 1)
+#define UART2_ACTUAL(baud)      (ONESEC / (4UL * (UART2_BRG(baud) + 1)))
+
+// error of the actual rate in tenths of a percent, and the largest one a 
+// rate may have to be used, the receiver samples mid bit so the two ends
+// may differ by about 4.5% in all
+#define UART2_ERROR(baud)       ((UART2_ACTUAL(baud) > (baud))? \
+            (UART2_ACTUAL(baud) - (baud)) * 1000UL / (baud) : \
+            ((baud) - UART2_ACTUAL(baud)) * 1000UL / (baud))
+#define UART2_ERROR_MAX         25
+#define UART2_BAUD_OK(baud)     (UART2_BRG(baud) >= 1 && \
+            UART2_ERROR(baud) <= UART2_ERROR_MAX)
+
+// rate after reset, what a plain terminal is set to
+#define UART2_BOOT_BAUD         19200UL
+
+#if !UART2_BAUD_OK(UART2_BOOT_BAUD)
+#error "UART2_BOOT_BAUD is too far off at this Fcy"
+#endif
+
 ///////////////////////////// FUNCTION PROTOTYPES /////////////////////////////
 
 void UART2_Initialize(void);
+void setBaudUART2(unsigned long u32_rate);
+unsigned long baudUART2(void);
 
 unsigned char inChar(void);  
 unsigned int inString(char* psz_buff, unsigned int u16_maxCount);
+unsigned int inBytes(char* pc_buff, unsigned int u16_maxCount);
+unsigned int rxCountUART2(void);
+unsigned long rxOverrunsUART2(void);
 
 void outChar(unsigned char u8_c);
 void outString(const char* psz_s);
+unsigned int outBytes(const char* pc_data, unsigned int u16_cnt);
+
+unsigned int txFreeUART2(void);
+void txFlushUART2(void);
+char txIdleUART2(void);
+unsigned int txHighWaterUART2(void);
+unsigned long txDroppedUART2(void);
 
 void checkRxErrorUART2(void);
 
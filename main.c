@@ -9,82 +9,330 @@
   Section: Included Files
 */
 #include <xc.h>
-#include <stdio.h>
 #include "mcc_generated_files/system.h"
 #include "APIs/XZsensor.h"
 #include "APIs/i2c1.h"
 #include "APIs/uart2.h"
+#include "APIs/sched.h"
+#include "APIs/redraw.h"
+#include "APIs/hal.h"
+#include "APIs/paint.h"
+#include "APIs/trace.h"
+#include "APIs/prof.h"
+#include "APIs/baud.h"
+#include "APIs/button.h"
+#include "APIs/VL6180.h"
+#include "APIs/range.h"
+#include "APIs/brush.h"
+#include "APIs/fill.h"
 
 /*
-                         Main application
+ * Task rates in milliseconds. CURSOR_MS is the cursor update period; the
+ * speed of the cursor comes from the motion model, APIs/motion.h, which 
+ * moves it faster the further the hand is past the dead zone. The button
+ * task debounces every tick, see APIs/button.h, and latches the presses so
+ * a short one is not lost between updates.
+ * In DR mode the sampling task only collects samples read on the DR edge, so
+ * it runs every tick. The command task handles the commands received from
+ * the terminal and sends dirty canvas rows as the UART Tx ring drains.
+ * The range task collects the VL6180 results every tick, like the 
+ * sampling task in DR mode.
+ * Build with PROF_ENABLE=1 to time the stages, see APIs/prof.h.
+ * CURSOR_MS is the period at UART2_BOOT_BAUD; once a faster rate has been
+ * negotiated (see APIs/baud.h) the cursor updates as much more often, at
+ * the same speed in cells per second.
  */
-int main(void)
-{    
-    // InitMsg: string with clearscreen and cursor home commands + Initialization message
-    // txtBuff: char array to hold string to output to Tera Term
-    char InitMsg[32] = "\033[2J\033[HSystem initialized!\n\r";
-    char txtBuff[64] = "";
-    
-    // xCoord: X Position from XZ Sensor
-    // zCoord: Z Position from XZ Sensor
-    // LastX: last X Position from XZ Sensor
-    // LastZ: last Z Position from XZ Sensor
-    // xCursor: cursor X position in Tera Term window, initialized to middle
-    // xCursor: cursor Z position in Tera Term window, initialized to middle
-    unsigned char xCoord = 0, zCoord = 0, LastX, LastZ, xCursor = 92, zCursor = 39;
+#if XZ_DR_MODE
+#define SAMPLE_MS   1
+#else
+#define SAMPLE_MS   100
+#endif
+#define CURSOR_MS   100
+#define BUTTON_MS   1
+#define COMMAND_MS  20
+#define RANGE_MS    1
+
+/*
+ * Third input axis from the VL6180 range sensor, see APIs/range.h: 
+ * RANGE_AXIS_OFF, RANGE_AXIS_PEN or RANGE_AXIS_BRUSH. Both sensors share
+ * I2C1 through its transfer queue, which serves them in turn: a DR burst 
+ * of the XZ sensor waits at most for one VL6180 transfer, never for a 
+ * whole result collection, and no XZ sample is lost.
+ * The bus budget is measured by the simulation at 400 kHz, XZ at 100 Hz
+ * and a range every VL6180_PERIOD_MS, per 100 ms cursor update (as much
+ * less per update at a negotiated baud rate); the summary of
+ *   make sim TUNE="-DRANGE_AXIS=RANGE_AXIS_BRUSH"
+ *   dist/sim/terminal-paint </dev/null >/dev/null
+ * gives the statsI2C1() mean and max transaction time, each sensor's bus
+ * time and their sum. A DR burst waits at most for the max transaction;
+ * on the board the profiler dump ('p' with PROF_ENABLE=1) shows the mean
+ * and max.
+ */
+#ifndef RANGE_AXIS
+#define RANGE_AXIS  RANGE_AXIS_OFF
+#endif
+
+/*
+ * I2C bus speed in kHz. Up to I2C1_KHZ_MAX (1 MHz, Fast-mode Plus) only if
+ * every slave on the bus supports it; the VL6180 stops at 400 kHz.
+ */
+#ifndef I2C_KHZ
+#define I2C_KHZ     400
+#endif
+
+#if RANGE_AXIS != RANGE_AXIS_OFF && I2C_KHZ > 400
+#error "the VL6180 on I2C1 stops at 400 kHz"
+#endif
+
+/*
+ * Application state shared by the tasks
+ */
+// since the last cursor update: S3 pressed, S4 and S5 held, HAL_BTN_ bits
+static unsigned char ucHits = 0;
+
+// the profile table is on the terminal, drawing waits for a repaint
+static char cProfShown = 0;
+
+// scheduler task number of the cursor update
+static int iCursorTask;
+
+// the first cursor update was made and the boot time reported
+static char cBooted = 0;
+
+/*
+ * Sampling task: acquires the newest XZ sensor sample and filters it for
+ * the cursor update
+ */
+static void sampleTask(void)
+{
+    // x-z values from sensor
+    unsigned char xSample, zSample;
     
-    // initialize the device
-    SYSTEM_Initialize();
-    UART2_Initialize();
-    I2C1_Initialize(400);       // I2C baud rate = 400kHz
-    XZ_Initialize();
-//    INT0_Initialize();        // DR pin did not work with interrupt, unused
+#if XZ_DR_MODE
+    // new-sample event from the DR pin burst read
+    if(!XZ_GetSample(&xSample, &zSample))
+        return;
+#else
+    // read x-z values from sensor in one burst
+    PROF_BEGIN(PROF_XZ_READ);
+    readXZcoord(&xSample, &zSample);
+    PROF_END(PROF_XZ_READ);
+#endif
+    
+    // raw sample stream for the host replayer
+    TRACE_Sample(xSample, zSample, BUTTON_Held());
+    PAINT_Sample(xSample, zSample);
+}
+
+/*
+ * Button task: debounces the buttons and latches until the next cursor
+ * update the presses, and S4 and S5 while they are held, which draw or
+ * erase; S3 clears the screen once per press however long it is held
+ */
+static void buttonTask(void)
+{
+    unsigned char ucEvent;
     
-    outString(InitMsg);
+    PROF_BEGIN(PROF_BUTTONS);
+    BUTTON_Step();
+    while((ucEvent = BUTTON_Get()) != 0)
+        if(BUTTON_TYPE(ucEvent) == BUTTON_PRESS)
+            ucHits |= BUTTON_WHICH(ucEvent);
+    ucHits |= BUTTON_Held() & (HAL_BTN_S4 | HAL_BTN_S5);
+    PROF_END(PROF_BUTTONS);
+}
+
+#if RANGE_AXIS != RANGE_AXIS_OFF
+/*
+ * Range task: collects the VL6180 results, see VL6180_Step(), and feeds 
+ * them to the third axis, RANGE_NONE when no valid one came for 
+ * RANGE_LOST_MS
+ */
+static void rangeTask(void)
+{
+    static unsigned int u16_last = 0;
+    unsigned char ucMm;
     
-    while (1)
+    VL6180_Step();
+    if(VL6180_GetRange(&ucMm))
+        u16_last = SCHED_Ticks();
+    else if((unsigned int)(SCHED_Ticks() - u16_last) >= SCHED_MS(RANGE_LOST_MS))
     {
-        // delay to control speed at which cursor moves
-        // FCY = 16000000, delay = FCY/10 = 100ms
-        __delay32(FCY/10);
-        
-        // save previous coordinates
-        LastX = xCoord;
-        LastZ = zCoord;
-        
-        // read x-z values from sensor
-        xCoord = readXcoord();
-        zCoord = readZcoord();
-        
-        // checks cursor movement direction
-        checkDir(LastX, LastZ, xCoord, zCoord, &xCursor, &zCursor);
-        
-        // outputs cursor position to Tera Term window
-        moveCursor(txtBuff, zCursor, xCursor);
-
-        // polls push buttons for action
-        if(!S4) colorPix();         // draw at cursor
-        if(!S5) erasePix();         // erase at cursor
-        if(!S3) clrScr(InitMsg);    // clears the screen and write init message
-        
-        // debugging: displays X-Z positions from XZ sensor
-        // (does not work when outputting cursor position to screen)
-//        sprintf(txtBuff, "\t X position: %3u \t Z position: %3u \t\r", xCoord, zCoord);
-//        outString(txtBuff);
+        u16_last = SCHED_Ticks();
+        ucMm = RANGE_NONE;
     }
+    else
+        return;
+    
+    RANGE_Sample(ucMm);
+}
+#endif
 
-    return 1;
+/*
+ * Sets the cursor update period for the negotiated baud rate
+ */
+static void linkReady(void)
+{
+    unsigned int u16_ms = (unsigned int)(CURSOR_MS * UART2_BOOT_BAUD / baudUART2());
+    
+    if(u16_ms == 0)
+        u16_ms = 1;
+    SCHED_SetPeriod(iCursorTask, SCHED_MS(u16_ms));
+    PAINT_SetPeriod(u16_ms);
+    
+    // paint now rather than at the next period
+    SCHED_Release(iCursorTask);
 }
 
 /*
- * ISR for INT0 interrupt, finally unused in application
+ * Command task: the baud rate negotiation owns the UART until it is over.
+ * REDRAW_CMD received from the terminal repaints the whole 
+ * canvas, e.g. after the window was resized or reconnected; TRACE_CMD 
+ * toggles the raw sample stream, which replaces the drawing until it is 
+ * toggled off and the canvas is repainted; PROF_CMD shows the profile 
+ * table until the next REDRAW_CMD; BRUSH_SHAPE_CMD, BRUSH_BIGGER_CMD and
+ * BRUSH_SMALLER_CMD change the brush; FILL_CMD fills the blank area around
+ * the cursor, sent over the next calls like the repaint
  */
-//void ISR_NO_PSV _INT0Interrupt(void)
-//{
-//    xCoord = ReadByte(X_REG);
-//    zCoord = ReadByte(Z_REG);
-//    IFS0bits.INT0IF = 0;
-//}
+static void commandTask(void)
+{
+    char cmd[BAUD_KEEP];
+    unsigned int i, n;
+    unsigned char ucRow, ucCol;
+    
+    PROF_BEGIN(PROF_COMMAND);
+    if(BAUD_Active())
+    {
+        if(BAUD_Step())
+            linkReady();
+        PROF_END(PROF_COMMAND);
+        return;
+    }
+    
+    // keys typed during the negotiation first
+    n = BAUD_Kept(cmd);
+    if(n == 0)
+        n = inBytes(cmd, sizeof(cmd));
+    for(i = 0; i < n; i++)
+    {
+        if(cmd[i] == REDRAW_CMD)
+        {
+            cProfShown = 0;
+            REDRAW_Start();
+        }
+#if PROF_ENABLE
+        else if(cmd[i] == PROF_CMD && !TRACE_Active())
+        {
+            cProfShown = 1;
+            PROF_DumpStart();
+        }
+#endif
+        else if(cmd[i] == TRACE_CMD && !TRACE_Active())
+        {
+            cProfShown = 0;
+            TRACE_Start();
+        }
+        else if(cmd[i] == TRACE_CMD)
+        {
+            TRACE_Stop();
+            REDRAW_Start();
+        }
+        else if(cmd[i] == BRUSH_SHAPE_CMD)
+            BRUSH_SetShape((BRUSH_Shape() == BRUSH_SQUARE)? BRUSH_ROUND : BRUSH_SQUARE);
+        else if(cmd[i] == BRUSH_BIGGER_CMD)
+            BRUSH_SetSize(BRUSH_Size() + 1);
+        else if(cmd[i] == BRUSH_SMALLER_CMD && BRUSH_Size() > 1)
+            BRUSH_SetSize(BRUSH_Size() - 1);
+        else if(cmd[i] == FILL_CMD)
+        {
+            PAINT_Cursor(&ucRow, &ucCol);
+            FILL_Start(ucRow, ucCol, CANVAS_INK);
+        }
+    }
+    
+#if PROF_ENABLE
+    if(cProfShown)
+        PROF_DumpStep();
+    else
+#endif
+    if(!TRACE_Active())
+    {
+        FILL_Step();
+        REDRAW_Step();
+    }
+    PROF_END(PROF_COMMAND);
+}
 
+/*
+ * Cursor update task: outputs the cursor and performs the button actions at
+ * its position. The first update reports the time since reset, as counted 
+ * by the scheduler from the start of main().
+ */
+static void cursorTask(void)
+{
+#if RANGE_AXIS == RANGE_AXIS_PEN
+    // the hand close over the range sensor draws like S4
+    if(RANGE_PenDown())
+        ucHits |= HAL_BTN_S4;
+#elif RANGE_AXIS == RANGE_AXIS_BRUSH
+    BRUSH_SetSize(RANGE_Brush());
+#endif
+    
+    // the negotiation, the trace stream or the profile table owns the UART
+    if(!BAUD_Active() && !TRACE_Active() && !cProfShown)
+    {
+        PAINT_Frame(ucHits);
+        if(!cBooted)
+        {
+            cBooted = 1;
+            PAINT_ShowBoot(SCHED_Now() / (FCY / 1000000L));
+        }
+    }
+    ucHits = 0;
+}
 
+/*
+                         Main application
+ */
+int main(void)
+{    
+    // Timer1 ticks from here on, to time the boot
+    SCHED_Initialize();
+    
+    // initialize the device
+    SYSTEM_Initialize();
+    PROF_Initialize();
+    UART2_Initialize();
+    I2C1_Initialize(I2C_KHZ);
+    XZ_Initialize();
+    BUTTON_Initialize();
+    
+#if RANGE_AXIS != RANGE_AXIS_OFF
+    // configured with blocking transfers, before the queued ones start
+    initVL6180();
+    VL6180_StartContinuous();
+#endif
+    
+    PAINT_Initialize();
+    
+#if XZ_DR_MODE
+    // coordinates are read on the DR pin (INT0) edge
+    XZ_StartDR();
+#endif
+    
+    // fixed-rate tasks replace the __delay32(FCY/10) frame delay, the CPU
+    // idles between Timer1 ticks
+    SCHED_AddTask(sampleTask, SCHED_MS(SAMPLE_MS));
+    SCHED_AddTask(buttonTask, SCHED_MS(BUTTON_MS));
+    iCursorTask = SCHED_AddTask(cursorTask, SCHED_MS(CURSOR_MS));
+    SCHED_AddTask(commandTask, SCHED_MS(COMMAND_MS));
+#if RANGE_AXIS != RANGE_AXIS_OFF
+    SCHED_AddTask(rangeTask, SCHED_MS(RANGE_MS));
+#endif
+    
+    // propose a faster UART rate, see APIs/baud.h
+    BAUD_Start();
+    SCHED_Run();
 
+    return 1;
+}
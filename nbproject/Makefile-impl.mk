@@ -31,7 +31,7 @@ DEFAULTCONF=default
 CONF=${DEFAULTCONF}
 
 # All Configurations
-ALLCONFS=default 
+ALLCONFS=default release size speed 
 
 
 # build
@@ -46,12 +46,18 @@ ALLCONFS=default
 # clobber
 .clobber-impl: .clobber-pre .depcheck-impl
 	    ${MAKE} SUBPROJECTS=${SUBPROJECTS} CONF=default clean
+	    ${MAKE} SUBPROJECTS=${SUBPROJECTS} CONF=release clean
+	    ${MAKE} SUBPROJECTS=${SUBPROJECTS} CONF=size clean
+	    ${MAKE} SUBPROJECTS=${SUBPROJECTS} CONF=speed clean
 
 
 
 # all
 .all-impl: .all-pre .depcheck-impl
 	    ${MAKE} SUBPROJECTS=${SUBPROJECTS} CONF=default build
+	    ${MAKE} SUBPROJECTS=${SUBPROJECTS} CONF=release build
+	    ${MAKE} SUBPROJECTS=${SUBPROJECTS} CONF=size build
+	    ${MAKE} SUBPROJECTS=${SUBPROJECTS} CONF=speed build
 
 
 
@@ -0,0 +1,552 @@
+#
+# Generated Makefile - do not edit!
+#
+# Edit the Makefile in the project folder instead (../Makefile). Each target
+# has a -pre and a -post target defined where you can add customized code.
+#
+# This makefile implements configuration specific macros and targets.
+
+
+# Include project Makefile
+ifeq "${IGNORE_LOCAL}" "TRUE"
+# do not include local makefile. User is passing all local related variables already
+else
+include Makefile
+# Include makefile containing local settings
+ifeq "$(wildcard nbproject/Makefile-local-size.mk)" "nbproject/Makefile-local-size.mk"
+include nbproject/Makefile-local-size.mk
+endif
+endif
+
+# Environment
+MKDIR=gnumkdir -p
+RM=rm -f 
+MV=mv 
+CP=cp 
+
+# Macros
+CND_CONF=size
+ifeq ($(TYPE_IMAGE), DEBUG_RUN)
+IMAGE_TYPE=debug
+OUTPUT_SUFFIX=elf
+DEBUGGABLE_SUFFIX=elf
+FINAL_IMAGE=dist/${CND_CONF}/${IMAGE_TYPE}/Terminal_Paint.X.${IMAGE_TYPE}.${OUTPUT_SUFFIX}
+else
+IMAGE_TYPE=production
+OUTPUT_SUFFIX=hex
+DEBUGGABLE_SUFFIX=elf
+FINAL_IMAGE=dist/${CND_CONF}/${IMAGE_TYPE}/Terminal_Paint.X.${IMAGE_TYPE}.${OUTPUT_SUFFIX}
+endif
+
+ifeq ($(COMPARE_BUILD), true)
+COMPARISON_BUILD=-mafrlcsj
+else
+COMPARISON_BUILD=
+endif
+
+ifdef SUB_IMAGE_ADDRESS
+SUB_IMAGE_ADDRESS_COMMAND=--image-address $(SUB_IMAGE_ADDRESS)
+else
+SUB_IMAGE_ADDRESS_COMMAND=
+endif
+
+# Object Directory
+OBJECTDIR=build/${CND_CONF}/${IMAGE_TYPE}
+
+# Distribution Directory
+DISTDIR=dist/${CND_CONF}/${IMAGE_TYPE}
+
+# Source Files Quoted if spaced
+SOURCEFILES_QUOTED_IF_SPACED=APIs/i2c1.c APIs/uart2.c APIs/XZsensor.c APIs/sched.c APIs/term.c APIs/canvas.c APIs/redraw.c APIs/fmt.c APIs/hal.c APIs/paint.c APIs/trace.c APIs/prof.c APIs/motion.c APIs/stroke.c APIs/filter.c APIs/baud.c APIs/button.c APIs/i2cdev.c APIs/VL6180.c APIs/range.c APIs/brush.c APIs/fill.c mcc_generated_files/interrupt_manager.c mcc_generated_files/traps.c mcc_generated_files/pin_manager.c mcc_generated_files/mcc.c mcc_generated_files/clock.c mcc_generated_files/system.c main.c
+
+# Object Files Quoted if spaced
+OBJECTFILES_QUOTED_IF_SPACED=${OBJECTDIR}/APIs/i2c1.o ${OBJECTDIR}/APIs/uart2.o ${OBJECTDIR}/APIs/XZsensor.o ${OBJECTDIR}/APIs/sched.o ${OBJECTDIR}/APIs/term.o ${OBJECTDIR}/APIs/canvas.o ${OBJECTDIR}/APIs/redraw.o ${OBJECTDIR}/APIs/fmt.o ${OBJECTDIR}/APIs/hal.o ${OBJECTDIR}/APIs/paint.o ${OBJECTDIR}/APIs/trace.o ${OBJECTDIR}/APIs/prof.o ${OBJECTDIR}/APIs/motion.o ${OBJECTDIR}/APIs/stroke.o ${OBJECTDIR}/APIs/filter.o ${OBJECTDIR}/APIs/baud.o ${OBJECTDIR}/APIs/button.o ${OBJECTDIR}/APIs/i2cdev.o ${OBJECTDIR}/APIs/VL6180.o ${OBJECTDIR}/APIs/range.o ${OBJECTDIR}/APIs/brush.o ${OBJECTDIR}/APIs/fill.o ${OBJECTDIR}/mcc_generated_files/interrupt_manager.o ${OBJECTDIR}/mcc_generated_files/traps.o ${OBJECTDIR}/mcc_generated_files/pin_manager.o ${OBJECTDIR}/mcc_generated_files/mcc.o ${OBJECTDIR}/mcc_generated_files/clock.o ${OBJECTDIR}/mcc_generated_files/system.o ${OBJECTDIR}/main.o
+POSSIBLE_DEPFILES=${OBJECTDIR}/APIs/i2c1.o.d ${OBJECTDIR}/APIs/uart2.o.d ${OBJECTDIR}/APIs/XZsensor.o.d ${OBJECTDIR}/APIs/sched.o.d ${OBJECTDIR}/APIs/term.o.d ${OBJECTDIR}/APIs/canvas.o.d ${OBJECTDIR}/APIs/redraw.o.d ${OBJECTDIR}/APIs/fmt.o.d ${OBJECTDIR}/APIs/hal.o.d ${OBJECTDIR}/APIs/paint.o.d ${OBJECTDIR}/APIs/trace.o.d ${OBJECTDIR}/APIs/prof.o.d ${OBJECTDIR}/APIs/motion.o.d ${OBJECTDIR}/APIs/stroke.o.d ${OBJECTDIR}/APIs/filter.o.d ${OBJECTDIR}/APIs/baud.o.d ${OBJECTDIR}/APIs/button.o.d ${OBJECTDIR}/APIs/i2cdev.o.d ${OBJECTDIR}/APIs/VL6180.o.d ${OBJECTDIR}/APIs/range.o.d ${OBJECTDIR}/APIs/brush.o.d ${OBJECTDIR}/APIs/fill.o.d ${OBJECTDIR}/mcc_generated_files/interrupt_manager.o.d ${OBJECTDIR}/mcc_generated_files/traps.o.d ${OBJECTDIR}/mcc_generated_files/pin_manager.o.d ${OBJECTDIR}/mcc_generated_files/mcc.o.d ${OBJECTDIR}/mcc_generated_files/clock.o.d ${OBJECTDIR}/mcc_generated_files/system.o.d ${OBJECTDIR}/main.o.d
+
+# Object Files
+OBJECTFILES=${OBJECTDIR}/APIs/i2c1.o ${OBJECTDIR}/APIs/uart2.o ${OBJECTDIR}/APIs/XZsensor.o ${OBJECTDIR}/APIs/sched.o ${OBJECTDIR}/APIs/term.o ${OBJECTDIR}/APIs/canvas.o ${OBJECTDIR}/APIs/redraw.o ${OBJECTDIR}/APIs/fmt.o ${OBJECTDIR}/APIs/hal.o ${OBJECTDIR}/APIs/paint.o ${OBJECTDIR}/APIs/trace.o ${OBJECTDIR}/APIs/prof.o ${OBJECTDIR}/APIs/motion.o ${OBJECTDIR}/APIs/stroke.o ${OBJECTDIR}/APIs/filter.o ${OBJECTDIR}/APIs/baud.o ${OBJECTDIR}/APIs/button.o ${OBJECTDIR}/APIs/i2cdev.o ${OBJECTDIR}/APIs/VL6180.o ${OBJECTDIR}/APIs/range.o ${OBJECTDIR}/APIs/brush.o ${OBJECTDIR}/APIs/fill.o ${OBJECTDIR}/mcc_generated_files/interrupt_manager.o ${OBJECTDIR}/mcc_generated_files/traps.o ${OBJECTDIR}/mcc_generated_files/pin_manager.o ${OBJECTDIR}/mcc_generated_files/mcc.o ${OBJECTDIR}/mcc_generated_files/clock.o ${OBJECTDIR}/mcc_generated_files/system.o ${OBJECTDIR}/main.o
+
+# Source Files
+SOURCEFILES=APIs/i2c1.c APIs/uart2.c APIs/XZsensor.c APIs/sched.c APIs/term.c APIs/canvas.c APIs/redraw.c APIs/fmt.c APIs/hal.c APIs/paint.c APIs/trace.c APIs/prof.c APIs/motion.c APIs/stroke.c APIs/filter.c APIs/baud.c APIs/button.c APIs/i2cdev.c APIs/VL6180.c APIs/range.c APIs/brush.c APIs/fill.c mcc_generated_files/interrupt_manager.c mcc_generated_files/traps.c mcc_generated_files/pin_manager.c mcc_generated_files/mcc.c mcc_generated_files/clock.c mcc_generated_files/system.c main.c
+
+
+CFLAGS=
+ASFLAGS=
+LDLIBSOPTIONS=
+
+############# Tool locations ##########################################
+# If you copy a project from one host to another, the path where the  #
+# compiler is installed may be different.                             #
+# If you open this project with MPLAB X in the new host, this         #
+# makefile will be regenerated and the paths will be corrected.       #
+#######################################################################
+# fixDeps replaces a bunch of sed/cat/printf statements that slow down the build
+FIXDEPS=fixDeps
+
+.build-conf:  ${BUILD_SUBPROJECTS}
+ifneq ($(INFORMATION_MESSAGE), )
+	@echo $(INFORMATION_MESSAGE)
+endif
+	${MAKE}  -f nbproject/Makefile-size.mk dist/${CND_CONF}/${IMAGE_TYPE}/Terminal_Paint.X.${IMAGE_TYPE}.${OUTPUT_SUFFIX}
+
+MP_PROCESSOR_OPTION=24FJ128GA010
+MP_LINKER_FILE_OPTION=,--script=p24FJ128GA010.gld
+# ------------------------------------------------------------------------------------
+# Rules for buildStep: compile
+ifeq ($(TYPE_IMAGE), DEBUG_RUN)
+${OBJECTDIR}/APIs/i2c1.o: APIs/i2c1.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/APIs" 
+	@${RM} ${OBJECTDIR}/APIs/i2c1.o.d 
+	@${RM} ${OBJECTDIR}/APIs/i2c1.o 
+	${MP_CC} $(MP_EXTRA_CC_PRE)  APIs/i2c1.c  -o ${OBJECTDIR}/APIs/i2c1.o  -c -mcpu=$(MP_PROCESSOR_OPTION)  -MMD -MF "${OBJECTDIR}/APIs/i2c1.o.d"      -g -D__DEBUG -D__MPLAB_DEBUGGER_ICD3=1    -omf=elf -DXPRJ_size=$(CND_CONF)  -legacy-libc  $(COMPARISON_BUILD)  -Os -ffunction-sections -fdata-sections -msmart-io=1 -Wall -msfr-warn=off  
+	@${FIXDEPS} "${OBJECTDIR}/APIs/i2c1.o.d" $(SILENT)  -rsi ${MP_CC_DIR}../ 
+	
+${OBJECTDIR}/APIs/uart2.o: APIs/uart2.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/APIs" 
+	@${RM} ${OBJECTDIR}/APIs/uart2.o.d 
+	@${RM} ${OBJECTDIR}/APIs/uart2.o 
+	${MP_CC} $(MP_EXTRA_CC_PRE)  APIs/uart2.c  -o ${OBJECTDIR}/APIs/uart2.o  -c -mcpu=$(MP_PROCESSOR_OPTION)  -MMD -MF "${OBJECTDIR}/APIs/uart2.o.d"      -g -D__DEBUG -D__MPLAB_DEBUGGER_ICD3=1    -omf=elf -DXPRJ_size=$(CND_CONF)  -legacy-libc  $(COMPARISON_BUILD)  -Os -ffunction-sections -fdata-sections -msmart-io=1 -Wall -msfr-warn=off  
+	@${FIXDEPS} "${OBJECTDIR}/APIs/uart2.o.d" $(SILENT)  -rsi ${MP_CC_DIR}../ 
+	
+${OBJECTDIR}/APIs/XZsensor.o: APIs/XZsensor.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/APIs" 
+	@${RM} ${OBJECTDIR}/APIs/XZsensor.o.d 
+	@${RM} ${OBJECTDIR}/APIs/XZsensor.o 
+	${MP_CC} $(MP_EXTRA_CC_PRE)  APIs/XZsensor.c  -o ${OBJECTDIR}/APIs/XZsensor.o  -c -mcpu=$(MP_PROCESSOR_OPTION)  -MMD -MF "${OBJECTDIR}/APIs/XZsensor.o.d"      -g -D__DEBUG -D__MPLAB_DEBUGGER_ICD3=1    -omf=elf -DXPRJ_size=$(CND_CONF)  -legacy-libc  $(COMPARISON_BUILD)  -Os -ffunction-sections -fdata-sections -msmart-io=1 -Wall -msfr-warn=off  
+	@${FIXDEPS} "${OBJECTDIR}/APIs/XZsensor.o.d" $(SILENT)  -rsi ${MP_CC_DIR}../ 
+	
+${OBJECTDIR}/APIs/sched.o: APIs/sched.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/APIs" 
+	@${RM} ${OBJECTDIR}/APIs/sched.o.d 
+	@${RM} ${OBJECTDIR}/APIs/sched.o 
+	${MP_CC} $(MP_EXTRA_CC_PRE)  APIs/sched.c  -o ${OBJECTDIR}/APIs/sched.o  -c -mcpu=$(MP_PROCESSOR_OPTION)  -MMD -MF "${OBJECTDIR}/APIs/sched.o.d"      -g -D__DEBUG -D__MPLAB_DEBUGGER_ICD3=1    -omf=elf -DXPRJ_size=$(CND_CONF)  -legacy-libc  $(COMPARISON_BUILD)  -Os -ffunction-sections -fdata-sections -msmart-io=1 -Wall -msfr-warn=off  
+	@${FIXDEPS} "${OBJECTDIR}/APIs/sched.o.d" $(SILENT)  -rsi ${MP_CC_DIR}../ 
+	
+${OBJECTDIR}/APIs/term.o: APIs/term.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/APIs" 
+	@${RM} ${OBJECTDIR}/APIs/term.o.d 
+	@${RM} ${OBJECTDIR}/APIs/term.o 
+	${MP_CC} $(MP_EXTRA_CC_PRE)  APIs/term.c  -o ${OBJECTDIR}/APIs/term.o  -c -mcpu=$(MP_PROCESSOR_OPTION)  -MMD -MF "${OBJECTDIR}/APIs/term.o.d"      -g -D__DEBUG -D__MPLAB_DEBUGGER_ICD3=1    -omf=elf -DXPRJ_size=$(CND_CONF)  -legacy-libc  $(COMPARISON_BUILD)  -Os -ffunction-sections -fdata-sections -msmart-io=1 -Wall -msfr-warn=off  
+	@${FIXDEPS} "${OBJECTDIR}/APIs/term.o.d" $(SILENT)  -rsi ${MP_CC_DIR}../ 
+	
+${OBJECTDIR}/APIs/canvas.o: APIs/canvas.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/APIs" 
+	@${RM} ${OBJECTDIR}/APIs/canvas.o.d 
+	@${RM} ${OBJECTDIR}/APIs/canvas.o 
+	${MP_CC} $(MP_EXTRA_CC_PRE)  APIs/canvas.c  -o ${OBJECTDIR}/APIs/canvas.o  -c -mcpu=$(MP_PROCESSOR_OPTION)  -MMD -MF "${OBJECTDIR}/APIs/canvas.o.d"      -g -D__DEBUG -D__MPLAB_DEBUGGER_ICD3=1    -omf=elf -DXPRJ_size=$(CND_CONF)  -legacy-libc  $(COMPARISON_BUILD)  -Os -ffunction-sections -fdata-sections -msmart-io=1 -Wall -msfr-warn=off  
+	@${FIXDEPS} "${OBJECTDIR}/APIs/canvas.o.d" $(SILENT)  -rsi ${MP_CC_DIR}../ 
+	
+${OBJECTDIR}/APIs/redraw.o: APIs/redraw.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/APIs" 
+	@${RM} ${OBJECTDIR}/APIs/redraw.o.d 
+	@${RM} ${OBJECTDIR}/APIs/redraw.o 
+	${MP_CC} $(MP_EXTRA_CC_PRE)  APIs/redraw.c  -o ${OBJECTDIR}/APIs/redraw.o  -c -mcpu=$(MP_PROCESSOR_OPTION)  -MMD -MF "${OBJECTDIR}/APIs/redraw.o.d"      -g -D__DEBUG -D__MPLAB_DEBUGGER_ICD3=1    -omf=elf -DXPRJ_size=$(CND_CONF)  -legacy-libc  $(COMPARISON_BUILD)  -Os -ffunction-sections -fdata-sections -msmart-io=1 -Wall -msfr-warn=off  
+	@${FIXDEPS} "${OBJECTDIR}/APIs/redraw.o.d" $(SILENT)  -rsi ${MP_CC_DIR}../ 
+	
+${OBJECTDIR}/APIs/fmt.o: APIs/fmt.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/APIs" 
+	@${RM} ${OBJECTDIR}/APIs/fmt.o.d 
+	@${RM} ${OBJECTDIR}/APIs/fmt.o 
+	${MP_CC} $(MP_EXTRA_CC_PRE)  APIs/fmt.c  -o ${OBJECTDIR}/APIs/fmt.o  -c -mcpu=$(MP_PROCESSOR_OPTION)  -MMD -MF "${OBJECTDIR}/APIs/fmt.o.d"      -g -D__DEBUG -D__MPLAB_DEBUGGER_ICD3=1    -omf=elf -DXPRJ_size=$(CND_CONF)  -legacy-libc  $(COMPARISON_BUILD)  -Os -ffunction-sections -fdata-sections -msmart-io=1 -Wall -msfr-warn=off  
+	@${FIXDEPS} "${OBJECTDIR}/APIs/fmt.o.d" $(SILENT)  -rsi ${MP_CC_DIR}../ 
+	
+${OBJECTDIR}/APIs/hal.o: APIs/hal.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/APIs" 
+	@${RM} ${OBJECTDIR}/APIs/hal.o.d 
+	@${RM} ${OBJECTDIR}/APIs/hal.o 
+	${MP_CC} $(MP_EXTRA_CC_PRE)  APIs/hal.c  -o ${OBJECTDIR}/APIs/hal.o  -c -mcpu=$(MP_PROCESSOR_OPTION)  -MMD -MF "${OBJECTDIR}/APIs/hal.o.d"      -g -D__DEBUG -D__MPLAB_DEBUGGER_ICD3=1    -omf=elf -DXPRJ_size=$(CND_CONF)  -legacy-libc  $(COMPARISON_BUILD)  -Os -ffunction-sections -fdata-sections -msmart-io=1 -Wall -msfr-warn=off  
+	@${FIXDEPS} "${OBJECTDIR}/APIs/hal.o.d" $(SILENT)  -rsi ${MP_CC_DIR}../ 
+	
+${OBJECTDIR}/APIs/paint.o: APIs/paint.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/APIs" 
+	@${RM} ${OBJECTDIR}/APIs/paint.o.d 
+	@${RM} ${OBJECTDIR}/APIs/paint.o 
+	${MP_CC} $(MP_EXTRA_CC_PRE)  APIs/paint.c  -o ${OBJECTDIR}/APIs/paint.o  -c -mcpu=$(MP_PROCESSOR_OPTION)  -MMD -MF "${OBJECTDIR}/APIs/paint.o.d"      -g -D__DEBUG -D__MPLAB_DEBUGGER_ICD3=1    -omf=elf -DXPRJ_size=$(CND_CONF)  -legacy-libc  $(COMPARISON_BUILD)  -Os -ffunction-sections -fdata-sections -msmart-io=1 -Wall -msfr-warn=off  
+	@${FIXDEPS} "${OBJECTDIR}/APIs/paint.o.d" $(SILENT)  -rsi ${MP_CC_DIR}../ 
+	
+${OBJECTDIR}/APIs/trace.o: APIs/trace.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/APIs" 
+	@${RM} ${OBJECTDIR}/APIs/trace.o.d 
+	@${RM} ${OBJECTDIR}/APIs/trace.o 
+	${MP_CC} $(MP_EXTRA_CC_PRE)  APIs/trace.c  -o ${OBJECTDIR}/APIs/trace.o  -c -mcpu=$(MP_PROCESSOR_OPTION)  -MMD -MF "${OBJECTDIR}/APIs/trace.o.d"      -g -D__DEBUG -D__MPLAB_DEBUGGER_ICD3=1    -omf=elf -DXPRJ_size=$(CND_CONF)  -legacy-libc  $(COMPARISON_BUILD)  -Os -ffunction-sections -fdata-sections -msmart-io=1 -Wall -msfr-warn=off  
+	@${FIXDEPS} "${OBJECTDIR}/APIs/trace.o.d" $(SILENT)  -rsi ${MP_CC_DIR}../ 
+	
+${OBJECTDIR}/APIs/prof.o: APIs/prof.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/APIs" 
+	@${RM} ${OBJECTDIR}/APIs/prof.o.d 
+	@${RM} ${OBJECTDIR}/APIs/prof.o 
+	${MP_CC} $(MP_EXTRA_CC_PRE)  APIs/prof.c  -o ${OBJECTDIR}/APIs/prof.o  -c -mcpu=$(MP_PROCESSOR_OPTION)  -MMD -MF "${OBJECTDIR}/APIs/prof.o.d"      -g -D__DEBUG -D__MPLAB_DEBUGGER_ICD3=1    -omf=elf -DXPRJ_size=$(CND_CONF)  -legacy-libc  $(COMPARISON_BUILD)  -Os -ffunction-sections -fdata-sections -msmart-io=1 -Wall -msfr-warn=off  
+	@${FIXDEPS} "${OBJECTDIR}/APIs/prof.o.d" $(SILENT)  -rsi ${MP_CC_DIR}../ 
+	
+${OBJECTDIR}/APIs/motion.o: APIs/motion.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/APIs" 
+	@${RM} ${OBJECTDIR}/APIs/motion.o.d 
+	@${RM} ${OBJECTDIR}/APIs/motion.o 
+	${MP_CC} $(MP_EXTRA_CC_PRE)  APIs/motion.c  -o ${OBJECTDIR}/APIs/motion.o  -c -mcpu=$(MP_PROCESSOR_OPTION)  -MMD -MF "${OBJECTDIR}/APIs/motion.o.d"      -g -D__DEBUG -D__MPLAB_DEBUGGER_ICD3=1    -omf=elf -DXPRJ_size=$(CND_CONF)  -legacy-libc  $(COMPARISON_BUILD)  -Os -ffunction-sections -fdata-sections -msmart-io=1 -Wall -msfr-warn=off  
+	@${FIXDEPS} "${OBJECTDIR}/APIs/motion.o.d" $(SILENT)  -rsi ${MP_CC_DIR}../ 
+	
+${OBJECTDIR}/APIs/stroke.o: APIs/stroke.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/APIs" 
+	@${RM} ${OBJECTDIR}/APIs/stroke.o.d 
+	@${RM} ${OBJECTDIR}/APIs/stroke.o 
+	${MP_CC} $(MP_EXTRA_CC_PRE)  APIs/stroke.c  -o ${OBJECTDIR}/APIs/stroke.o  -c -mcpu=$(MP_PROCESSOR_OPTION)  -MMD -MF "${OBJECTDIR}/APIs/stroke.o.d"      -g -D__DEBUG -D__MPLAB_DEBUGGER_ICD3=1    -omf=elf -DXPRJ_size=$(CND_CONF)  -legacy-libc  $(COMPARISON_BUILD)  -Os -ffunction-sections -fdata-sections -msmart-io=1 -Wall -msfr-warn=off  
+	@${FIXDEPS} "${OBJECTDIR}/APIs/stroke.o.d" $(SILENT)  -rsi ${MP_CC_DIR}../ 
+	
+${OBJECTDIR}/APIs/filter.o: APIs/filter.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/APIs" 
+	@${RM} ${OBJECTDIR}/APIs/filter.o.d 
+	@${RM} ${OBJECTDIR}/APIs/filter.o 
+	${MP_CC} $(MP_EXTRA_CC_PRE)  APIs/filter.c  -o ${OBJECTDIR}/APIs/filter.o  -c -mcpu=$(MP_PROCESSOR_OPTION)  -MMD -MF "${OBJECTDIR}/APIs/filter.o.d"      -g -D__DEBUG -D__MPLAB_DEBUGGER_ICD3=1    -omf=elf -DXPRJ_size=$(CND_CONF)  -legacy-libc  $(COMPARISON_BUILD)  -Os -ffunction-sections -fdata-sections -msmart-io=1 -Wall -msfr-warn=off  
+	@${FIXDEPS} "${OBJECTDIR}/APIs/filter.o.d" $(SILENT)  -rsi ${MP_CC_DIR}../ 
+	
+${OBJECTDIR}/APIs/baud.o: APIs/baud.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/APIs" 
+	@${RM} ${OBJECTDIR}/APIs/baud.o.d 
+	@${RM} ${OBJECTDIR}/APIs/baud.o 
+	${MP_CC} $(MP_EXTRA_CC_PRE)  APIs/baud.c  -o ${OBJECTDIR}/APIs/baud.o  -c -mcpu=$(MP_PROCESSOR_OPTION)  -MMD -MF "${OBJECTDIR}/APIs/baud.o.d"      -g -D__DEBUG -D__MPLAB_DEBUGGER_ICD3=1    -omf=elf -DXPRJ_size=$(CND_CONF)  -legacy-libc  $(COMPARISON_BUILD)  -Os -ffunction-sections -fdata-sections -msmart-io=1 -Wall -msfr-warn=off  
+	@${FIXDEPS} "${OBJECTDIR}/APIs/baud.o.d" $(SILENT)  -rsi ${MP_CC_DIR}../ 
+	
+${OBJECTDIR}/APIs/button.o: APIs/button.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/APIs" 
+	@${RM} ${OBJECTDIR}/APIs/button.o.d 
+	@${RM} ${OBJECTDIR}/APIs/button.o 
+	${MP_CC} $(MP_EXTRA_CC_PRE)  APIs/button.c  -o ${OBJECTDIR}/APIs/button.o  -c -mcpu=$(MP_PROCESSOR_OPTION)  -MMD -MF "${OBJECTDIR}/APIs/button.o.d"      -g -D__DEBUG -D__MPLAB_DEBUGGER_ICD3=1    -omf=elf -DXPRJ_size=$(CND_CONF)  -legacy-libc  $(COMPARISON_BUILD)  -Os -ffunction-sections -fdata-sections -msmart-io=1 -Wall -msfr-warn=off  
+	@${FIXDEPS} "${OBJECTDIR}/APIs/button.o.d" $(SILENT)  -rsi ${MP_CC_DIR}../ 
+	
+${OBJECTDIR}/APIs/i2cdev.o: APIs/i2cdev.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/APIs" 
+	@${RM} ${OBJECTDIR}/APIs/i2cdev.o.d 
+	@${RM} ${OBJECTDIR}/APIs/i2cdev.o 
+	${MP_CC} $(MP_EXTRA_CC_PRE)  APIs/i2cdev.c  -o ${OBJECTDIR}/APIs/i2cdev.o  -c -mcpu=$(MP_PROCESSOR_OPTION)  -MMD -MF "${OBJECTDIR}/APIs/i2cdev.o.d"      -g -D__DEBUG -D__MPLAB_DEBUGGER_ICD3=1    -omf=elf -DXPRJ_size=$(CND_CONF)  -legacy-libc  $(COMPARISON_BUILD)  -Os -ffunction-sections -fdata-sections -msmart-io=1 -Wall -msfr-warn=off  
+	@${FIXDEPS} "${OBJECTDIR}/APIs/i2cdev.o.d" $(SILENT)  -rsi ${MP_CC_DIR}../ 
+	
+${OBJECTDIR}/APIs/VL6180.o: APIs/VL6180.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/APIs" 
+	@${RM} ${OBJECTDIR}/APIs/VL6180.o.d 
+	@${RM} ${OBJECTDIR}/APIs/VL6180.o 
+	${MP_CC} $(MP_EXTRA_CC_PRE)  APIs/VL6180.c  -o ${OBJECTDIR}/APIs/VL6180.o  -c -mcpu=$(MP_PROCESSOR_OPTION)  -MMD -MF "${OBJECTDIR}/APIs/VL6180.o.d"      -g -D__DEBUG -D__MPLAB_DEBUGGER_ICD3=1    -omf=elf -DXPRJ_size=$(CND_CONF)  -legacy-libc  $(COMPARISON_BUILD)  -Os -ffunction-sections -fdata-sections -msmart-io=1 -Wall -msfr-warn=off  
+	@${FIXDEPS} "${OBJECTDIR}/APIs/VL6180.o.d" $(SILENT)  -rsi ${MP_CC_DIR}../ 
+	
+${OBJECTDIR}/APIs/range.o: APIs/range.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/APIs" 
+	@${RM} ${OBJECTDIR}/APIs/range.o.d 
+	@${RM} ${OBJECTDIR}/APIs/range.o 
+	${MP_CC} $(MP_EXTRA_CC_PRE)  APIs/range.c  -o ${OBJECTDIR}/APIs/range.o  -c -mcpu=$(MP_PROCESSOR_OPTION)  -MMD -MF "${OBJECTDIR}/APIs/range.o.d"      -g -D__DEBUG -D__MPLAB_DEBUGGER_ICD3=1    -omf=elf -DXPRJ_size=$(CND_CONF)  -legacy-libc  $(COMPARISON_BUILD)  -Os -ffunction-sections -fdata-sections -msmart-io=1 -Wall -msfr-warn=off  
+	@${FIXDEPS} "${OBJECTDIR}/APIs/range.o.d" $(SILENT)  -rsi ${MP_CC_DIR}../ 
+	
+${OBJECTDIR}/APIs/brush.o: APIs/brush.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/APIs" 
+	@${RM} ${OBJECTDIR}/APIs/brush.o.d 
+	@${RM} ${OBJECTDIR}/APIs/brush.o 
+	${MP_CC} $(MP_EXTRA_CC_PRE)  APIs/brush.c  -o ${OBJECTDIR}/APIs/brush.o  -c -mcpu=$(MP_PROCESSOR_OPTION)  -MMD -MF "${OBJECTDIR}/APIs/brush.o.d"      -g -D__DEBUG -D__MPLAB_DEBUGGER_ICD3=1    -omf=elf -DXPRJ_size=$(CND_CONF)  -legacy-libc  $(COMPARISON_BUILD)  -Os -ffunction-sections -fdata-sections -msmart-io=1 -Wall -msfr-warn=off  
+	@${FIXDEPS} "${OBJECTDIR}/APIs/brush.o.d" $(SILENT)  -rsi ${MP_CC_DIR}../ 
+	
+${OBJECTDIR}/APIs/fill.o: APIs/fill.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/APIs" 
+	@${RM} ${OBJECTDIR}/APIs/fill.o.d 
+	@${RM} ${OBJECTDIR}/APIs/fill.o 
+	${MP_CC} $(MP_EXTRA_CC_PRE)  APIs/fill.c  -o ${OBJECTDIR}/APIs/fill.o  -c -mcpu=$(MP_PROCESSOR_OPTION)  -MMD -MF "${OBJECTDIR}/APIs/fill.o.d"      -g -D__DEBUG -D__MPLAB_DEBUGGER_ICD3=1    -omf=elf -DXPRJ_size=$(CND_CONF)  -legacy-libc  $(COMPARISON_BUILD)  -Os -ffunction-sections -fdata-sections -msmart-io=1 -Wall -msfr-warn=off  
+	@${FIXDEPS} "${OBJECTDIR}/APIs/fill.o.d" $(SILENT)  -rsi ${MP_CC_DIR}../ 
+	
+${OBJECTDIR}/mcc_generated_files/interrupt_manager.o: mcc_generated_files/interrupt_manager.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/mcc_generated_files" 
+	@${RM} ${OBJECTDIR}/mcc_generated_files/interrupt_manager.o.d 
+	@${RM} ${OBJECTDIR}/mcc_generated_files/interrupt_manager.o 
+	${MP_CC} $(MP_EXTRA_CC_PRE)  mcc_generated_files/interrupt_manager.c  -o ${OBJECTDIR}/mcc_generated_files/interrupt_manager.o  -c -mcpu=$(MP_PROCESSOR_OPTION)  -MMD -MF "${OBJECTDIR}/mcc_generated_files/interrupt_manager.o.d"      -g -D__DEBUG -D__MPLAB_DEBUGGER_ICD3=1    -omf=elf -DXPRJ_size=$(CND_CONF)  -legacy-libc  $(COMPARISON_BUILD)  -Os -ffunction-sections -fdata-sections -msmart-io=1 -Wall -msfr-warn=off  
+	@${FIXDEPS} "${OBJECTDIR}/mcc_generated_files/interrupt_manager.o.d" $(SILENT)  -rsi ${MP_CC_DIR}../ 
+	
+${OBJECTDIR}/mcc_generated_files/traps.o: mcc_generated_files/traps.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/mcc_generated_files" 
+	@${RM} ${OBJECTDIR}/mcc_generated_files/traps.o.d 
+	@${RM} ${OBJECTDIR}/mcc_generated_files/traps.o 
+	${MP_CC} $(MP_EXTRA_CC_PRE)  mcc_generated_files/traps.c  -o ${OBJECTDIR}/mcc_generated_files/traps.o  -c -mcpu=$(MP_PROCESSOR_OPTION)  -MMD -MF "${OBJECTDIR}/mcc_generated_files/traps.o.d"      -g -D__DEBUG -D__MPLAB_DEBUGGER_ICD3=1    -omf=elf -DXPRJ_size=$(CND_CONF)  -legacy-libc  $(COMPARISON_BUILD)  -Os -ffunction-sections -fdata-sections -msmart-io=1 -Wall -msfr-warn=off  
+	@${FIXDEPS} "${OBJECTDIR}/mcc_generated_files/traps.o.d" $(SILENT)  -rsi ${MP_CC_DIR}../ 
+	
+${OBJECTDIR}/mcc_generated_files/pin_manager.o: mcc_generated_files/pin_manager.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/mcc_generated_files" 
+	@${RM} ${OBJECTDIR}/mcc_generated_files/pin_manager.o.d 
+	@${RM} ${OBJECTDIR}/mcc_generated_files/pin_manager.o 
+	${MP_CC} $(MP_EXTRA_CC_PRE)  mcc_generated_files/pin_manager.c  -o ${OBJECTDIR}/mcc_generated_files/pin_manager.o  -c -mcpu=$(MP_PROCESSOR_OPTION)  -MMD -MF "${OBJECTDIR}/mcc_generated_files/pin_manager.o.d"      -g -D__DEBUG -D__MPLAB_DEBUGGER_ICD3=1    -omf=elf -DXPRJ_size=$(CND_CONF)  -legacy-libc  $(COMPARISON_BUILD)  -Os -ffunction-sections -fdata-sections -msmart-io=1 -Wall -msfr-warn=off  
+	@${FIXDEPS} "${OBJECTDIR}/mcc_generated_files/pin_manager.o.d" $(SILENT)  -rsi ${MP_CC_DIR}../ 
+	
+${OBJECTDIR}/mcc_generated_files/mcc.o: mcc_generated_files/mcc.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/mcc_generated_files" 
+	@${RM} ${OBJECTDIR}/mcc_generated_files/mcc.o.d 
+	@${RM} ${OBJECTDIR}/mcc_generated_files/mcc.o 
+	${MP_CC} $(MP_EXTRA_CC_PRE)  mcc_generated_files/mcc.c  -o ${OBJECTDIR}/mcc_generated_files/mcc.o  -c -mcpu=$(MP_PROCESSOR_OPTION)  -MMD -MF "${OBJECTDIR}/mcc_generated_files/mcc.o.d"      -g -D__DEBUG -D__MPLAB_DEBUGGER_ICD3=1    -omf=elf -DXPRJ_size=$(CND_CONF)  -legacy-libc  $(COMPARISON_BUILD)  -Os -ffunction-sections -fdata-sections -msmart-io=1 -Wall -msfr-warn=off  
+	@${FIXDEPS} "${OBJECTDIR}/mcc_generated_files/mcc.o.d" $(SILENT)  -rsi ${MP_CC_DIR}../ 
+	
+${OBJECTDIR}/mcc_generated_files/clock.o: mcc_generated_files/clock.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/mcc_generated_files" 
+	@${RM} ${OBJECTDIR}/mcc_generated_files/clock.o.d 
+	@${RM} ${OBJECTDIR}/mcc_generated_files/clock.o 
+	${MP_CC} $(MP_EXTRA_CC_PRE)  mcc_generated_files/clock.c  -o ${OBJECTDIR}/mcc_generated_files/clock.o  -c -mcpu=$(MP_PROCESSOR_OPTION)  -MMD -MF "${OBJECTDIR}/mcc_generated_files/clock.o.d"      -g -D__DEBUG -D__MPLAB_DEBUGGER_ICD3=1    -omf=elf -DXPRJ_size=$(CND_CONF)  -legacy-libc  $(COMPARISON_BUILD)  -Os -ffunction-sections -fdata-sections -msmart-io=1 -Wall -msfr-warn=off  
+	@${FIXDEPS} "${OBJECTDIR}/mcc_generated_files/clock.o.d" $(SILENT)  -rsi ${MP_CC_DIR}../ 
+	
+${OBJECTDIR}/mcc_generated_files/system.o: mcc_generated_files/system.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/mcc_generated_files" 
+	@${RM} ${OBJECTDIR}/mcc_generated_files/system.o.d 
+	@${RM} ${OBJECTDIR}/mcc_generated_files/system.o 
+	${MP_CC} $(MP_EXTRA_CC_PRE)  mcc_generated_files/system.c  -o ${OBJECTDIR}/mcc_generated_files/system.o  -c -mcpu=$(MP_PROCESSOR_OPTION)  -MMD -MF "${OBJECTDIR}/mcc_generated_files/system.o.d"      -g -D__DEBUG -D__MPLAB_DEBUGGER_ICD3=1    -omf=elf -DXPRJ_size=$(CND_CONF)  -legacy-libc  $(COMPARISON_BUILD)  -Os -ffunction-sections -fdata-sections -msmart-io=1 -Wall -msfr-warn=off  
+	@${FIXDEPS} "${OBJECTDIR}/mcc_generated_files/system.o.d" $(SILENT)  -rsi ${MP_CC_DIR}../ 
+	
+${OBJECTDIR}/main.o: main.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/main.o.d 
+	@${RM} ${OBJECTDIR}/main.o 
+	${MP_CC} $(MP_EXTRA_CC_PRE)  main.c  -o ${OBJECTDIR}/main.o  -c -mcpu=$(MP_PROCESSOR_OPTION)  -MMD -MF "${OBJECTDIR}/main.o.d"      -g -D__DEBUG -D__MPLAB_DEBUGGER_ICD3=1    -omf=elf -DXPRJ_size=$(CND_CONF)  -legacy-libc  $(COMPARISON_BUILD)  -Os -ffunction-sections -fdata-sections -msmart-io=1 -Wall -msfr-warn=off  
+	@${FIXDEPS} "${OBJECTDIR}/main.o.d" $(SILENT)  -rsi ${MP_CC_DIR}../ 
+	
+else
+${OBJECTDIR}/APIs/i2c1.o: APIs/i2c1.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/APIs" 
+	@${RM} ${OBJECTDIR}/APIs/i2c1.o.d 
+	@${RM} ${OBJECTDIR}/APIs/i2c1.o 
+	${MP_CC} $(MP_EXTRA_CC_PRE)  APIs/i2c1.c  -o ${OBJECTDIR}/APIs/i2c1.o  -c -mcpu=$(MP_PROCESSOR_OPTION)  -MMD -MF "${OBJECTDIR}/APIs/i2c1.o.d"        -g -omf=elf -DXPRJ_size=$(CND_CONF)  -legacy-libc  $(COMPARISON_BUILD)  -Os -ffunction-sections -fdata-sections -msmart-io=1 -Wall -msfr-warn=off  
+	@${FIXDEPS} "${OBJECTDIR}/APIs/i2c1.o.d" $(SILENT)  -rsi ${MP_CC_DIR}../ 
+	
+${OBJECTDIR}/APIs/uart2.o: APIs/uart2.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/APIs" 
+	@${RM} ${OBJECTDIR}/APIs/uart2.o.d 
+	@${RM} ${OBJECTDIR}/APIs/uart2.o 
+	${MP_CC} $(MP_EXTRA_CC_PRE)  APIs/uart2.c  -o ${OBJECTDIR}/APIs/uart2.o  -c -mcpu=$(MP_PROCESSOR_OPTION)  -MMD -MF "${OBJECTDIR}/APIs/uart2.o.d"        -g -omf=elf -DXPRJ_size=$(CND_CONF)  -legacy-libc  $(COMPARISON_BUILD)  -Os -ffunction-sections -fdata-sections -msmart-io=1 -Wall -msfr-warn=off  
+	@${FIXDEPS} "${OBJECTDIR}/APIs/uart2.o.d" $(SILENT)  -rsi ${MP_CC_DIR}../ 
+	
+${OBJECTDIR}/APIs/XZsensor.o: APIs/XZsensor.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/APIs" 
+	@${RM} ${OBJECTDIR}/APIs/XZsensor.o.d 
+	@${RM} ${OBJECTDIR}/APIs/XZsensor.o 
+	${MP_CC} $(MP_EXTRA_CC_PRE)  APIs/XZsensor.c  -o ${OBJECTDIR}/APIs/XZsensor.o  -c -mcpu=$(MP_PROCESSOR_OPTION)  -MMD -MF "${OBJECTDIR}/APIs/XZsensor.o.d"        -g -omf=elf -DXPRJ_size=$(CND_CONF)  -legacy-libc  $(COMPARISON_BUILD)  -Os -ffunction-sections -fdata-sections -msmart-io=1 -Wall -msfr-warn=off  
+	@${FIXDEPS} "${OBJECTDIR}/APIs/XZsensor.o.d" $(SILENT)  -rsi ${MP_CC_DIR}../ 
+	
+${OBJECTDIR}/APIs/sched.o: APIs/sched.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/APIs" 
+	@${RM} ${OBJECTDIR}/APIs/sched.o.d 
+	@${RM} ${OBJECTDIR}/APIs/sched.o 
+	${MP_CC} $(MP_EXTRA_CC_PRE)  APIs/sched.c  -o ${OBJECTDIR}/APIs/sched.o  -c -mcpu=$(MP_PROCESSOR_OPTION)  -MMD -MF "${OBJECTDIR}/APIs/sched.o.d"        -g -omf=elf -DXPRJ_size=$(CND_CONF)  -legacy-libc  $(COMPARISON_BUILD)  -Os -ffunction-sections -fdata-sections -msmart-io=1 -Wall -msfr-warn=off  
+	@${FIXDEPS} "${OBJECTDIR}/APIs/sched.o.d" $(SILENT)  -rsi ${MP_CC_DIR}../ 
+	
+${OBJECTDIR}/APIs/term.o: APIs/term.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/APIs" 
+	@${RM} ${OBJECTDIR}/APIs/term.o.d 
+	@${RM} ${OBJECTDIR}/APIs/term.o 
+	${MP_CC} $(MP_EXTRA_CC_PRE)  APIs/term.c  -o ${OBJECTDIR}/APIs/term.o  -c -mcpu=$(MP_PROCESSOR_OPTION)  -MMD -MF "${OBJECTDIR}/APIs/term.o.d"        -g -omf=elf -DXPRJ_size=$(CND_CONF)  -legacy-libc  $(COMPARISON_BUILD)  -Os -ffunction-sections -fdata-sections -msmart-io=1 -Wall -msfr-warn=off  
+	@${FIXDEPS} "${OBJECTDIR}/APIs/term.o.d" $(SILENT)  -rsi ${MP_CC_DIR}../ 
+	
+${OBJECTDIR}/APIs/canvas.o: APIs/canvas.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/APIs" 
+	@${RM} ${OBJECTDIR}/APIs/canvas.o.d 
+	@${RM} ${OBJECTDIR}/APIs/canvas.o 
+	${MP_CC} $(MP_EXTRA_CC_PRE)  APIs/canvas.c  -o ${OBJECTDIR}/APIs/canvas.o  -c -mcpu=$(MP_PROCESSOR_OPTION)  -MMD -MF "${OBJECTDIR}/APIs/canvas.o.d"        -g -omf=elf -DXPRJ_size=$(CND_CONF)  -legacy-libc  $(COMPARISON_BUILD)  -Os -ffunction-sections -fdata-sections -msmart-io=1 -Wall -msfr-warn=off  
+	@${FIXDEPS} "${OBJECTDIR}/APIs/canvas.o.d" $(SILENT)  -rsi ${MP_CC_DIR}../ 
+	
+${OBJECTDIR}/APIs/redraw.o: APIs/redraw.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/APIs" 
+	@${RM} ${OBJECTDIR}/APIs/redraw.o.d 
+	@${RM} ${OBJECTDIR}/APIs/redraw.o 
+	${MP_CC} $(MP_EXTRA_CC_PRE)  APIs/redraw.c  -o ${OBJECTDIR}/APIs/redraw.o  -c -mcpu=$(MP_PROCESSOR_OPTION)  -MMD -MF "${OBJECTDIR}/APIs/redraw.o.d"        -g -omf=elf -DXPRJ_size=$(CND_CONF)  -legacy-libc  $(COMPARISON_BUILD)  -Os -ffunction-sections -fdata-sections -msmart-io=1 -Wall -msfr-warn=off  
+	@${FIXDEPS} "${OBJECTDIR}/APIs/redraw.o.d" $(SILENT)  -rsi ${MP_CC_DIR}../ 
+	
+${OBJECTDIR}/APIs/fmt.o: APIs/fmt.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/APIs" 
+	@${RM} ${OBJECTDIR}/APIs/fmt.o.d 
+	@${RM} ${OBJECTDIR}/APIs/fmt.o 
+	${MP_CC} $(MP_EXTRA_CC_PRE)  APIs/fmt.c  -o ${OBJECTDIR}/APIs/fmt.o  -c -mcpu=$(MP_PROCESSOR_OPTION)  -MMD -MF "${OBJECTDIR}/APIs/fmt.o.d"        -g -omf=elf -DXPRJ_size=$(CND_CONF)  -legacy-libc  $(COMPARISON_BUILD)  -Os -ffunction-sections -fdata-sections -msmart-io=1 -Wall -msfr-warn=off  
+	@${FIXDEPS} "${OBJECTDIR}/APIs/fmt.o.d" $(SILENT)  -rsi ${MP_CC_DIR}../ 
+	
+${OBJECTDIR}/APIs/hal.o: APIs/hal.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/APIs" 
+	@${RM} ${OBJECTDIR}/APIs/hal.o.d 
+	@${RM} ${OBJECTDIR}/APIs/hal.o 
+	${MP_CC} $(MP_EXTRA_CC_PRE)  APIs/hal.c  -o ${OBJECTDIR}/APIs/hal.o  -c -mcpu=$(MP_PROCESSOR_OPTION)  -MMD -MF "${OBJECTDIR}/APIs/hal.o.d"        -g -omf=elf -DXPRJ_size=$(CND_CONF)  -legacy-libc  $(COMPARISON_BUILD)  -Os -ffunction-sections -fdata-sections -msmart-io=1 -Wall -msfr-warn=off  
+	@${FIXDEPS} "${OBJECTDIR}/APIs/hal.o.d" $(SILENT)  -rsi ${MP_CC_DIR}../ 
+	
+${OBJECTDIR}/APIs/paint.o: APIs/paint.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/APIs" 
+	@${RM} ${OBJECTDIR}/APIs/paint.o.d 
+	@${RM} ${OBJECTDIR}/APIs/paint.o 
+	${MP_CC} $(MP_EXTRA_CC_PRE)  APIs/paint.c  -o ${OBJECTDIR}/APIs/paint.o  -c -mcpu=$(MP_PROCESSOR_OPTION)  -MMD -MF "${OBJECTDIR}/APIs/paint.o.d"        -g -omf=elf -DXPRJ_size=$(CND_CONF)  -legacy-libc  $(COMPARISON_BUILD)  -Os -ffunction-sections -fdata-sections -msmart-io=1 -Wall -msfr-warn=off  
+	@${FIXDEPS} "${OBJECTDIR}/APIs/paint.o.d" $(SILENT)  -rsi ${MP_CC_DIR}../ 
+	
+${OBJECTDIR}/APIs/trace.o: APIs/trace.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/APIs" 
+	@${RM} ${OBJECTDIR}/APIs/trace.o.d 
+	@${RM} ${OBJECTDIR}/APIs/trace.o 
+	${MP_CC} $(MP_EXTRA_CC_PRE)  APIs/trace.c  -o ${OBJECTDIR}/APIs/trace.o  -c -mcpu=$(MP_PROCESSOR_OPTION)  -MMD -MF "${OBJECTDIR}/APIs/trace.o.d"        -g -omf=elf -DXPRJ_size=$(CND_CONF)  -legacy-libc  $(COMPARISON_BUILD)  -Os -ffunction-sections -fdata-sections -msmart-io=1 -Wall -msfr-warn=off  
+	@${FIXDEPS} "${OBJECTDIR}/APIs/trace.o.d" $(SILENT)  -rsi ${MP_CC_DIR}../ 
+	
+${OBJECTDIR}/APIs/prof.o: APIs/prof.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/APIs" 
+	@${RM} ${OBJECTDIR}/APIs/prof.o.d 
+	@${RM} ${OBJECTDIR}/APIs/prof.o 
+	${MP_CC} $(MP_EXTRA_CC_PRE)  APIs/prof.c  -o ${OBJECTDIR}/APIs/prof.o  -c -mcpu=$(MP_PROCESSOR_OPTION)  -MMD -MF "${OBJECTDIR}/APIs/prof.o.d"        -g -omf=elf -DXPRJ_size=$(CND_CONF)  -legacy-libc  $(COMPARISON_BUILD)  -Os -ffunction-sections -fdata-sections -msmart-io=1 -Wall -msfr-warn=off  
+	@${FIXDEPS} "${OBJECTDIR}/APIs/prof.o.d" $(SILENT)  -rsi ${MP_CC_DIR}../ 
+	
+${OBJECTDIR}/APIs/motion.o: APIs/motion.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/APIs" 
+	@${RM} ${OBJECTDIR}/APIs/motion.o.d 
+	@${RM} ${OBJECTDIR}/APIs/motion.o 
+	${MP_CC} $(MP_EXTRA_CC_PRE)  APIs/motion.c  -o ${OBJECTDIR}/APIs/motion.o  -c -mcpu=$(MP_PROCESSOR_OPTION)  -MMD -MF "${OBJECTDIR}/APIs/motion.o.d"        -g -omf=elf -DXPRJ_size=$(CND_CONF)  -legacy-libc  $(COMPARISON_BUILD)  -Os -ffunction-sections -fdata-sections -msmart-io=1 -Wall -msfr-warn=off  
+	@${FIXDEPS} "${OBJECTDIR}/APIs/motion.o.d" $(SILENT)  -rsi ${MP_CC_DIR}../ 
+	
+${OBJECTDIR}/APIs/stroke.o: APIs/stroke.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/APIs" 
+	@${RM} ${OBJECTDIR}/APIs/stroke.o.d 
+	@${RM} ${OBJECTDIR}/APIs/stroke.o 
+	${MP_CC} $(MP_EXTRA_CC_PRE)  APIs/stroke.c  -o ${OBJECTDIR}/APIs/stroke.o  -c -mcpu=$(MP_PROCESSOR_OPTION)  -MMD -MF "${OBJECTDIR}/APIs/stroke.o.d"        -g -omf=elf -DXPRJ_size=$(CND_CONF)  -legacy-libc  $(COMPARISON_BUILD)  -Os -ffunction-sections -fdata-sections -msmart-io=1 -Wall -msfr-warn=off  
+	@${FIXDEPS} "${OBJECTDIR}/APIs/stroke.o.d" $(SILENT)  -rsi ${MP_CC_DIR}../ 
+	
+${OBJECTDIR}/APIs/filter.o: APIs/filter.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/APIs" 
+	@${RM} ${OBJECTDIR}/APIs/filter.o.d 
+	@${RM} ${OBJECTDIR}/APIs/filter.o 
+	${MP_CC} $(MP_EXTRA_CC_PRE)  APIs/filter.c  -o ${OBJECTDIR}/APIs/filter.o  -c -mcpu=$(MP_PROCESSOR_OPTION)  -MMD -MF "${OBJECTDIR}/APIs/filter.o.d"        -g -omf=elf -DXPRJ_size=$(CND_CONF)  -legacy-libc  $(COMPARISON_BUILD)  -Os -ffunction-sections -fdata-sections -msmart-io=1 -Wall -msfr-warn=off  
+	@${FIXDEPS} "${OBJECTDIR}/APIs/filter.o.d" $(SILENT)  -rsi ${MP_CC_DIR}../ 
+	
+${OBJECTDIR}/APIs/baud.o: APIs/baud.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/APIs" 
+	@${RM} ${OBJECTDIR}/APIs/baud.o.d 
+	@${RM} ${OBJECTDIR}/APIs/baud.o 
+	${MP_CC} $(MP_EXTRA_CC_PRE)  APIs/baud.c  -o ${OBJECTDIR}/APIs/baud.o  -c -mcpu=$(MP_PROCESSOR_OPTION)  -MMD -MF "${OBJECTDIR}/APIs/baud.o.d"        -g -omf=elf -DXPRJ_size=$(CND_CONF)  -legacy-libc  $(COMPARISON_BUILD)  -Os -ffunction-sections -fdata-sections -msmart-io=1 -Wall -msfr-warn=off  
+	@${FIXDEPS} "${OBJECTDIR}/APIs/baud.o.d" $(SILENT)  -rsi ${MP_CC_DIR}../ 
+	
+${OBJECTDIR}/APIs/button.o: APIs/button.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/APIs" 
+	@${RM} ${OBJECTDIR}/APIs/button.o.d 
+	@${RM} ${OBJECTDIR}/APIs/button.o 
+	${MP_CC} $(MP_EXTRA_CC_PRE)  APIs/button.c  -o ${OBJECTDIR}/APIs/button.o  -c -mcpu=$(MP_PROCESSOR_OPTION)  -MMD -MF "${OBJECTDIR}/APIs/button.o.d"        -g -omf=elf -DXPRJ_size=$(CND_CONF)  -legacy-libc  $(COMPARISON_BUILD)  -Os -ffunction-sections -fdata-sections -msmart-io=1 -Wall -msfr-warn=off  
+	@${FIXDEPS} "${OBJECTDIR}/APIs/button.o.d" $(SILENT)  -rsi ${MP_CC_DIR}../ 
+	
+${OBJECTDIR}/APIs/i2cdev.o: APIs/i2cdev.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/APIs" 
+	@${RM} ${OBJECTDIR}/APIs/i2cdev.o.d 
+	@${RM} ${OBJECTDIR}/APIs/i2cdev.o 
+	${MP_CC} $(MP_EXTRA_CC_PRE)  APIs/i2cdev.c  -o ${OBJECTDIR}/APIs/i2cdev.o  -c -mcpu=$(MP_PROCESSOR_OPTION)  -MMD -MF "${OBJECTDIR}/APIs/i2cdev.o.d"        -g -omf=elf -DXPRJ_size=$(CND_CONF)  -legacy-libc  $(COMPARISON_BUILD)  -Os -ffunction-sections -fdata-sections -msmart-io=1 -Wall -msfr-warn=off  
+	@${FIXDEPS} "${OBJECTDIR}/APIs/i2cdev.o.d" $(SILENT)  -rsi ${MP_CC_DIR}../ 
+	
+${OBJECTDIR}/APIs/VL6180.o: APIs/VL6180.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/APIs" 
+	@${RM} ${OBJECTDIR}/APIs/VL6180.o.d 
+	@${RM} ${OBJECTDIR}/APIs/VL6180.o 
+	${MP_CC} $(MP_EXTRA_CC_PRE)  APIs/VL6180.c  -o ${OBJECTDIR}/APIs/VL6180.o  -c -mcpu=$(MP_PROCESSOR_OPTION)  -MMD -MF "${OBJECTDIR}/APIs/VL6180.o.d"        -g -omf=elf -DXPRJ_size=$(CND_CONF)  -legacy-libc  $(COMPARISON_BUILD)  -Os -ffunction-sections -fdata-sections -msmart-io=1 -Wall -msfr-warn=off  
+	@${FIXDEPS} "${OBJECTDIR}/APIs/VL6180.o.d" $(SILENT)  -rsi ${MP_CC_DIR}../ 
+	
+${OBJECTDIR}/APIs/range.o: APIs/range.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/APIs" 
+	@${RM} ${OBJECTDIR}/APIs/range.o.d 
+	@${RM} ${OBJECTDIR}/APIs/range.o 
+	${MP_CC} $(MP_EXTRA_CC_PRE)  APIs/range.c  -o ${OBJECTDIR}/APIs/range.o  -c -mcpu=$(MP_PROCESSOR_OPTION)  -MMD -MF "${OBJECTDIR}/APIs/range.o.d"        -g -omf=elf -DXPRJ_size=$(CND_CONF)  -legacy-libc  $(COMPARISON_BUILD)  -Os -ffunction-sections -fdata-sections -msmart-io=1 -Wall -msfr-warn=off  
+	@${FIXDEPS} "${OBJECTDIR}/APIs/range.o.d" $(SILENT)  -rsi ${MP_CC_DIR}../ 
+	
+${OBJECTDIR}/APIs/brush.o: APIs/brush.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/APIs" 
+	@${RM} ${OBJECTDIR}/APIs/brush.o.d 
+	@${RM} ${OBJECTDIR}/APIs/brush.o 
+	${MP_CC} $(MP_EXTRA_CC_PRE)  APIs/brush.c  -o ${OBJECTDIR}/APIs/brush.o  -c -mcpu=$(MP_PROCESSOR_OPTION)  -MMD -MF "${OBJECTDIR}/APIs/brush.o.d"        -g -omf=elf -DXPRJ_size=$(CND_CONF)  -legacy-libc  $(COMPARISON_BUILD)  -Os -ffunction-sections -fdata-sections -msmart-io=1 -Wall -msfr-warn=off  
+	@${FIXDEPS} "${OBJECTDIR}/APIs/brush.o.d" $(SILENT)  -rsi ${MP_CC_DIR}../ 
+	
+${OBJECTDIR}/APIs/fill.o: APIs/fill.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/APIs" 
+	@${RM} ${OBJECTDIR}/APIs/fill.o.d 
+	@${RM} ${OBJECTDIR}/APIs/fill.o 
+	${MP_CC} $(MP_EXTRA_CC_PRE)  APIs/fill.c  -o ${OBJECTDIR}/APIs/fill.o  -c -mcpu=$(MP_PROCESSOR_OPTION)  -MMD -MF "${OBJECTDIR}/APIs/fill.o.d"        -g -omf=elf -DXPRJ_size=$(CND_CONF)  -legacy-libc  $(COMPARISON_BUILD)  -Os -ffunction-sections -fdata-sections -msmart-io=1 -Wall -msfr-warn=off  
+	@${FIXDEPS} "${OBJECTDIR}/APIs/fill.o.d" $(SILENT)  -rsi ${MP_CC_DIR}../ 
+	
+${OBJECTDIR}/mcc_generated_files/interrupt_manager.o: mcc_generated_files/interrupt_manager.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/mcc_generated_files" 
+	@${RM} ${OBJECTDIR}/mcc_generated_files/interrupt_manager.o.d 
+	@${RM} ${OBJECTDIR}/mcc_generated_files/interrupt_manager.o 
+	${MP_CC} $(MP_EXTRA_CC_PRE)  mcc_generated_files/interrupt_manager.c  -o ${OBJECTDIR}/mcc_generated_files/interrupt_manager.o  -c -mcpu=$(MP_PROCESSOR_OPTION)  -MMD -MF "${OBJECTDIR}/mcc_generated_files/interrupt_manager.o.d"        -g -omf=elf -DXPRJ_size=$(CND_CONF)  -legacy-libc  $(COMPARISON_BUILD)  -Os -ffunction-sections -fdata-sections -msmart-io=1 -Wall -msfr-warn=off  
+	@${FIXDEPS} "${OBJECTDIR}/mcc_generated_files/interrupt_manager.o.d" $(SILENT)  -rsi ${MP_CC_DIR}../ 
+	
+${OBJECTDIR}/mcc_generated_files/traps.o: mcc_generated_files/traps.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/mcc_generated_files" 
+	@${RM} ${OBJECTDIR}/mcc_generated_files/traps.o.d 
+	@${RM} ${OBJECTDIR}/mcc_generated_files/traps.o 
+	${MP_CC} $(MP_EXTRA_CC_PRE)  mcc_generated_files/traps.c  -o ${OBJECTDIR}/mcc_generated_files/traps.o  -c -mcpu=$(MP_PROCESSOR_OPTION)  -MMD -MF "${OBJECTDIR}/mcc_generated_files/traps.o.d"        -g -omf=elf -DXPRJ_size=$(CND_CONF)  -legacy-libc  $(COMPARISON_BUILD)  -Os -ffunction-sections -fdata-sections -msmart-io=1 -Wall -msfr-warn=off  
+	@${FIXDEPS} "${OBJECTDIR}/mcc_generated_files/traps.o.d" $(SILENT)  -rsi ${MP_CC_DIR}../ 
+	
+${OBJECTDIR}/mcc_generated_files/pin_manager.o: mcc_generated_files/pin_manager.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/mcc_generated_files" 
+	@${RM} ${OBJECTDIR}/mcc_generated_files/pin_manager.o.d 
+	@${RM} ${OBJECTDIR}/mcc_generated_files/pin_manager.o 
+	${MP_CC} $(MP_EXTRA_CC_PRE)  mcc_generated_files/pin_manager.c  -o ${OBJECTDIR}/mcc_generated_files/pin_manager.o  -c -mcpu=$(MP_PROCESSOR_OPTION)  -MMD -MF "${OBJECTDIR}/mcc_generated_files/pin_manager.o.d"        -g -omf=elf -DXPRJ_size=$(CND_CONF)  -legacy-libc  $(COMPARISON_BUILD)  -Os -ffunction-sections -fdata-sections -msmart-io=1 -Wall -msfr-warn=off  
+	@${FIXDEPS} "${OBJECTDIR}/mcc_generated_files/pin_manager.o.d" $(SILENT)  -rsi ${MP_CC_DIR}../ 
+	
+${OBJECTDIR}/mcc_generated_files/mcc.o: mcc_generated_files/mcc.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/mcc_generated_files" 
+	@${RM} ${OBJECTDIR}/mcc_generated_files/mcc.o.d 
+	@${RM} ${OBJECTDIR}/mcc_generated_files/mcc.o 
+	${MP_CC} $(MP_EXTRA_CC_PRE)  mcc_generated_files/mcc.c  -o ${OBJECTDIR}/mcc_generated_files/mcc.o  -c -mcpu=$(MP_PROCESSOR_OPTION)  -MMD -MF "${OBJECTDIR}/mcc_generated_files/mcc.o.d"        -g -omf=elf -DXPRJ_size=$(CND_CONF)  -legacy-libc  $(COMPARISON_BUILD)  -Os -ffunction-sections -fdata-sections -msmart-io=1 -Wall -msfr-warn=off  
+	@${FIXDEPS} "${OBJECTDIR}/mcc_generated_files/mcc.o.d" $(SILENT)  -rsi ${MP_CC_DIR}../ 
+	
+${OBJECTDIR}/mcc_generated_files/clock.o: mcc_generated_files/clock.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/mcc_generated_files" 
+	@${RM} ${OBJECTDIR}/mcc_generated_files/clock.o.d 
+	@${RM} ${OBJECTDIR}/mcc_generated_files/clock.o 
+	${MP_CC} $(MP_EXTRA_CC_PRE)  mcc_generated_files/clock.c  -o ${OBJECTDIR}/mcc_generated_files/clock.o  -c -mcpu=$(MP_PROCESSOR_OPTION)  -MMD -MF "${OBJECTDIR}/mcc_generated_files/clock.o.d"        -g -omf=elf -DXPRJ_size=$(CND_CONF)  -legacy-libc  $(COMPARISON_BUILD)  -Os -ffunction-sections -fdata-sections -msmart-io=1 -Wall -msfr-warn=off  
+	@${FIXDEPS} "${OBJECTDIR}/mcc_generated_files/clock.o.d" $(SILENT)  -rsi ${MP_CC_DIR}../ 
+	
+${OBJECTDIR}/mcc_generated_files/system.o: mcc_generated_files/system.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/mcc_generated_files" 
+	@${RM} ${OBJECTDIR}/mcc_generated_files/system.o.d 
+	@${RM} ${OBJECTDIR}/mcc_generated_files/system.o 
+	${MP_CC} $(MP_EXTRA_CC_PRE)  mcc_generated_files/system.c  -o ${OBJECTDIR}/mcc_generated_files/system.o  -c -mcpu=$(MP_PROCESSOR_OPTION)  -MMD -MF "${OBJECTDIR}/mcc_generated_files/system.o.d"        -g -omf=elf -DXPRJ_size=$(CND_CONF)  -legacy-libc  $(COMPARISON_BUILD)  -Os -ffunction-sections -fdata-sections -msmart-io=1 -Wall -msfr-warn=off  
+	@${FIXDEPS} "${OBJECTDIR}/mcc_generated_files/system.o.d" $(SILENT)  -rsi ${MP_CC_DIR}../ 
+	
+${OBJECTDIR}/main.o: main.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/main.o.d 
+	@${RM} ${OBJECTDIR}/main.o 
+	${MP_CC} $(MP_EXTRA_CC_PRE)  main.c  -o ${OBJECTDIR}/main.o  -c -mcpu=$(MP_PROCESSOR_OPTION)  -MMD -MF "${OBJECTDIR}/main.o.d"        -g -omf=elf -DXPRJ_size=$(CND_CONF)  -legacy-libc  $(COMPARISON_BUILD)  -Os -ffunction-sections -fdata-sections -msmart-io=1 -Wall -msfr-warn=off  
+	@${FIXDEPS} "${OBJECTDIR}/main.o.d" $(SILENT)  -rsi ${MP_CC_DIR}../ 
+	
+endif
+
+# ------------------------------------------------------------------------------------
+# Rules for buildStep: assemble
+ifeq ($(TYPE_IMAGE), DEBUG_RUN)
+else
+endif
+
+# ------------------------------------------------------------------------------------
+# Rules for buildStep: assemblePreproc
+ifeq ($(TYPE_IMAGE), DEBUG_RUN)
+else
+endif
+
+# ------------------------------------------------------------------------------------
+# Rules for buildStep: link
+ifeq ($(TYPE_IMAGE), DEBUG_RUN)
+dist/${CND_CONF}/${IMAGE_TYPE}/Terminal_Paint.X.${IMAGE_TYPE}.${OUTPUT_SUFFIX}: ${OBJECTFILES}  nbproject/Makefile-${CND_CONF}.mk    
+	@${MKDIR} dist/${CND_CONF}/${IMAGE_TYPE} 
+	${MP_CC} $(MP_EXTRA_LD_PRE)  -o dist/${CND_CONF}/${IMAGE_TYPE}/Terminal_Paint.X.${IMAGE_TYPE}.${OUTPUT_SUFFIX}  ${OBJECTFILES_QUOTED_IF_SPACED}      -mcpu=$(MP_PROCESSOR_OPTION)        -D__DEBUG -D__MPLAB_DEBUGGER_ICD3=1  -omf=elf -DXPRJ_size=$(CND_CONF)  -legacy-libc  $(COMPARISON_BUILD)   -mreserve=data@0x800:0x81F -mreserve=data@0x820:0x821 -mreserve=data@0x822:0x823 -mreserve=data@0x824:0x825 -mreserve=data@0x826:0x84F   -Wl,,,--defsym=__MPLAB_BUILD=1,--defsym=__MPLAB_DEBUG=1,--defsym=__DEBUG=1,--defsym=__MPLAB_DEBUGGER_ICD3=1,$(MP_LINKER_FILE_OPTION),--stack=512,--check-sections,--data-init,--pack-data,--handles,--isr,--gc-sections,--fill-upper=0,--stackguard=16,--no-force-link,--smart-io,-Map="${DISTDIR}/${PROJECTNAME}.${IMAGE_TYPE}.map",--report-mem,--memorysummary,dist/${CND_CONF}/${IMAGE_TYPE}/memoryfile.xml$(MP_EXTRA_LD_POST) 
+	
+else
+dist/${CND_CONF}/${IMAGE_TYPE}/Terminal_Paint.X.${IMAGE_TYPE}.${OUTPUT_SUFFIX}: ${OBJECTFILES}  nbproject/Makefile-${CND_CONF}.mk   
+	@${MKDIR} dist/${CND_CONF}/${IMAGE_TYPE} 
+	${MP_CC} $(MP_EXTRA_LD_PRE)  -o dist/${CND_CONF}/${IMAGE_TYPE}/Terminal_Paint.X.${IMAGE_TYPE}.${DEBUGGABLE_SUFFIX}  ${OBJECTFILES_QUOTED_IF_SPACED}      -mcpu=$(MP_PROCESSOR_OPTION)        -omf=elf -DXPRJ_size=$(CND_CONF)  -legacy-libc  $(COMPARISON_BUILD)  -Wl,,,--defsym=__MPLAB_BUILD=1,$(MP_LINKER_FILE_OPTION),--stack=512,--check-sections,--data-init,--pack-data,--handles,--isr,--gc-sections,--fill-upper=0,--stackguard=16,--no-force-link,--smart-io,-Map="${DISTDIR}/${PROJECTNAME}.${IMAGE_TYPE}.map",--report-mem,--memorysummary,dist/${CND_CONF}/${IMAGE_TYPE}/memoryfile.xml$(MP_EXTRA_LD_POST) 
+	${MP_CC_DIR}\\xc16-bin2hex dist/${CND_CONF}/${IMAGE_TYPE}/Terminal_Paint.X.${IMAGE_TYPE}.${DEBUGGABLE_SUFFIX} -a  -omf=elf  
+	
+endif
+
+
+# Subprojects
+.build-subprojects:
+
+
+# Subprojects
+.clean-subprojects:
+
+# Clean Targets
+.clean-conf: ${CLEAN_SUBPROJECTS}
+	${RM} -r build/size
+	${RM} -r dist/size
+
+# Enable dependency checking
+.dep.inc: .depcheck-impl
+
+DEPFILES=$(shell mplabwildcard ${POSSIBLE_DEPFILES})
+ifneq (${DEPFILES},)
+include ${DEPFILES}
+endif
@@ -11,3 +11,24 @@ CND_ARTIFACT_PATH_default=dist/default/production/Terminal_Paint.X.production.he
 CND_PACKAGE_DIR_default=${CND_DISTDIR}/default/package
 CND_PACKAGE_NAME_default=terminalpaint.x.tar
 CND_PACKAGE_PATH_default=${CND_DISTDIR}/default/package/terminalpaint.x.tar
+# release configuration
+CND_ARTIFACT_DIR_release=dist/release/production
+CND_ARTIFACT_NAME_release=Terminal_Paint.X.production.hex
+CND_ARTIFACT_PATH_release=dist/release/production/Terminal_Paint.X.production.hex
+CND_PACKAGE_DIR_release=${CND_DISTDIR}/release/package
+CND_PACKAGE_NAME_release=terminalpaint.x.tar
+CND_PACKAGE_PATH_release=${CND_DISTDIR}/release/package/terminalpaint.x.tar
+# size configuration
+CND_ARTIFACT_DIR_size=dist/size/production
+CND_ARTIFACT_NAME_size=Terminal_Paint.X.production.hex
+CND_ARTIFACT_PATH_size=dist/size/production/Terminal_Paint.X.production.hex
+CND_PACKAGE_DIR_size=${CND_DISTDIR}/size/package
+CND_PACKAGE_NAME_size=terminalpaint.x.tar
+CND_PACKAGE_PATH_size=${CND_DISTDIR}/size/package/terminalpaint.x.tar
+# speed configuration
+CND_ARTIFACT_DIR_speed=dist/speed/production
+CND_ARTIFACT_NAME_speed=Terminal_Paint.X.production.hex
+CND_ARTIFACT_PATH_speed=dist/speed/production/Terminal_Paint.X.production.hex
+CND_PACKAGE_DIR_speed=${CND_DISTDIR}/speed/package
+CND_PACKAGE_NAME_speed=terminalpaint.x.tar
+CND_PACKAGE_PATH_speed=${CND_DISTDIR}/speed/package/terminalpaint.x.tar
@@ -0,0 +1,324 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+//  Filename:       confcmp.c
+//
+//  Description:
+//  Host comparison of MPLAB X builds, built by "make confcmp". For each
+//  configuration given it reads the XC16 linker map,
+//      dist/<conf>/production/Terminal Paint.X.production.map
+//  and takes the flash and RAM totals of the memory usage report, then the
+//  stage table of the profiler if it was saved next to it as prof.txt: the
+//  text the terminal shows after 'p' on a build with PROF_ENABLE=1, e.g.
+//      make MP_EXTRA_CC_PRE=-DPROF_ENABLE=1
+//  That build is larger than the one measured for flash, compare the sizes
+//  on builds without it. The project has four configurations, default at
+//  -O0, release at -O1, size at -Os and speed at -O2, the last three with
+//  -ffunction-sections -fdata-sections and --gc-sections; after building
+//  each ("make CONF=release" and so on) they are compared with
+//      confcmp default release size speed
+//
+//  sim/confcmp/fixture/production is a format fixture only: the memory
+//  usage report of the XC16 1.35 map of the baseline default build and the
+//  'p' dump of "make sim" built with PROF_ENABLE=1. "make check" runs
+//      confcmp -d sim/confcmp fixture
+//  to test the parsing, it measures none of the configurations above.
+//
+//  Usage:  confcmp [-d dist_dir] conf...
+//
+//  Prints one column per configuration: flash and RAM in bytes, then the
+//  mean and max cycles of each stage and the share of Fcy the stages used
+//  over the profiling window, with the change from the first column.
+//  Exits with 1 if a map is missing or has no flash or RAM total.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "../APIs/i2c1.h"
+
+#define MAP_NAME    "Terminal Paint.X.production.map"
+#define PROF_NAME   "prof.txt"
+#define FLASH_KEY   "Total \"program\" memory used (bytes):"
+#define RAM_KEY     "Total \"data\" memory used (bytes):"
+#define WINDOW_KEY  "over "
+
+#define CONFS_MAX   8
+#define STAGES_MAX  16
+#define NAME_W      10              // stage name column of the dump
+#define LINE_LEN    512
+#define COL_W       18
+
+#define USAGE       "usage: %s [-d dist_dir] conf...\n"
+
+// stage line of the dump
+typedef struct
+{
+    char szName[NAME_W + 1];
+    unsigned long ulCount;
+    unsigned long ulMean;
+    unsigned long ulMax;
+} STAGE;
+
+// what was read for one configuration, -1 when missing
+typedef struct
+{
+    const char* pszName;
+    long lFlash;
+    long lRam;
+    long lWindowMs;
+    int iStages;
+    STAGE sStage[STAGES_MAX];
+} CONF;
+
+static CONF sConf[CONFS_MAX];
+static int iConfs = 0;
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           openIn
+//  Description:    Opens <dir>/<conf>/production/<file>, NULL if missing
+///////////////////////////////////////////////////////////////////////////////
+static FILE* openIn(const char* pszDir, const char* pszConf, const char* pszFile)
+{
+    char szPath[LINE_LEN];
+
+    snprintf(szPath, sizeof(szPath), "%s/%s/production/%s", pszDir, pszConf, pszFile);
+    return(fopen(szPath, "r"));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           readMap
+//  Description:    Takes the flash and RAM totals out of a linker map, the
+//                  decimal count in parentheses after the hex one
+///////////////////////////////////////////////////////////////////////////////
+static void readMap(CONF* pConf, FILE* pf)
+{
+    char szLine[LINE_LEN];
+    char* psz;
+
+    while(fgets(szLine, sizeof(szLine), pf))
+    {
+        long* plTotal = NULL;
+
+        if((psz = strstr(szLine, FLASH_KEY)) != NULL)
+        {
+            plTotal = &pConf->lFlash;
+            psz += strlen(FLASH_KEY);
+        }
+        else if((psz = strstr(szLine, RAM_KEY)) != NULL)
+        {
+            plTotal = &pConf->lRam;
+            psz += strlen(RAM_KEY);
+        }
+        if(plTotal && (psz = strchr(psz, '(')) != NULL)
+            *plTotal = strtol(psz + 1, NULL, 10);
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           readProf
+//  Description:    Reads the profiler table: the window from the title, then
+//                  every line with a count, min, mean and max after the name.
+//                  Escape sequences and carriage returns are dropped first.
+///////////////////////////////////////////////////////////////////////////////
+static void readProf(CONF* pConf, FILE* pf)
+{
+    char szRaw[LINE_LEN], szLine[LINE_LEN];
+    char* psz;
+    unsigned long ulMin;
+
+    pConf->iStages = 0;
+    while(fgets(szRaw, sizeof(szRaw), pf))
+    {
+        int i, j = 0;
+
+        for(i = 0; szRaw[i] && szRaw[i] != '\n'; i++)
+        {
+            if(szRaw[i] == '\033')
+            {
+                // CSI: parameters up to the final byte
+                for(i += 2; szRaw[i] && (szRaw[i] < '@' || szRaw[i] > '~'); i++)
+                    ;
+                if(!szRaw[i])
+                    break;
+            }
+            else if(szRaw[i] != '\r')
+                szLine[j++] = szRaw[i];
+        }
+        szLine[j] = '\0';
+
+        if((psz = strstr(szLine, WINDOW_KEY)) != NULL)
+            pConf->lWindowMs = strtol(psz + strlen(WINDOW_KEY), NULL, 10);
+        else if(j > NAME_W && pConf->iStages < STAGES_MAX)
+        {
+            STAGE* pS = &pConf->sStage[pConf->iStages];
+
+            if(sscanf(szLine + NAME_W, "%lu %lu %lu %lu", &pS->ulCount, &ulMin,
+                      &pS->ulMean, &pS->ulMax) != 4)
+                continue;
+            memcpy(pS->szName, szLine, NAME_W);
+            for(i = NAME_W; i > 0 && pS->szName[i - 1] == ' '; i--)
+                ;
+            pS->szName[i] = '\0';
+            pConf->iStages++;
+        }
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           findStage
+//  Description:    Stage of a configuration by name, NULL if not there
+///////////////////////////////////////////////////////////////////////////////
+static const STAGE* findStage(const CONF* pConf, const char* pszName)
+{
+    int i;
+
+    for(i = 0; i < pConf->iStages; i++)
+        if(!strcmp(pConf->sStage[i].szName, pszName))
+            return(&pConf->sStage[i]);
+    return(NULL);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           busy
+//  Description:    Share of Fcy in percent the stages took over the window,
+//                  -1 without a profile
+///////////////////////////////////////////////////////////////////////////////
+static double busy(const CONF* pConf)
+{
+    double dCycles = 0.0;
+    int i;
+
+    if(pConf->lWindowMs <= 0)
+        return(-1.0);
+    for(i = 0; i < pConf->iStages; i++)
+        dCycles += (double)pConf->sStage[i].ulCount * pConf->sStage[i].ulMean;
+    return(100.0 * dCycles / ((double)pConf->lWindowMs * (FCY / 1000)));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           cell
+//  Description:    Prints one value with its change from the first column
+///////////////////////////////////////////////////////////////////////////////
+static void cell(int iConf, double dValue, double dBase, const char* pszFmt)
+{
+    char szCell[COL_W + 1], szDelta[COL_W];
+
+    if(dValue < 0)
+    {
+        printf("%*s", COL_W, "-");
+        return;
+    }
+    szDelta[0] = '\0';
+    if(iConf > 0 && dBase > 0)
+        snprintf(szDelta, sizeof(szDelta), " (%+.0f%%)", 100.0 * (dValue - dBase) / dBase);
+    snprintf(szCell, sizeof(szCell), pszFmt, dValue);
+    strncat(szCell, szDelta, sizeof(szCell) - strlen(szCell) - 1);
+    printf("%*s", COL_W, szCell);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           row
+//  Description:    Prints a row, <pdValue> holds one value per configuration
+///////////////////////////////////////////////////////////////////////////////
+static void row(const char* pszLabel, const double* pdValue, const char* pszFmt)
+{
+    int i;
+
+    printf("%-16s", pszLabel);
+    for(i = 0; i < iConfs; i++)
+        cell(i, pdValue[i], pdValue[0], pszFmt);
+    printf("\n");
+}
+
+int main(int argc, char** argv)
+{
+    const char* pszDir = "dist";
+    double dValue[CONFS_MAX];
+    char szLabel[NAME_W + 8];
+    const CONF* pNames = NULL;
+    int iOpt, i, s, iMissing = 0;
+
+    while((iOpt = getopt(argc, argv, "d:")) != -1)
+    {
+        if(iOpt != 'd')
+        {
+            fprintf(stderr, USAGE, argv[0]);
+            return(1);
+        }
+        pszDir = optarg;
+    }
+    if(optind == argc || argc - optind > CONFS_MAX)
+    {
+        fprintf(stderr, USAGE, argv[0]);
+        return(1);
+    }
+
+    for(; optind < argc; optind++)
+    {
+        CONF* pConf = &sConf[iConfs++];
+        FILE* pf;
+
+        pConf->pszName = argv[optind];
+        pConf->lFlash = pConf->lRam = pConf->lWindowMs = -1;
+        if((pf = openIn(pszDir, pConf->pszName, MAP_NAME)) != NULL)
+        {
+            readMap(pConf, pf);
+            fclose(pf);
+        }
+        else
+            fprintf(stderr, "%s: no %s\n", pConf->pszName, MAP_NAME);
+        if(pConf->lFlash < 0 || pConf->lRam < 0)
+            iMissing++;
+        if((pf = openIn(pszDir, pConf->pszName, PROF_NAME)) != NULL)
+        {
+            readProf(pConf, pf);
+            fclose(pf);
+        }
+        // stage rows follow the first configuration with a profile
+        if(!pNames && pConf->iStages > 0)
+            pNames = pConf;
+    }
+
+    printf("%-16s", "");
+    for(i = 0; i < iConfs; i++)
+        printf("%*s", COL_W, sConf[i].pszName);
+    printf("\n");
+
+    for(i = 0; i < iConfs; i++)
+        dValue[i] = sConf[i].lFlash;
+    row("flash bytes", dValue, "%.0f");
+    for(i = 0; i < iConfs; i++)
+        dValue[i] = sConf[i].lRam;
+    row("RAM bytes", dValue, "%.0f");
+
+    for(s = 0; pNames && s < pNames->iStages; s++)
+    {
+        const char* pszStage = pNames->sStage[s].szName;
+
+        for(i = 0; i < iConfs; i++)
+        {
+            const STAGE* pS = findStage(&sConf[i], pszStage);
+
+            dValue[i] = (pS && pS->ulCount)? (double)pS->ulMean : -1.0;
+        }
+        snprintf(szLabel, sizeof(szLabel), "%s mean", pszStage);
+        row(szLabel, dValue, "%.0f");
+        for(i = 0; i < iConfs; i++)
+        {
+            const STAGE* pS = findStage(&sConf[i], pszStage);
+
+            dValue[i] = (pS && pS->ulCount)? (double)pS->ulMax : -1.0;
+        }
+        snprintf(szLabel, sizeof(szLabel), "%s max", pszStage);
+        row(szLabel, dValue, "%.0f");
+    }
+    if(pNames)
+    {
+        for(i = 0; i < iConfs; i++)
+            dValue[i] = busy(&sConf[i]);
+        row("busy % of Fcy", dValue, "%.2f");
+    }
+    return(iMissing? 1 : 0);
+}
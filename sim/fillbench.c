@@ -0,0 +1,239 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+//  Filename:       fillbench.c
+//
+//  Description:
+//  Host benchmark of the flood fill (APIs/fill.c), built by "make fillbench"
+//  and run by "make check". Each shape is drawn on the canvas and filled
+//  from a blank cell with FILL_Start() and FILL_Step(), the output going to
+//  the UART2 model, which is flushed between the steps so that only the
+//  fill is timed. The shapes are the worst cases of a scanline fill:
+//
+//      comb            teeth a cell apart hang from the top row, every gap
+//                      between two is a span that leaves seeds behind
+//      spiral          a corridor a cell wide winds to the middle, the fill
+//                      turns at every corner
+//      checkerboard    every other row is a checkerboard of ink, so those
+//                      rows break into single-cell spans
+//
+//  Reported per shape: the cells filled, the FILL_Step() calls, the bytes
+//  sent, the peak depth of the seed stack (of FILL_STACK) and the seeds
+//  dropped on a full stack, then the host time of the whole fill and of
+//  the longest step, the best of REPS runs. The filled cells are compared
+//  with a breadth-first fill worked out here.
+//
+//  Usage:  fillbench
+//
+//  Exits with 1 if a fill differs from the reference.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include <xc.h>
+#include <stdio.h>
+#include <time.h>
+#include "../APIs/fill.h"
+#include "../APIs/uart2.h"
+
+#define REPS        20
+#define TEST_BAUD   1000000UL       // flushes a step's output quickly
+
+typedef struct
+{
+    const char* pszName;
+    void (*pfDraw)(void);
+    unsigned char ucRow, ucCol;     // blank cell the fill starts from
+} SHAPE;
+
+// cells of the reference fill, with a border that stops it
+static unsigned char ucRef[SCREEN_H + 2][SCREEN_W + 2];
+static unsigned int uiQueue[SCREEN_H * SCREEN_W];
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           nsNow
+//  Description:    Host monotonic clock in nanoseconds
+///////////////////////////////////////////////////////////////////////////////
+static unsigned long long nsNow(void)
+{
+    struct timespec sNow;
+
+    clock_gettime(CLOCK_MONOTONIC, &sNow);
+    return((unsigned long long)sNow.tv_sec * 1000000000ULL + sNow.tv_nsec);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           sink
+//  Description:    Bytes shifted out of U2TX, counted by the model only
+///////////////////////////////////////////////////////////////////////////////
+static void sink(unsigned char ucByte)
+{
+    (void)ucByte;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           comb
+//  Description:    Teeth on every other column, down from row 2
+///////////////////////////////////////////////////////////////////////////////
+static void comb(void)
+{
+    int r, c;
+
+    for(c = 2; c <= SCREEN_W; c += 2)
+        for(r = 2; r <= SCREEN_H; r++)
+            CANVAS_Set(r, c, CANVAS_INK);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           spiral
+//  Description:    Ink all over but for a corridor a cell wide, clockwise
+//                  from the top left corner to the middle
+///////////////////////////////////////////////////////////////////////////////
+static void spiral(void)
+{
+    int iTop = 2, iBottom = SCREEN_H - 1, iLeft = 2, iRight = SCREEN_W - 1;
+    int r;
+
+    for(r = 1; r <= SCREEN_H; r++)
+        CANVAS_SetRun(r, 1, SCREEN_W, CANVAS_INK);
+
+    for(;;)
+    {
+        CANVAS_SetRun(iTop, (iLeft > 2)? iLeft - 2 : iLeft, iRight, CANVAS_BLANK);
+        if((iTop += 2) > iBottom)
+            break;
+        for(r = iTop - 2; r <= iBottom; r++)
+            CANVAS_Set(r, iRight, CANVAS_BLANK);
+        if((iRight -= 2) < iLeft)
+            break;
+        CANVAS_SetRun(iBottom, iLeft, iRight + 2, CANVAS_BLANK);
+        if((iBottom -= 2) < iTop)
+            break;
+        for(r = iTop; r <= iBottom + 2; r++)
+            CANVAS_Set(r, iLeft, CANVAS_BLANK);
+        if((iLeft += 2) > iRight)
+            break;
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           checkerboard
+//  Description:    Ink on every other cell of every other row
+///////////////////////////////////////////////////////////////////////////////
+static void checkerboard(void)
+{
+    int r, c;
+
+    for(r = 2; r <= SCREEN_H; r += 2)
+        for(c = 1 + (r / 2 & 1); c <= SCREEN_W; c += 2)
+            CANVAS_Set(r, c, CANVAS_INK);
+}
+
+static const SHAPE sShapes[] =
+{
+    { "comb", comb, 1, 1 },
+    { "spiral", spiral, 2, 2 },
+    { "checkerboard", checkerboard, 1, 1 },
+};
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           reference
+//  Description:    Fills the blank cells 4-connected to a cell in ucRef,
+//                  breadth first, returns how many
+///////////////////////////////////////////////////////////////////////////////
+static unsigned int reference(int iRow, int iCol)
+{
+    static const int iDr[4] = { -1, 1, 0, 0 }, iDc[4] = { 0, 0, -1, 1 };
+    unsigned int uiHead = 0, uiTail = 0;
+    int r, c, d;
+
+    for(r = 0; r < SCREEN_H + 2; r++)
+        for(c = 0; c < SCREEN_W + 2; c++)
+            ucRef[r][c] = (r < 1 || r > SCREEN_H || c < 1 || c > SCREEN_W)?
+                          2 : CANVAS_Get(r, c);
+
+    ucRef[iRow][iCol] = CANVAS_INK;
+    uiQueue[uiTail++] = iRow * (SCREEN_W + 2) + iCol;
+    while(uiHead < uiTail)
+    {
+        r = uiQueue[uiHead] / (SCREEN_W + 2);
+        c = uiQueue[uiHead++] % (SCREEN_W + 2);
+        for(d = 0; d < 4; d++)
+        {
+            if(ucRef[r + iDr[d]][c + iDc[d]] != CANVAS_BLANK)
+                continue;
+            ucRef[r + iDr[d]][c + iDc[d]] = CANVAS_INK;
+            uiQueue[uiTail++] = (r + iDr[d]) * (SCREEN_W + 2) + c + iDc[d];
+        }
+    }
+    return(uiTail);
+}
+
+int main(void)
+{
+    unsigned long long ullNs, ullStep, ullTotal, ullBest, ullStepMax, ullBestStep;
+    unsigned long ulSteps, ulBytes, ulMismatch = 0;
+    unsigned int i, uiRep, uiCells, uiBad;
+    const SHAPE* pShape;
+    char cOn;
+    int r, c;
+
+    simUART2Sink = sink;
+    UART2_Initialize();
+    setBaudUART2(TEST_BAUD);
+
+    printf("%-13s %6s %6s %7s %9s %8s %10s %10s\n", "shape", "cells", "steps",
+           "bytes", "peak", "dropped", "fill us", "step us");
+
+    for(i = 0; i < sizeof(sShapes) / sizeof(sShapes[0]); i++)
+    {
+        pShape = &sShapes[i];
+        ullBest = ullBestStep = ~0ULL;
+        for(uiRep = 0; uiRep < REPS; uiRep++)
+        {
+            CANVAS_Clear();
+            pShape->pfDraw();
+            uiCells = reference(pShape->ucRow, pShape->ucCol);
+
+            TERM_Invalidate();
+            txFlushUART2();
+            ulBytes = simUART2TxBytes;
+            ulSteps = 0;
+            ullTotal = ullStepMax = 0;
+            FILL_Start(pShape->ucRow, pShape->ucCol, CANVAS_INK);
+            do
+            {
+                ullNs = nsNow();
+                cOn = FILL_Step();
+                ullStep = nsNow() - ullNs;
+                ullTotal += ullStep;
+                if(ullStep > ullStepMax)
+                    ullStepMax = ullStep;
+                ulSteps++;
+                txFlushUART2();
+            } while(cOn);
+            ulBytes = simUART2TxBytes - ulBytes;
+
+            if(ullTotal < ullBest)
+                ullBest = ullTotal;
+            if(ullStepMax < ullBestStep)
+                ullBestStep = ullStepMax;
+        }
+
+        uiBad = 0;
+        for(r = 1; r <= SCREEN_H; r++)
+            for(c = 1; c <= SCREEN_W; c++)
+                uiBad += (CANVAS_Get(r, c) != ucRef[r][c]);
+        if(uiBad)
+        {
+            printf("FAIL %s: %u cells differ from the reference\n", pShape->pszName, uiBad);
+            ulMismatch++;
+        }
+
+        printf("%-13s %6u %6lu %7lu %5u/%-3u %8u %10.1f %10.1f\n", pShape->pszName,
+               uiCells, ulSteps, ulBytes, FILL_Peak(), FILL_STACK, FILL_Dropped(),
+               ullBest / 1e3, ullBestStep / 1e3);
+    }
+
+    printf("fillbench: %lu of %u fills differ from the reference\n", ulMismatch,
+           (unsigned int)(sizeof(sShapes) / sizeof(sShapes[0])));
+    return(ulMismatch? 1 : 0);
+}
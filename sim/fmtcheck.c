@@ -0,0 +1,205 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+//  Filename:       fmtcheck.c
+//
+//  Description:
+//  Host test of the number and escape formatting (APIs/fmt.c) against
+//  sprintf(), built by "make fmtcheck" and run by "make check". Every
+//  output is compared for every byte value 0 to 255: FMT_U8(), FMT_Csi()
+//  with each final byte the firmware uses, FMT_Cup() for every row and
+//  column pair, and FMT_U32() at every field width, on the bytes and on
+//  values of every length up to 4294967295. The ...Len() functions must
+//  agree with the lengths, and no function may write past its FMT_..._MAX.
+//
+//  Then each function and its sprintf() equivalent are timed on the same
+//  values, and the ratio of their host times reported.
+//
+//  Usage:  fmtcheck
+//
+//  Exits with 1 on a mismatch.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include "../APIs/fmt.h"
+
+#define GUARD       0x5A            // fills the buffer past the output
+#define BUFF_SIZE   32
+#define WIDTH_MAX   12
+
+// final bytes of the control sequences built with FMT_Csi()
+static const char cFinals[] = { 'A', 'B', 'C', 'D', 'X', 'b' };
+
+static const unsigned long ulU32s[] =
+{
+    999, 1000, 9999, 10000, 65535, 65536, 99999, 100000, 999999, 1000000,
+    9999999, 10000000, 99999999, 100000000, 999999999, 1000000000,
+    2147483647, 2147483648UL, 4294967295UL
+};
+
+static unsigned long ulChecks = 0, ulFailed = 0;
+
+// keeps the timed loops from being optimized away
+static volatile unsigned int uiSink;
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           nsNow
+//  Description:    Host monotonic clock in nanoseconds
+///////////////////////////////////////////////////////////////////////////////
+static unsigned long long nsNow(void)
+{
+    struct timespec sNow;
+
+    clock_gettime(CLOCK_MONOTONIC, &sNow);
+    return((unsigned long long)sNow.tv_sec * 1000000000ULL + sNow.tv_nsec);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           compare
+//  Description:    Checks an output against the expected string, its length
+//                  against the returned and predicted ones, and that no more
+//                  than <uiMax> bytes were written
+///////////////////////////////////////////////////////////////////////////////
+static void compare(const char* pszWhat, const char* pcBuff, unsigned int uiLen,
+                    unsigned int uiPredicted, unsigned int uiMax, const char* pszExpect)
+{
+    unsigned int i, uiExpect = strlen(pszExpect);
+    int iOk = (uiLen == uiExpect && uiPredicted == uiExpect && uiLen <= uiMax
+               && memcmp(pcBuff, pszExpect, uiExpect) == 0);
+
+    for(i = uiLen; i < BUFF_SIZE; i++)
+        iOk &= ((unsigned char)pcBuff[i] == GUARD);
+
+    ulChecks++;
+    if(!iOk && ulFailed++ < 20)
+        printf("FAIL %s: got \"%.*s\" (%u, predicted %u), expected \"%s\"\n",
+                pszWhat, uiLen, pcBuff, uiLen, uiPredicted, pszExpect);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           ratio
+//  Description:    Reports the host time of a FMT_ function against sprintf()
+///////////////////////////////////////////////////////////////////////////////
+static void ratio(const char* pszWhat, unsigned long ulCalls,
+                  unsigned long long ullFmtNs, unsigned long long ullPrintfNs)
+{
+    printf("%-8s %8lu calls %8.1f ns %8.1f ns sprintf  %5.2fx\n", pszWhat, ulCalls,
+            (double)ullFmtNs / ulCalls, (double)ullPrintfNs / ulCalls,
+            ullFmtNs? (double)ullPrintfNs / ullFmtNs : 0.0);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           cupExpect
+//  Description:    CUP as sprintf() writes it, with the defaults of 1 omitted
+///////////////////////////////////////////////////////////////////////////////
+static int cupExpect(char* psz, unsigned int uiRow, unsigned int uiCol)
+{
+    if(uiCol == 1)
+        return((uiRow == 1)? sprintf(psz, "\033[H") : sprintf(psz, "\033[%uH", uiRow));
+    if(uiRow == 1)
+        return(sprintf(psz, "\033[;%uH", uiCol));
+    return(sprintf(psz, "\033[%u;%uH", uiRow, uiCol));
+}
+
+int main(void)
+{
+    char cBuff[BUFF_SIZE], cExpect[BUFF_SIZE], cWhat[48];
+    unsigned int uiV, uiW, uiF, uiLen;
+    unsigned long ulV, ulCalls;
+    unsigned long long ullNs, ullFmtNs;
+
+    // outputs, every value
+    for(uiV = 0; uiV < 256; uiV++)
+    {
+        memset(cBuff, GUARD, sizeof(cBuff));
+        uiLen = FMT_U8(cBuff, uiV);
+        sprintf(cExpect, "%u", uiV);
+        sprintf(cWhat, "FMT_U8(%u)", uiV);
+        compare(cWhat, cBuff, uiLen, FMT_U8Len(uiV), FMT_U8_MAX, cExpect);
+
+        for(uiF = 0; uiF < sizeof(cFinals); uiF++)
+        {
+            memset(cBuff, GUARD, sizeof(cBuff));
+            uiLen = FMT_Csi(cBuff, uiV, cFinals[uiF]);
+            if(uiV == 1)
+                sprintf(cExpect, "\033[%c", cFinals[uiF]);
+            else
+                sprintf(cExpect, "\033[%u%c", uiV, cFinals[uiF]);
+            sprintf(cWhat, "FMT_Csi(%u, '%c')", uiV, cFinals[uiF]);
+            compare(cWhat, cBuff, uiLen, FMT_CsiLen(uiV), FMT_CSI_MAX, cExpect);
+        }
+
+        for(uiW = 0; uiW < 256; uiW++)
+        {
+            memset(cBuff, GUARD, sizeof(cBuff));
+            uiLen = FMT_Cup(cBuff, uiV, uiW);
+            cupExpect(cExpect, uiV, uiW);
+            sprintf(cWhat, "FMT_Cup(%u, %u)", uiV, uiW);
+            compare(cWhat, cBuff, uiLen, FMT_CupLen(uiV, uiW), FMT_CUP_MAX, cExpect);
+        }
+
+        for(uiW = 0; uiW <= WIDTH_MAX; uiW++)
+        {
+            memset(cBuff, GUARD, sizeof(cBuff));
+            uiLen = FMT_U32(cBuff, uiV, uiW);
+            sprintf(cExpect, "%*u", uiW, uiV);
+            sprintf(cWhat, "FMT_U32(%u, %u)", uiV, uiW);
+            compare(cWhat, cBuff, uiLen, uiLen, (uiW > FMT_U32_MAX)? uiW : FMT_U32_MAX, cExpect);
+        }
+    }
+
+    for(uiV = 0; uiV < sizeof(ulU32s) / sizeof(ulU32s[0]); uiV++)
+    {
+        for(uiW = 0; uiW <= WIDTH_MAX; uiW++)
+        {
+            memset(cBuff, GUARD, sizeof(cBuff));
+            uiLen = FMT_U32(cBuff, ulU32s[uiV], uiW);
+            sprintf(cExpect, "%*lu", uiW, ulU32s[uiV]);
+            sprintf(cWhat, "FMT_U32(%lu, %u)", ulU32s[uiV], uiW);
+            compare(cWhat, cBuff, uiLen, uiLen, (uiW > FMT_U32_MAX)? uiW : FMT_U32_MAX, cExpect);
+        }
+    }
+
+    // timing, the same values both ways
+    ulCalls = 256 * 256;
+    ullNs = nsNow();
+    for(ulV = 0; ulV < ulCalls; ulV++)
+        uiSink = FMT_U8(cBuff, ulV & 0xFF);
+    ullFmtNs = nsNow() - ullNs;
+    ullNs = nsNow();
+    for(ulV = 0; ulV < ulCalls; ulV++)
+        uiSink = sprintf(cBuff, "%u", (unsigned int)(ulV & 0xFF));
+    ratio("U8", ulCalls, ullFmtNs, nsNow() - ullNs);
+
+    ullNs = nsNow();
+    for(ulV = 0; ulV < ulCalls; ulV++)
+        uiSink = FMT_Csi(cBuff, ulV & 0xFF, 'C');
+    ullFmtNs = nsNow() - ullNs;
+    ullNs = nsNow();
+    for(ulV = 0; ulV < ulCalls; ulV++)
+        uiSink = sprintf(cBuff, "\033[%uC", (unsigned int)(ulV & 0xFF));
+    ratio("Csi", ulCalls, ullFmtNs, nsNow() - ullNs);
+
+    ullNs = nsNow();
+    for(ulV = 0; ulV < ulCalls; ulV++)
+        uiSink = FMT_Cup(cBuff, ulV >> 8, ulV & 0xFF);
+    ullFmtNs = nsNow() - ullNs;
+    ullNs = nsNow();
+    for(ulV = 0; ulV < ulCalls; ulV++)
+        uiSink = sprintf(cBuff, "\033[%u;%uH", (unsigned int)(ulV >> 8), (unsigned int)(ulV & 0xFF));
+    ratio("Cup", ulCalls, ullFmtNs, nsNow() - ullNs);
+
+    ullNs = nsNow();
+    for(ulV = 0; ulV < ulCalls; ulV++)
+        uiSink = FMT_U32(cBuff, ulV * 65521UL, 10);
+    ullFmtNs = nsNow() - ullNs;
+    ullNs = nsNow();
+    for(ulV = 0; ulV < ulCalls; ulV++)
+        uiSink = sprintf(cBuff, "%10lu", ulV * 65521UL);
+    ratio("U32", ulCalls, ullFmtNs, nsNow() - ullNs);
+
+    printf("fmtcheck: %lu outputs, %lu mismatches\n", ulChecks, ulFailed);
+    return(ulFailed? 1 : 0);
+}
@@ -0,0 +1,391 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+//  Filename:       i2ccheck.c
+//
+//  Description:
+//  Host test of the queued I2C1 engine (APIs/i2c1.c) on the simulated bus,
+//  built by "make i2ccheck" and run by "make check". At each bus speed a
+//  full queue of register writes and reads goes through submitI2C1() to a
+//  plain register device; then a transfer to an address nobody answers,
+//  one to a slave that hangs the bus, and a blocking write mixed with
+//  queued transfers, one of them submitted while the write is on the bus.
+//
+//  Checked for every transfer: its status, the order of the completion
+//  callbacks, the bytes read back, and its time from START to STOP, at
+//  least its bits at the bus speed and at most TIME_SLACK_PCT percent and
+//  TIME_SLACK_US more. submitI2C1() must return in SUBMIT_MAX_CYCLES and
+//  refuse a descriptor once I2C1_QUEUE_SIZE are pending. A hung transfer
+//  must end as a timeout within its Timer4 window and leave the bus usable.
+//  The blocking write must wait for the queue and the queue for it: no
+//  START may be asked for inside another transaction.
+//
+//  Usage:  i2ccheck [-v]
+//
+//  -v prints the time of every transfer. Exits with 1 if a check failed.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include <xc.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include "../APIs/i2c1.h"
+
+#define DEV_ADDR            0xA0        // register device, 8-bit address
+#define ABSENT_ADDR         0x20        // no device answers
+#define DEV_REGS            256
+
+#define XFER_BYTES          4           // data bytes per write and read
+#define SUBMIT_MAX_CYCLES   200         // submitI2C1() returns at once
+#define TIME_SLACK_PCT      10          // ISR latency between bus events
+#define TIME_SLACK_US       10
+
+#define CYCLES_PER_US       (SIM_FCY / 1000000UL)
+
+// statsI2C1() is never reset, the fastest speed goes first so the longest
+// transfer so far is one of the current speed
+static const unsigned int uiSpeeds[] = { 1000, 400, 100 };
+
+static unsigned char ucRegs[DEV_REGS];
+static SIM_I2C_DEV sDev =
+{
+    .ucAddr = DEV_ADDR,
+    .ucRegWidth = 1,
+    .pucRegs = ucRegs,
+    .uiRegCnt = DEV_REGS,
+    .pfRead = NULL,
+    .pfWrite = NULL,
+    .pvUser = NULL,
+    .pullBusy = NULL
+};
+
+// completions in the order the callbacks ran
+static I2C1_XFER* pDone[2 * I2C1_QUEUE_SIZE];
+static unsigned long long ullDoneAt[2 * I2C1_QUEUE_SIZE];
+static unsigned int uiDone;
+
+// statistics at the start of the current check
+static I2C1_STATS sBase;
+
+static int iVerbose = 0;
+
+// submitted by lateHook() once armed and the bus is owned
+static I2C1_XFER* pLate = NULL;
+static unsigned int uiFailed = 0, uiChecks = 0;
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           check
+//  Description:    Counts a check, reports it if it failed
+///////////////////////////////////////////////////////////////////////////////
+static void check(int iOk, const char* pszWhat, unsigned int uiKhz)
+{
+    uiChecks++;
+    if(!iOk)
+    {
+        uiFailed++;
+        printf("FAIL %4u kHz: %s\n", uiKhz, pszWhat);
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           since
+//  Description:    Statistics counted since the last call, the times as they
+//                  are
+///////////////////////////////////////////////////////////////////////////////
+static void since(I2C1_STATS* pStats)
+{
+    I2C1_STATS sNow;
+
+    statsI2C1(&sNow);
+    *pStats = sNow;
+    pStats->ulXfers -= sBase.ulXfers;
+    pStats->ulNaks -= sBase.ulNaks;
+    pStats->ulTimeouts -= sBase.ulTimeouts;
+    pStats->ulRecoveries -= sBase.ulRecoveries;
+    sBase = sNow;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           done
+//  Description:    Completion callback, records the transfer and the time
+///////////////////////////////////////////////////////////////////////////////
+static void done(I2C1_XFER* pXfer)
+{
+    if(uiDone < sizeof(pDone) / sizeof(pDone[0]))
+    {
+        pDone[uiDone] = pXfer;
+        ullDoneAt[uiDone] = simCycles;
+    }
+    uiDone++;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           bits
+//  Description:    SCL periods of a transfer on the bus: START, address and
+//                  write bytes, then RESTART, address and read bytes with
+//                  their ACK, and STOP
+///////////////////////////////////////////////////////////////////////////////
+static unsigned long bits(const I2C1_XFER* pXfer)
+{
+    unsigned long ulBits = 1 + 9 * (1 + pXfer->ucWriteCnt) + 1;
+
+    if(pXfer->ucReadCnt)
+        ulBits += 1 + 9 + 9 * pXfer->ucReadCnt;
+    return(ulBits);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           inBounds
+//  Description:    Tests a transfer time in cycles against its bus time
+///////////////////////////////////////////////////////////////////////////////
+static int inBounds(unsigned long long ullCycles, unsigned long ulBusCycles)
+{
+    return(ullCycles >= ulBusCycles && ullCycles <= ulBusCycles
+            + ulBusCycles * TIME_SLACK_PCT / 100 + TIME_SLACK_US * CYCLES_PER_US);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           queued
+//  Description:    A full queue of writes then reads of the same registers
+///////////////////////////////////////////////////////////////////////////////
+static void queued(unsigned int uiKhz)
+{
+    static char cWrite[I2C1_QUEUE_SIZE / 2][1 + XFER_BYTES];
+    static char cRead[I2C1_QUEUE_SIZE / 2][XFER_BYTES];
+    static char cReg[I2C1_QUEUE_SIZE / 2];
+    I2C1_XFER sXfer[I2C1_QUEUE_SIZE], sExtra;
+    unsigned long ulBitCycles = SIM_FCY / (uiKhz * 1000UL);
+    unsigned long long ullStart, ullPrev;
+    I2C1_STATS sStats;
+    unsigned int i, j, uiHalf = I2C1_QUEUE_SIZE / 2;
+    int iOk;
+
+    memset(ucRegs, 0, sizeof(ucRegs));
+    for(i = 0; i < uiHalf; i++)
+    {
+        cReg[i] = 0x10 * (i + 1);
+        cWrite[i][0] = cReg[i];
+        for(j = 0; j < XFER_BYTES; j++)
+            cWrite[i][1 + j] = (char)(uiKhz + 17 * i + j);
+
+        sXfer[i] = (I2C1_XFER){ .cAddr = DEV_ADDR, .pcWrite = cWrite[i],
+                .ucWriteCnt = 1 + XFER_BYTES, .pcRead = NULL, .ucReadCnt = 0,
+                .pfDone = done, .pvUser = NULL };
+        sXfer[uiHalf + i] = (I2C1_XFER){ .cAddr = DEV_ADDR, .pcWrite = &cReg[i],
+                .ucWriteCnt = 1, .pcRead = cRead[i], .ucReadCnt = XFER_BYTES,
+                .pfDone = done, .pvUser = NULL };
+    }
+    sExtra = sXfer[0];
+
+    uiDone = 0;
+    ullStart = simCycles;
+    for(i = 0; i < I2C1_QUEUE_SIZE; i++)
+    {
+        unsigned long long ullCall = simCycles;
+
+        check(submitI2C1(&sXfer[i]) == 1, "submit to a queue with room", uiKhz);
+        check(simCycles - ullCall <= SUBMIT_MAX_CYCLES, "submit returns at once", uiKhz);
+    }
+    check(submitI2C1(&sExtra) == 0, "submit to a full queue refused", uiKhz);
+    check(busyI2C1(), "engine busy after submit", uiKhz);
+    waitI2C1();
+
+    check(uiDone == I2C1_QUEUE_SIZE, "one callback per transfer", uiKhz);
+    for(i = 0, iOk = 1; i < uiDone && i < I2C1_QUEUE_SIZE; i++)
+        iOk &= (pDone[i] == &sXfer[i]) && sXfer[i].ucStatus == I2C_XFER_DONE;
+    check(iOk, "transfers done in submit order", uiKhz);
+
+    for(i = 0, iOk = 1; i < uiHalf; i++)
+        iOk &= memcmp(cRead[i], &cWrite[i][1], XFER_BYTES) == 0
+                && memcmp(&ucRegs[(unsigned char)cReg[i]], &cWrite[i][1], XFER_BYTES) == 0;
+    check(iOk, "bytes written and read back", uiKhz);
+
+    // back to back, each transfer takes from the end of the last one
+    ullPrev = ullStart;
+    for(i = 0, iOk = 1; i < uiDone && i < I2C1_QUEUE_SIZE; i++)
+    {
+        unsigned long ulBus = bits(&sXfer[i]) * ulBitCycles;
+
+        if(iVerbose)
+            printf("%4u kHz  xfer %u  %5lu us, bus %5lu us\n", uiKhz, i,
+                    (unsigned long)((ullDoneAt[i] - ullPrev) / CYCLES_PER_US),
+                    ulBus / CYCLES_PER_US);
+        iOk &= inBounds(ullDoneAt[i] - ullPrev, ulBus);
+        ullPrev = ullDoneAt[i];
+    }
+    check(iOk, "transfer times within bounds", uiKhz);
+
+    since(&sStats);
+    check(sStats.ulXfers == I2C1_QUEUE_SIZE && sStats.ulNaks == 0 && sStats.ulTimeouts == 0,
+            "statistics count the transfers", uiKhz);
+    check(sStats.ulMaxUs * CYCLES_PER_US <= bits(&sXfer[uiHalf]) * ulBitCycles
+            * (100 + TIME_SLACK_PCT) / 100 + TIME_SLACK_US * CYCLES_PER_US,
+            "statistics max time within bounds", uiKhz);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           nak
+//  Description:    A transfer to an absent address between two good ones
+///////////////////////////////////////////////////////////////////////////////
+static void nak(unsigned int uiKhz)
+{
+    static char cWrite[2] = { 0x40, 0x5A };
+    static char cRead[XFER_BYTES];
+    I2C1_XFER sXfer[3];
+    I2C1_STATS sStats;
+    unsigned int i;
+
+    for(i = 0; i < 3; i++)
+        sXfer[i] = (I2C1_XFER){ .cAddr = (i == 1)? ABSENT_ADDR : DEV_ADDR,
+                .pcWrite = cWrite, .ucWriteCnt = 2, .pcRead = (i == 2)? cRead : NULL,
+                .ucReadCnt = (i == 2)? 1 : 0, .pfDone = done, .pvUser = NULL };
+    sXfer[2].ucWriteCnt = 1;
+
+    uiDone = 0;
+    for(i = 0; i < 3; i++)
+        submitI2C1(&sXfer[i]);
+    waitI2C1();
+
+    since(&sStats);
+    check(uiDone == 3 && pDone[0] == &sXfer[0] && pDone[1] == &sXfer[1] && pDone[2] == &sXfer[2],
+            "NAK completes in order", uiKhz);
+    check(sXfer[0].ucStatus == I2C_XFER_DONE && sXfer[1].ucStatus == I2C_XFER_NAK
+            && sXfer[2].ucStatus == I2C_XFER_DONE, "NAK status, neighbours done", uiKhz);
+    check(cRead[0] == 0x5A, "bus usable after a NAK", uiKhz);
+    check(sStats.ulNaks == 1, "statistics count the NAK", uiKhz);
+
+    // the NAK ends the transfer after its address and a STOP
+    check(inBounds(ullDoneAt[1] - ullDoneAt[0], (1 + 9 + 1) * (SIM_FCY / (uiKhz * 1000UL))),
+            "NAK time within bounds", uiKhz);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           hang
+//  Description:    A slave that hangs the bus in a read, then a good one
+///////////////////////////////////////////////////////////////////////////////
+static void hang(unsigned int uiKhz)
+{
+    static char cReg = 0x40;
+    static char cRead[2][XFER_BYTES];
+    I2C1_XFER sXfer[2];
+    I2C1_STATS sStats;
+    unsigned long long ullSubmit;
+    unsigned long ulWindow;
+    unsigned int i;
+
+    for(i = 0; i < 2; i++)
+        sXfer[i] = (I2C1_XFER){ .cAddr = DEV_ADDR, .pcWrite = &cReg, .ucWriteCnt = 1,
+                .pcRead = cRead[i], .ucReadCnt = XFER_BYTES, .pfDone = done, .pvUser = NULL };
+
+    uiDone = 0;
+    ullSubmit = simCycles;
+    submitI2C1(&sXfer[0]);
+    submitI2C1(&sXfer[1]);
+    simI2C1Hang(5);
+    waitI2C1();
+
+    // armI2C1(): twice the bus time plus the stretch allowance, then up to
+    // 9 recovery clocks and a STOP at I2C1_RECOVER_US per half period
+    ulWindow = 2 * (9 * (XFER_BYTES + 1 + 2) + 4) * (SIM_FCY / (uiKhz * 1000UL))
+            + (I2C1_STRETCH_US + (2 * 9 + 3 + 1) * I2C1_RECOVER_US) * CYCLES_PER_US;
+
+    since(&sStats);
+    check(uiDone == 2 && sXfer[0].ucStatus == I2C_XFER_TIMEOUT
+            && sXfer[1].ucStatus == I2C_XFER_DONE, "hung transfer times out, next done", uiKhz);
+    check(sStats.ulXfers == 2 && sStats.ulTimeouts == 1 && sStats.ulRecoveries == 1,
+            "statistics count the timeout and recovery", uiKhz);
+    check(memcmp(cRead[1], ucRegs + 0x40, XFER_BYTES) == 0, "bus usable after recovery", uiKhz);
+    check(uiDone >= 1 && ullDoneAt[0] - ullSubmit <= ulWindow, "timeout within its window", uiKhz);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           lateHook
+//  Description:    Submits pLate once the first two transfers of mixed() are
+//                  done and the bus is owned again, i.e. by the blocking write,
+//                  as an ISR would
+///////////////////////////////////////////////////////////////////////////////
+static void lateHook(void)
+{
+    I2C1_XFER* pXfer = pLate;
+
+    // taken first, the submit's own register accesses run this hook again
+    if(pXfer && uiDone == 2 && simI2C1STAT.bits.S)
+    {
+        pLate = NULL;
+        submitI2C1(pXfer);
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           mixed
+//  Description:    A blocking write right after two queued transfers, and a
+//                  queued read of its registers submitted during it
+///////////////////////////////////////////////////////////////////////////////
+static void mixed(unsigned int uiKhz)
+{
+    static char cWrite[1 + XFER_BYTES] = { 0x60, 0x11, 0x22, 0x33, 0x44 };
+    static char cBlock[1 + XFER_BYTES] = { 0x60, 0x55, 0x66, 0x77, 0x00 };
+    static char cReg = 0x60;
+    static char cRead[2][XFER_BYTES];
+    I2C1_XFER sXfer[3];
+    I2C1_STATS sStats;
+    unsigned long ulCollisions = simI2C1Stats.ulCollisions;
+    unsigned int i;
+
+    for(i = 0; i < 3; i++)
+        sXfer[i] = (I2C1_XFER){ .cAddr = DEV_ADDR, .pcWrite = &cReg, .ucWriteCnt = 1,
+                .pcRead = (i > 0)? cRead[i - 1] : NULL, .ucReadCnt = (i > 0)? XFER_BYTES : 0,
+                .pfDone = done, .pvUser = NULL };
+    sXfer[0].pcWrite = cWrite;
+    sXfer[0].ucWriteCnt = sizeof(cWrite);
+
+    uiDone = 0;
+    submitI2C1(&sXfer[0]);
+    submitI2C1(&sXfer[1]);
+    pLate = &sXfer[2];
+    simHook = lateHook;
+    writeNI2C1(DEV_ADDR, cBlock, sizeof(cBlock));
+    check(statusI2C1() == I2C_XFER_DONE, "blocking write after queued ones done", uiKhz);
+    waitI2C1();
+    simHook = NULL;
+
+    check(pLate == NULL && uiDone == 3 && pDone[2] == &sXfer[2]
+            && sXfer[2].ucStatus == I2C_XFER_DONE, "transfer submitted during it done", uiKhz);
+    check(memcmp(cRead[0], cWrite + 1, XFER_BYTES) == 0, "queued read before the blocking write", uiKhz);
+    check(memcmp(cRead[1], cBlock + 1, XFER_BYTES) == 0, "queued read after the blocking write", uiKhz);
+    check(simI2C1Stats.ulCollisions == ulCollisions, "no START inside a transaction", uiKhz);
+
+    since(&sStats);
+    check(sStats.ulXfers == 4 && sStats.ulNaks == 0 && sStats.ulTimeouts == 0,
+            "statistics count the blocking and queued transfers", uiKhz);
+}
+
+int main(int argc, char** argv)
+{
+    unsigned int i;
+    int iOpt;
+
+    while((iOpt = getopt(argc, argv, "v")) != -1)
+    {
+        if(iOpt != 'v')
+        {
+            fprintf(stderr, "usage: %s [-v]\n", argv[0]);
+            return(2);
+        }
+        iVerbose = 1;
+    }
+
+    simI2C1Attach(&sDev);
+
+    for(i = 0; i < sizeof(uiSpeeds) / sizeof(uiSpeeds[0]); i++)
+    {
+        I2C1_Initialize(uiSpeeds[i]);
+        queued(uiSpeeds[i]);
+        nak(uiSpeeds[i]);
+        hang(uiSpeeds[i]);
+        mixed(uiSpeeds[i]);
+    }
+
+    printf("i2ccheck: %u checks, %u failed\n", uiChecks, uiFailed);
+    return(uiFailed? 1 : 0);
+}
@@ -0,0 +1,309 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+//  Filename:       replay.c
+//
+//  Description:    
+//  Host replayer of XZ traces (format in APIs/trace.h), built by 
+//  "make replay". The samples are fed at their recorded times to the same 
+//  cursor update the firmware runs, PAINT_Frame(), every CURSOR_MS of 
+//  simulated time; the output goes through term.c, uart2.c and the UART2 
+//  model at its real baud rate, so dropped output shows as it would on the
+//  board. Built with -DDEADZONE=... or -DMIDPOINT=... to try other tuning.
+//
+//  Usage:  replay [-b baud] [-c cursor_ms] [-f none|ma|ema|euro] 
+//                 [-o ansi_file] [-q] trace_file
+//
+//  -b sets the UART2 rate as a negotiation would (see APIs/baud.h), -c the 
+//  cursor update period, which scales the motion like the firmware does so
+//  the cursor keeps its speed.
+//
+//  The samples go through PAINT_Sample() and the filter chosen with -f,
+//  the firmware's default if none. The jitter of the raw and filtered 
+//  coordinates is reported as the mean absolute second difference, which
+//  follows steady motion and counts the noise around it.
+//
+//  Prints one CSV line per cursor update on stdout: time in ms, raw sample, 
+//  buttons, cursor row and column, bytes shifted out on U2TX since the 
+//  previous update and host processing time, 
+//  then a summary on stderr. The FNV-1a hash of the cursor path and of the
+//  output compares runs exactly.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include <xc.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "../APIs/trace.h"
+#include "../APIs/paint.h"
+#include "../APIs/uart2.h"
+#include "../APIs/XZsensor.h"
+#include "../APIs/filter.h"
+#include "../APIs/hal.h"
+
+#define FNV_BASIS   2166136261UL
+#define FNV_PRIME   16777619UL
+
+#define USAGE       "usage: %s [-b baud] [-c cursor_ms] [-f none|ma|ema|euro] [-o ansi_file] [-q] trace_file\n"
+
+static const char* const pszFilters[FILTER_COUNT] = { "none", "ma", "ema", "euro" };
+
+// second difference jitter of one coordinate
+typedef struct
+{
+    unsigned char ucY[2];           // last two values
+    unsigned long ulN;
+    unsigned long long ullSum;
+} JITTER;
+
+static FILE* pfAnsi = NULL;
+static unsigned long ulOutBytes = 0, ulOutHash = FNV_BASIS;
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           fnv
+//  Description:    FNV-1a step
+///////////////////////////////////////////////////////////////////////////////
+static unsigned long fnv(unsigned long ulHash, unsigned char ucByte)
+{
+    return(((ulHash ^ ucByte) * FNV_PRIME) & 0xFFFFFFFFUL);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           sink
+//  Description:    Bytes shifted out of U2TX
+///////////////////////////////////////////////////////////////////////////////
+static void sink(unsigned char ucByte)
+{
+    ulOutBytes++;
+    ulOutHash = fnv(ulOutHash, ucByte);
+    if(pfAnsi)
+        fputc(ucByte, pfAnsi);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           nsNow
+//  Description:    Host monotonic clock in nanoseconds
+///////////////////////////////////////////////////////////////////////////////
+static unsigned long long nsNow(void)
+{
+    struct timespec sNow;
+    
+    clock_gettime(CLOCK_MONOTONIC, &sNow);
+    return((unsigned long long)sNow.tv_sec * 1000000000ULL + sNow.tv_nsec);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           jitter / jitterMean
+//  Description:    Adds a value to the second difference jitter, reads it
+///////////////////////////////////////////////////////////////////////////////
+static void jitter(JITTER* pJ, unsigned char ucY)
+{
+    int iD2 = (int)ucY - 2 * pJ->ucY[1] + pJ->ucY[0];
+    
+    if(pJ->ulN++ >= 2)
+        pJ->ullSum += (iD2 < 0)? -iD2 : iD2;
+    pJ->ucY[0] = pJ->ucY[1];
+    pJ->ucY[1] = ucY;
+}
+
+static double jitterMean(const JITTER* pJ)
+{
+    return((pJ->ulN > 2)? (double)pJ->ullSum / (pJ->ulN - 2) : 0.0);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           loadTrace
+//  Description:    Reads a trace file and aligns it on the first magic, 
+//                  returns the records and their count
+///////////////////////////////////////////////////////////////////////////////
+static unsigned char* loadTrace(const char* pszPath, unsigned long* pulRecs)
+{
+    FILE* pf = fopen(pszPath, "rb");
+    unsigned char* puc = NULL;
+    unsigned long ulLen = 0, ulCap = 0, ulIn, ulOut, ulRecs = 0;
+    size_t n;
+    
+    if(!pf)
+    {
+        perror(pszPath);
+        exit(1);
+    }
+    do
+    {
+        if(ulLen == ulCap)
+        {
+            ulCap = ulCap? 2 * ulCap : 65536;
+            puc = realloc(puc, ulCap);
+        }
+        n = fread(puc + ulLen, 1, ulCap - ulLen, pf);
+        ulLen += n;
+    } while(n > 0);
+    fclose(pf);
+    
+    // skip anything before the first magic, then drop the repeated ones
+    for(ulIn = 0; ulIn + TRACE_MAGIC_LEN <= ulLen; ulIn++)
+        if(memcmp(puc + ulIn, TRACE_MAGIC, TRACE_MAGIC_LEN) == 0)
+            break;
+    
+    ulOut = 0;
+    while(ulIn + TRACE_MAGIC_LEN + TRACE_REC_LEN <= ulLen)
+    {
+        if(ulRecs % TRACE_SYNC_RECS == 0)
+        {
+            if(memcmp(puc + ulIn, TRACE_MAGIC, TRACE_MAGIC_LEN) != 0)
+            {
+                fprintf(stderr, "%s: lost alignment after %lu records\n", pszPath, ulRecs);
+                break;
+            }
+            ulIn += TRACE_MAGIC_LEN;
+        }
+        if(ulIn + TRACE_REC_LEN > ulLen)
+            break;
+        memmove(puc + ulOut, puc + ulIn, TRACE_REC_LEN);
+        ulIn += TRACE_REC_LEN;
+        ulOut += TRACE_REC_LEN;
+        ulRecs++;
+    }
+    
+    *pulRecs = ulRecs;
+    return(puc);
+}
+
+int main(int argc, char** argv)
+{
+    unsigned long ulBaud = UART2_BOOT_BAUD, ulCursorMs = 100, ulRecs, ulRec, ulSamples = 0, ulFrames = 0, ulLost = 0;
+    unsigned long long ullMs = 0, ullNextFrame, ullNs, ullNsTotal = 0, ullNsMax = 0, ullNsFilter = 0;
+    unsigned long ulPathHash = FNV_BASIS, ulBytes = 0, ulMoves = 0;
+    unsigned char* pucRec;
+    unsigned char x = MIDPOINT, z = MIDPOINT, ucHits = 0, ucRow, ucCol, ucLastRow, ucLastCol;
+    unsigned char ucButtons, ucHeld = 0;
+    int iQuiet = 0, iOpt, i;
+    FILTER_AXIS sxFilter = { 0 }, szFilter = { 0 };
+    JITTER sRaw[2] = { { { 0 } } }, sFiltered[2] = { { { 0 } } };
+    
+    while((iOpt = getopt(argc, argv, "b:c:f:o:q")) != -1)
+    {
+        switch(iOpt)
+        {
+            case 'b': ulBaud = strtoul(optarg, NULL, 10); break;
+            case 'c': ulCursorMs = strtoul(optarg, NULL, 10); break;
+            case 'f':
+                for(i = 0; i < FILTER_COUNT && strcmp(optarg, pszFilters[i]); i++)
+                    ;
+                if(i == FILTER_COUNT)
+                {
+                    fprintf(stderr, USAGE, argv[0]);
+                    return(2);
+                }
+                FILTER_Select(i);
+                break;
+            case 'o': 
+                pfAnsi = fopen(optarg, "wb");
+                if(!pfAnsi)
+                {
+                    perror(optarg);
+                    return(1);
+                }
+                break;
+            case 'q': iQuiet = 1; break;
+            default:
+                fprintf(stderr, USAGE, argv[0]);
+                return(2);
+        }
+    }
+    if(optind != argc - 1 || ulCursorMs == 0 || ulBaud < 300)
+    {
+        fprintf(stderr, USAGE, argv[0]);
+        return(2);
+    }
+    
+    pucRec = loadTrace(argv[optind], &ulRecs);
+    
+    simUART2Sink = sink;
+    UART2_Initialize();
+    setBaudUART2(ulBaud);
+    PAINT_SetPeriod(ulCursorMs);
+    PAINT_Initialize();
+    PAINT_Cursor(&ucLastRow, &ucLastCol);
+    ullNextFrame = ulCursorMs;
+    
+    if(!iQuiet)
+        printf("ms,x,z,buttons,row,col,bytes,ns\n");
+    
+    for(ulRec = 0; ulRec < ulRecs; ulRec++)
+    {
+        ullMs += pucRec[ulRec * TRACE_REC_LEN];
+        
+        // cursor updates due before the record, on the samples so far
+        while(ullNextFrame <= ullMs)
+        {
+            simAdvance((unsigned long)((ullNextFrame * (SIM_FCY / 1000)) - simCycles));
+            
+            ullNs = nsNow();
+            PAINT_Frame(ucHits);
+            ullNs = nsNow() - ullNs;
+            
+            PAINT_Cursor(&ucRow, &ucCol);
+            if(ucRow != ucLastRow || ucCol != ucLastCol)
+                ulMoves++;
+            ucLastRow = ucRow;
+            ucLastCol = ucCol;
+            ulPathHash = fnv(fnv(ulPathHash, ucRow), ucCol);
+            ullNsTotal += ullNs;
+            if(ullNs > ullNsMax)
+                ullNsMax = ullNs;
+            ulFrames++;
+            
+            if(!iQuiet)
+                printf("%llu,%u,%u,%u,%u,%u,%lu,%llu\n", ullNextFrame, x, z, ucHits, ucRow, ucCol, ulOutBytes - ulBytes, ullNs);
+            ucHits = 0;
+            ulBytes = ulOutBytes;
+            ullNextFrame += ulCursorMs;
+        }
+        
+        if(pucRec[ulRec * TRACE_REC_LEN + 3] & TRACE_F_LOST)
+            ulLost++;
+        if(pucRec[ulRec * TRACE_REC_LEN + 3] & TRACE_F_GAP)
+            continue;
+        
+        x = pucRec[ulRec * TRACE_REC_LEN + 1];
+        z = pucRec[ulRec * TRACE_REC_LEN + 2];
+        // S3 acts once per press, like in the firmware's button task
+        ucButtons = pucRec[ulRec * TRACE_REC_LEN + 3] & TRACE_F_BUTTONS;
+        ucHits |= ucButtons & ~(ucHeld & HAL_BTN_S3);
+        ucHeld = ucButtons;
+        ulSamples++;
+        
+        PAINT_Sample(x, z);
+        
+        // the same filter again on separate state, timed and measured
+        ullNs = nsNow();
+        jitter(&sFiltered[0], FILTER_Apply(&sxFilter, x));
+        jitter(&sFiltered[1], FILTER_Apply(&szFilter, z));
+        ullNsFilter += nsNow() - ullNs;
+        jitter(&sRaw[0], x);
+        jitter(&sRaw[1], z);
+    }
+    
+    // let the UART finish
+    txFlushUART2();
+    simAdvance(SIM_FCY / 100);
+    if(pfAnsi)
+        fclose(pfAnsi);
+    
+    fprintf(stderr, "%lu samples (%lu with records lost before), %.3f s, %lu cursor updates every %lu ms\n",
+            ulSamples, ulLost, ullMs / 1000.0, ulFrames, ulCursorMs);
+    fprintf(stderr, "output %lu bytes, %.2f per update, %lu dropped\n",
+            ulOutBytes, ulFrames? (double)ulOutBytes / ulFrames : 0.0, txDroppedUART2());
+    fprintf(stderr, "processing %.0f ns per update (max %llu), %.0f ns per sample\n",
+            ulFrames? (double)ullNsTotal / ulFrames : 0.0, ullNsMax,
+            ulSamples? (double)ullNsTotal / ulSamples : 0.0);
+    fprintf(stderr, "filter %s: %.0f ns per sample, jitter x %.3f -> %.3f, z %.3f -> %.3f; cursor moved in %lu updates\n",
+            pszFilters[FILTER_Selected()], ulSamples? (double)ullNsFilter / ulSamples : 0.0,
+            jitterMean(&sRaw[0]), jitterMean(&sFiltered[0]), jitterMean(&sRaw[1]), jitterMean(&sFiltered[1]), ulMoves);
+    fprintf(stderr, "path hash %08lx, output hash %08lx\n", ulPathHash, ulOutHash);
+    
+    return(0);
+}
@@ -0,0 +1,349 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+//  Filename:       ringcheck.c
+//
+//  Description:
+//  Host stress test of the UART2 Rx and Tx rings (APIs/uart2.c), built by
+//  "make ringcheck" and run by "make check". The ISRs run on their own
+//  thread against registers defined here instead of the sim/ models, which
+//  are not thread safe: the ISR thread is the UART, it feeds received bytes
+//  to _U2RXInterrupt() and shifts out what _U2TXInterrupt() loads. The main
+//  thread fills the Tx ring with outBytes() and a consumer thread empties
+//  the Rx ring with inBytes() and inChar(), both at full rate, so each ring
+//  has its producer and consumer on two threads at once, on two cores if
+//  the host has them. A thread with nothing to do yields.
+//
+//  The ISR thread takes the Tx interrupt whenever the hardware buffer has
+//  room, whatever U2TXIE says: a second core cannot stand in for the
+//  atomicity of an interrupt, which the U2TXIE handshake relies on. That
+//  handshake runs in make sim and make replay.
+//
+//  Each pass sends RING_BYTES both ways, paced, so neither ring may drop a
+//  byte, then flat out. Checked: the bytes come out in order, none lost or
+//  duplicated, and rxOverrunsUART2() counts exactly the bytes the Rx ring
+//  refused plus the hardware overruns, which the UART thread makes every
+//  OERR_EVERY bytes; txDroppedUART2() counts exactly the refused blocks.
+//
+//  Usage:  ringcheck
+//
+//  Exits with 1 if a check failed.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include <xc.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "../APIs/uart2.h"
+
+#define RING_BYTES  (1UL << 22)     // bytes sent each way in a pass
+#define BLOCK_MAX   32              // longest outBytes() block
+#define OERR_EVERY  4099            // a hardware overrun every so many bytes
+
+// as in sim_uart2.c, a 0xFF byte is written as 0xFFFF
+#define TXREG_EMPTY 0x8000
+#define HW_FIFO     4
+
+// registers of the UART, only the thread running the ISRs steps them
+volatile SIM_UMODE simU2MODE;
+volatile SIM_USTA simU2STA;
+volatile uint16_t simU2BRG, simU2TXREG = TXREG_EMPTY;
+volatile SIM_IFS1 simIFS1;
+volatile SIM_IEC1 simIEC1;
+
+// the ISRs, defined by uart2.c
+void _U2RXInterrupt(void);
+void _U2TXInterrupt(void);
+
+static __thread int iUart = 0;      // set on the thread running the ISRs
+
+// hardware Rx and Tx buffers
+static unsigned char ucRxHw[HW_FIFO];
+static int iRxHw = 0;
+static unsigned char ucTxHw[HW_FIFO];
+static int iTxHw = 0;
+
+// one pass: what each side sent and got, the counts shared by the threads
+typedef struct
+{
+    int iPaced;
+    unsigned char* pucRxSent;       // bytes the Rx ring took, in order
+    unsigned char* pucRxGot;        // bytes inBytes() and inChar() returned
+    unsigned long ulRxSent, ulRxGot, ulRxRefused, ulRxHwOverruns;
+    unsigned char* pucTxSent;       // bytes outBytes() took, in order
+    unsigned char* pucTxGot;        // bytes shifted out of U2TX
+    unsigned long ulTxSent, ulTxGot, ulTxRefused;
+    volatile int iRxDone, iTxDone;
+} PASS;
+
+static PASS sPass;
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           simAccess
+//  Description:    SFR access: on the UART thread a byte written to U2TXREG
+//                  moves into the hardware Tx buffer
+///////////////////////////////////////////////////////////////////////////////
+void simAccess(void)
+{
+    if(!iUart || simU2TXREG == TXREG_EMPTY)
+        return;
+    if(iTxHw < HW_FIFO)
+        ucTxHw[iTxHw++] = simU2TXREG & 0xFF;
+    simU2TXREG = TXREG_EMPTY;
+    simU2STA.bits.UTXBF = (iTxHw == HW_FIFO);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           simUART2Read
+//  Description:    U2RXREG: pops the hardware Rx buffer
+///////////////////////////////////////////////////////////////////////////////
+uint16_t simUART2Read(void)
+{
+    unsigned char ucByte = ucRxHw[0];
+
+    if(iRxHw > 0)
+    {
+        memmove(ucRxHw, ucRxHw + 1, --iRxHw);
+        simU2STA.bits.URXDA = (iRxHw > 0);
+    }
+    return(ucByte);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           pattern
+//  Description:    Byte <ulN> of a stream, no short period
+///////////////////////////////////////////////////////////////////////////////
+static unsigned char pattern(unsigned long ulN)
+{
+    return((ulN ^ (ulN >> 8) ^ (ulN >> 16) ^ (ulN * 7)) & 0xFF);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           nsNow
+//  Description:    Host monotonic clock in nanoseconds
+///////////////////////////////////////////////////////////////////////////////
+static unsigned long long nsNow(void)
+{
+    struct timespec sNow;
+
+    clock_gettime(CLOCK_MONOTONIC, &sNow);
+    return((unsigned long long)sNow.tv_sec * 1000000000ULL + sNow.tv_nsec);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           uart
+//  Description:    The UART and its ISRs: receives one byte at a time, then
+//                  shifts out what the Tx ring holds
+///////////////////////////////////////////////////////////////////////////////
+static void* uart(void* pv)
+{
+    PASS* p = pv;
+    unsigned long ulN = 0, ulOverruns;
+    unsigned char ucByte;
+    int iIdle;
+
+    iUart = 1;
+
+    while(!p->iRxDone || !p->iTxDone || txFreeUART2() < TX_FIFO_SIZE || iTxHw > 0)
+    {
+        iIdle = 1;
+        if(ulN < RING_BYTES && (!p->iPaced || rxCountUART2() < FIFO_SIZE))
+        {
+            iIdle = 0;
+            ulOverruns = rxOverrunsUART2();
+            if(ulN % OERR_EVERY == OERR_EVERY - 1)
+            {
+                // the byte is lost in the UART, the ISR finds OERR set
+                simU2STA.bits.OERR = 1;
+                p->ulRxHwOverruns++;
+                _U2RXInterrupt();
+            }
+            else
+            {
+                ucByte = pattern(ulN);
+                ucRxHw[iRxHw++] = ucByte;
+                simU2STA.bits.URXDA = 1;
+                _U2RXInterrupt();
+                if(rxOverrunsUART2() == ulOverruns)
+                    p->pucRxSent[p->ulRxSent++] = ucByte;
+                else
+                    p->ulRxRefused++;
+            }
+            if(++ulN == RING_BYTES)
+                p->iRxDone = 1;
+        }
+
+        if(!simU2STA.bits.UTXBF)
+        {
+            _U2TXInterrupt();
+            simAccess();
+        }
+
+        // the shift register takes the oldest byte
+        if(iTxHw > 0)
+        {
+            p->pucTxGot[p->ulTxGot++] = ucTxHw[0];
+            memmove(ucTxHw, ucTxHw + 1, --iTxHw);
+            simU2STA.bits.UTXBF = 0;
+            iIdle = 0;
+        }
+        if(iIdle)
+            sched_yield();
+    }
+    return(NULL);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           consumer
+//  Description:    Empties the Rx ring, in blocks and by single bytes
+///////////////////////////////////////////////////////////////////////////////
+static void* consumer(void* pv)
+{
+    PASS* p = pv;
+    unsigned int uiSize = 1, uiGot;
+    int iDone;
+
+    for(;;)
+    {
+        // read the flag first, the bytes sent before it are in the ring
+        iDone = p->iRxDone;
+        if(rxCountUART2() > 0 && (uiSize & 3) == 0)
+        {
+            p->pucRxGot[p->ulRxGot++] = inChar();
+            uiGot = 1;
+        }
+        else
+        {
+            uiGot = inBytes((char*)p->pucRxGot + p->ulRxGot, uiSize);
+            p->ulRxGot += uiGot;
+        }
+        uiSize = uiSize % (FIFO_SIZE + 3) + 1;
+
+        if(!uiGot && iDone && rxCountUART2() == 0)
+            break;
+        if(!uiGot)
+            sched_yield();
+    }
+    return(NULL);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           producer
+//  Description:    Fills the Tx ring with blocks of 1 to BLOCK_MAX bytes
+///////////////////////////////////////////////////////////////////////////////
+static void producer(PASS* p)
+{
+    unsigned char ucBlock[BLOCK_MAX];
+    unsigned long ulN = 0;
+    unsigned int uiCnt = 1, i;
+
+    while(ulN < RING_BYTES)
+    {
+        if(uiCnt > RING_BYTES - ulN)
+            uiCnt = RING_BYTES - ulN;
+        for(i = 0; i < uiCnt; i++)
+            ucBlock[i] = pattern(ulN + i);
+
+        if(p->iPaced)
+            while(txFreeUART2() < uiCnt)
+                sched_yield();
+
+        if(outBytes((const char*)ucBlock, uiCnt) == uiCnt)
+        {
+            memcpy(p->pucTxSent + p->ulTxSent, ucBlock, uiCnt);
+            p->ulTxSent += uiCnt;
+        }
+        else
+            p->ulTxRefused += uiCnt;
+
+        ulN += uiCnt;
+        uiCnt = uiCnt % BLOCK_MAX + 1;
+    }
+    p->iTxDone = 1;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           pass
+//  Description:    Runs a pass and checks it, returns the failures
+///////////////////////////////////////////////////////////////////////////////
+static int pass(int iPaced)
+{
+    PASS* p = &sPass;
+    pthread_t tUart, tConsumer;
+    unsigned long ulOverruns = rxOverrunsUART2(), ulDropped = txDroppedUART2();
+    unsigned long long ullNs = nsNow();
+    int iFailed = 0;
+
+    memset(p, 0, sizeof(*p));
+    p->iPaced = iPaced;
+    p->pucRxSent = malloc(RING_BYTES);
+    p->pucRxGot = malloc(RING_BYTES);
+    p->pucTxSent = malloc(RING_BYTES);
+    p->pucTxGot = malloc(RING_BYTES);
+
+    pthread_create(&tUart, NULL, uart, p);
+    pthread_create(&tConsumer, NULL, consumer, p);
+    producer(p);
+    pthread_join(tConsumer, NULL);
+    pthread_join(tUart, NULL);
+
+    ullNs = nsNow() - ullNs;
+    ulOverruns = rxOverrunsUART2() - ulOverruns;
+    ulDropped = txDroppedUART2() - ulDropped;
+
+    printf("%-8s Rx %lu got, %lu refused, %lu hardware overruns; "
+            "Tx %lu got, %lu refused; %.1f Mbyte/s each way\n",
+            iPaced? "paced" : "flat out", p->ulRxGot, p->ulRxRefused,
+            p->ulRxHwOverruns, p->ulTxGot, p->ulTxRefused,
+            RING_BYTES * 1e3 / ullNs);
+
+    if(p->ulRxGot != p->ulRxSent || memcmp(p->pucRxGot, p->pucRxSent, p->ulRxSent))
+    {
+        printf("FAIL: Rx bytes lost, duplicated or out of order\n");
+        iFailed++;
+    }
+    if(ulOverruns != p->ulRxRefused + p->ulRxHwOverruns
+       || p->ulRxSent + ulOverruns != RING_BYTES)
+    {
+        printf("FAIL: Rx overrun counter %lu, expected %lu\n", ulOverruns,
+                RING_BYTES - p->ulRxSent);
+        iFailed++;
+    }
+    if(iPaced && p->ulRxRefused)
+    {
+        printf("FAIL: Rx ring refused bytes with room\n");
+        iFailed++;
+    }
+    if(p->ulTxGot != p->ulTxSent || memcmp(p->pucTxGot, p->pucTxSent, p->ulTxSent))
+    {
+        printf("FAIL: Tx bytes lost, duplicated or out of order\n");
+        iFailed++;
+    }
+    if(ulDropped != p->ulTxRefused || (iPaced && ulDropped))
+    {
+        printf("FAIL: Tx drop counter %lu, expected %lu\n", ulDropped, p->ulTxRefused);
+        iFailed++;
+    }
+
+    free(p->pucRxSent);
+    free(p->pucRxGot);
+    free(p->pucTxSent);
+    free(p->pucTxGot);
+    return(iFailed);
+}
+
+int main(void)
+{
+    int iFailed;
+
+    UART2_Initialize();
+    simU2TXREG = TXREG_EMPTY;
+    iFailed = pass(1);
+    iFailed += pass(0);
+
+    printf("ringcheck: %d failed\n", iFailed);
+    return(iFailed? 1 : 0);
+}
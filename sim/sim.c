@@ -0,0 +1,177 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+//  Filename:       sim.c
+//
+//  Description:    
+//  Simulated instruction clock, interrupt controller and oscillator. 
+//  Interrupts are taken one at a time, in vector order, whenever both the
+//  flag and the enable bit of a source are set and the CPU priority is 0;
+//  ISRs the firmware does not define are resolved as weak symbols and
+//  skipped. The clock runs at SIM_FCY whatever the oscillator registers
+//  select.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include <xc.h>
+#include <stddef.h>
+
+unsigned long long simCycles = 0;
+void (*simHook)(void) = NULL;
+
+// oscillator registers, running from FRCPLL out of reset
+volatile SIM_OSCCON simOSCCON = { 0x1120 };
+volatile uint16_t simCLKDIV, simOSCTUN;
+
+// CPU status, IPL is 0 in main and left at 0 by the ISRs
+volatile SIM_SR simSR;
+
+// interrupt controller registers
+volatile SIM_INTCON2 simINTCON2;
+volatile SIM_IFS0 simIFS0;
+volatile SIM_IEC0 simIEC0;
+volatile SIM_IPC0 simIPC0;
+volatile SIM_IFS1 simIFS1;
+volatile SIM_IEC1 simIEC1;
+volatile SIM_IPC4 simIPC4;
+volatile SIM_IPC5 simIPC5;
+volatile SIM_IPC6 simIPC6;
+
+// set while an ISR runs, interrupts do not nest in the simulation
+static int iInIsr = 0;
+
+// interrupt service routines, defined by the firmware
+extern void _INT0Interrupt(void) __attribute__((weak));
+extern void _T1Interrupt(void) __attribute__((weak));
+extern void _MI2C1Interrupt(void) __attribute__((weak));
+extern void _CNInterrupt(void) __attribute__((weak));
+extern void _INT1Interrupt(void) __attribute__((weak));
+extern void _T4Interrupt(void) __attribute__((weak));
+extern void _U2RXInterrupt(void) __attribute__((weak));
+extern void _U2TXInterrupt(void) __attribute__((weak));
+
+// interrupt sources in natural (vector) order
+typedef struct
+{
+    volatile uint16_t* puiFlag;
+    volatile uint16_t* puiEnable;
+    uint16_t uiMask;
+    void (*pfIsr)(void);
+} SIM_VECTOR;
+
+static const SIM_VECTOR sVectors[] =
+{
+    { &simIFS0.w, &simIEC0.w, 1 << 0, _INT0Interrupt },
+    { &simIFS0.w, &simIEC0.w, 1 << 3, _T1Interrupt },
+    { &simIFS1.w, &simIEC1.w, 1 << 1, _MI2C1Interrupt },
+    { &simIFS1.w, &simIEC1.w, 1 << 3, _CNInterrupt },
+    { &simIFS1.w, &simIEC1.w, 1 << 4, _INT1Interrupt },
+    { &simIFS1.w, &simIEC1.w, 1 << 11, _T4Interrupt },
+    { &simIFS1.w, &simIEC1.w, 1 << 14, _U2RXInterrupt },
+    { &simIFS1.w, &simIEC1.w, 1 << 15, _U2TXInterrupt },
+};
+
+#define SIM_VECTOR_CNT (sizeof(sVectors) / sizeof(sVectors[0]))
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           dispatch
+//  Description:    Runs the first pending, enabled ISR. Returns 1 if one ran.
+//                  Every source of the firmware has a priority of 1 to 5,
+//                  so a raised CPU IPL holds them all off; the firmware
+//                  only ever raises it to 7.
+///////////////////////////////////////////////////////////////////////////////
+static int dispatch(void)
+{
+    unsigned int i;
+    
+    if(iInIsr || simSR.bits.IPL)
+        return(0);
+    
+    for(i = 0; i < SIM_VECTOR_CNT; i++)
+    {
+        if((*sVectors[i].puiFlag & *sVectors[i].puiEnable & sVectors[i].uiMask)
+                && sVectors[i].pfIsr)
+        {
+            iInIsr = 1;
+            sVectors[i].pfIsr();
+            iInIsr = 0;
+            return(1);
+        }
+    }
+    return(0);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           tick
+//  Description:    Advances the clock and lets every peripheral model catch up
+///////////////////////////////////////////////////////////////////////////////
+static int tick(unsigned long ulCycles)
+{
+    simCycles += ulCycles;
+    simTimerStep();
+    simPortStep();
+    simI2C1Step();
+    simXZStep();
+    simVLStep();
+    simUART2Step();
+    if(simHook)
+        simHook();
+    return(dispatch());
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           simAccess
+//  Description:    Charges one SFR access, called through SIM_SFR()
+///////////////////////////////////////////////////////////////////////////////
+void simAccess(void)
+{
+    tick(SIM_ACCESS_CYCLES);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           simAdvance
+//  Description:    Lets <ulCycles> instruction cycles pass, e.g. __delay32()
+///////////////////////////////////////////////////////////////////////////////
+void simAdvance(unsigned long ulCycles)
+{
+    while(ulCycles > SIM_QUANTUM)
+    {
+        tick(SIM_QUANTUM);
+        ulCycles -= SIM_QUANTUM;
+    }
+    tick(ulCycles);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           simIdle
+//  Description:    Idle(): sleeps until an interrupt has been serviced. Gives
+//                  up after one simulated second if nothing is enabled.
+///////////////////////////////////////////////////////////////////////////////
+void simIdle(void)
+{
+    unsigned long long ullEnd = simCycles + SIM_FCY;
+    
+    while(!tick(SIM_QUANTUM) && simCycles < ullEnd);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           simWriteOSCCONH / simWriteOSCCONL
+//  Description:    __builtin_write_OSCCONH/L(), a clock switch requested 
+//                  with OSWEN completes at once and the PLL is locked
+///////////////////////////////////////////////////////////////////////////////
+void simWriteOSCCONH(uint8_t ucValue)
+{
+    simAccess();
+    simOSCCON.w = (simOSCCON.w & 0x00FF) | ((uint16_t)ucValue << 8);
+}
+
+void simWriteOSCCONL(uint8_t ucValue)
+{
+    simAccess();
+    simOSCCON.w = (simOSCCON.w & 0xFF00) | ucValue;
+    if(simOSCCON.bits.OSWEN)
+    {
+        simOSCCON.bits.COSC = simOSCCON.bits.NOSC;
+        simOSCCON.bits.OSWEN = 0;
+    }
+    simOSCCON.bits.LOCK = 1;
+}
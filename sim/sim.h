@@ -0,0 +1,144 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+//  Filename:       sim.h
+//
+//  Description:    
+//  Host simulation of the PIC24FJ128GA010 peripherals used by Terminal Paint.
+//  Time is counted in instruction cycles at SIM_FCY. The firmware advances
+//  it implicitly through SFR accesses (see xc.h), __delay32() and Idle();
+//  host code advances it explicitly with simAdvance().
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef SIM_H
+#define SIM_H
+
+#include <stdint.h>
+
+#define SIM_FCY             16000000UL  // simulated instruction clock
+#define SIM_ACCESS_CYCLES   2           // cycles charged per SFR access
+#define SIM_QUANTUM         8           // step size used by simAdvance()
+
+// elapsed instruction cycles since reset
+extern unsigned long long simCycles;
+
+// optional host code run at every step of the models, e.g. to script the
+// push buttons or stop the simulation
+extern void (*simHook)(void);
+
+// core
+void simAccess(void);
+void simAdvance(unsigned long ulCycles);
+void simIdle(void);
+
+//////////////////////////////// Timer Model ///////////////////////////////////
+
+void simTimerStep(void);
+
+///////////////////////////////// Port Model ///////////////////////////////////
+
+void simPortStep(void);
+
+/////////////////////////////// I2C1 Bus Model ////////////////////////////////
+
+// Slave device on the simulated I2C1 bus. A write sets the register pointer
+// from the first ucRegWidth bytes (MSB first) and stores the rest from there
+// with auto-increment; a read returns bytes from the register pointer on.
+// pfRead/pfWrite are optional hooks run instead of the plain register array.
+typedef struct SIM_I2C_DEV SIM_I2C_DEV;
+
+struct SIM_I2C_DEV
+{
+    unsigned char ucAddr;           // address with the R/W bit clear
+    unsigned char ucRegWidth;       // 1 or 2 register pointer bytes
+    unsigned char* pucRegs;         // register file
+    unsigned int uiRegCnt;          // size of the register file
+    unsigned char (*pfRead)(SIM_I2C_DEV* pDev, unsigned int uiReg);
+    void (*pfWrite)(SIM_I2C_DEV* pDev, unsigned int uiReg, unsigned char ucData);
+    void* pvUser;
+    unsigned long long* pullBusy;   // optional, counts the bus cycles of the
+                                    // transactions addressed to the device
+    
+    // bus state kept by the model
+    unsigned int uiPtr;
+    unsigned char ucPtrBytes;
+    SIM_I2C_DEV* pNext;
+};
+
+// bus activity counters
+typedef struct
+{
+    unsigned long ulStarts;         // START and RESTART conditions
+    unsigned long ulBytes;          // bytes on the bus, addresses included
+    unsigned long ulNaks;           // bytes not acknowledged by a slave
+    unsigned long ulHangs;          // times a slave hung the bus
+    unsigned long ulRecoveryClocks; // SCL pulses sent by hand, module off
+    unsigned long ulCollisions;     // STARTs asked for inside a transaction
+    unsigned long long ullBusy;     // cycles the bus was not idle
+} SIM_I2C_STATS;
+
+extern SIM_I2C_STATS simI2C1Stats;
+
+void simI2C1Attach(SIM_I2C_DEV* pDev);
+void simI2C1Hang(unsigned int uiClocks);
+void simI2C1Step(void);
+
+////////////////////////////// XZ Sensor Model /////////////////////////////////
+
+// Coordinate source of the simulated XZ sensor, called at the sensor's 
+// sample rate to produce the next X and Z position. Holds still at the 
+// center when not set.
+extern void (*simXZSource)(unsigned char* pucX, unsigned char* pucZ);
+
+void simXZAttach(unsigned long ulRateHz);
+void simXZSetRate(unsigned long ulRateHz);
+void simXZStep(void);
+
+// sensor activity counters
+typedef struct
+{
+    unsigned long ulSamples;        // samples produced
+    unsigned long ulReads;          // coordinate reads by the master
+    unsigned long ulStaleReads;     // reads that returned an already read sample
+    unsigned long long ullWaitMax;  // longest time from DR high to the read
+    unsigned long long ullBusy;     // bus cycles of the transactions to it
+} SIM_XZ_STATS;
+
+extern SIM_XZ_STATS simXZStats;
+
+//////////////////////////// VL6180 Sensor Model //////////////////////////////
+
+// Range source of the simulated VL6180, called at each measurement for the
+// distance of the hand in mm, 0xFF when there is none. No target when not 
+// set.
+extern unsigned char (*simVLSource)(void);
+
+void simVLAttach(void);
+void simVLStep(void);
+
+// sensor activity counters
+typedef struct
+{
+    unsigned long ulSamples;        // measurements made
+    unsigned long ulOverruns;       // ... while the last one was not cleared
+    unsigned long long ullBusy;     // bus cycles of the transactions to it
+} SIM_VL_STATS;
+
+extern SIM_VL_STATS simVLStats;
+
+/////////////////////////////// UART2 Model ///////////////////////////////////
+
+// bytes shifted out of U2TX go to this function, stdout when not set
+extern void (*simUART2Sink)(unsigned char ucByte);
+
+// bytes shifted out of U2TX since reset
+extern unsigned long simUART2TxBytes;
+
+// baud rate of the terminal end, 0 when it always matches the UART's
+extern unsigned long simUART2PeerBaud;
+
+void simUART2Receive(unsigned char ucByte);
+uint16_t simUART2Read(void);
+void simUART2Step(void);
+
+#endif  // SIM_H
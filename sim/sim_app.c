@@ -0,0 +1,382 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+//  Filename:       sim_app.c
+//
+//  Description:    
+//  Host side of the Terminal Paint simulation built by "make sim". Before 
+//  the firmware's main() runs, the XZ sensor and VL6180 models are attached
+//  to the I2C1 bus and fed a scripted hand movement while the push buttons
+//  are pressed on cue. The ANSI output of U2TX goes to stdout and bytes on stdin are 
+//  received on U2RX, e.g. 'r' repaints the canvas. A summary is printed on
+//  stderr when the run ends.
+//
+//  The terminal starts at UART2_BOOT_BAUD. With SIM_BAUD set it also takes
+//  part in the rate negotiation of APIs/baud.h up to that rate, otherwise
+//  it ignores the proposals like a plain terminal.
+//
+//  Environment:    SIM_SECONDS     simulated run time, default 20 s
+//                  SIM_XZ_HZ       sensor sample rate, default 100 Hz
+//                  SIM_REALTIME    1 paces the run to the wall clock so it
+//                                  can be watched in a terminal
+//                  SIM_BAUD        highest rate the terminal accepts
+//                  SIM_BAUD_STUCK  1 accepts but stays at the boot rate, 
+//                                  so the check fails
+//                  SIM_I2C_HANG    time in ms at which the XZ sensor hangs
+//                                  the I2C1 bus, once
+//                  SIM_RANGE_PEN   1 lowers the hand over the VL6180 for
+//                                  the pen steps instead of pressing S4,
+//                                  for a build with RANGE_AXIS_PEN
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include <xc.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include "../APIs/XZsensor.h"
+#include "../APIs/uart2.h"
+#include "../APIs/baud.h"
+#include "../APIs/i2c1.h"
+#include "../APIs/button.h"
+#include "../APIs/range.h"
+
+#define MS_CYCLES   (SIM_FCY / 1000)
+
+// SCL clocks the hung sensor needs to let SDA go, the rest of a byte
+#define HANG_CLOCKS 5
+
+// hand positions: far enough from MIDPOINT to leave the dead zone
+#define LO          (MIDPOINT - 2 * DEADZONE)
+#define MID         MIDPOINT
+#define HI          (MIDPOINT + 2 * DEADZONE)
+
+// pressed buttons
+#define PEN         0x01    // S4, draw
+#define ERASER      0x02    // S5, erase
+
+// hand over the VL6180 in mm: lowered for the pen, raised or away
+#define LOWERED     40
+#define RAISED      200
+#define AWAY        RANGE_NONE
+
+// one step of the script: hand position and buttons held for ulMs
+typedef struct
+{
+    unsigned long ulMs;
+    unsigned char ucX, ucZ;
+    unsigned char ucMm;     // height over the VL6180 with SIM_RANGE_PEN
+    unsigned char ucButtons;
+    char cKey;              // sent on U2RX when the step starts, 0 if none
+} SIM_STEP;
+
+// a box, a diagonal, part of the diagonal erased again, the box filled
+// from the cursor and a repaint
+static const SIM_STEP sScript[] =
+{
+    { 1000, MID, MID, AWAY,    0,      0   },
+    { 4000, HI,  MID, LOWERED, PEN,    0   },
+    { 2000, MID, LO,  LOWERED, PEN,    0   },
+    { 4000, LO,  MID, LOWERED, PEN,    0   },
+    { 2000, MID, HI,  LOWERED, PEN,    0   },
+    { 2000, HI,  LO,  LOWERED, PEN,    0   },
+    { 1000, LO,  HI,  RAISED,  ERASER, 0   },
+    { 500,  MID, MID, AWAY,    0,      0   },
+    { 1000, MID, MID, AWAY,    0,      'f' },
+    { 2500, MID, MID, AWAY,    0,      'r' },
+};
+
+#define SIM_STEP_CNT (sizeof(sScript) / sizeof(sScript[0]))
+
+static unsigned int uiStep = 0;
+static unsigned long long ullStepEnd = 0, ullEnd = 0, ullNextMs = 0;
+static int iRealtime = 0;
+static struct timespec sStart;
+static int iStdinFlags = -1;
+static unsigned long long ullHangAt = 0;
+static int iRangePen = 0;
+
+// negotiating terminal: highest rate, message being received, answers
+// waiting to be sent and the accepted rate until the check comes
+static unsigned long ulPeerMax = 0;
+static int iPeerStuck = 0;
+static char szPeerMsg[BAUD_MSG_MAX + 1];
+static int iPeerMsgLen = -1;
+static char szPeerOut[2 * BAUD_MSG_MAX];
+static int iPeerOutLen = 0, iPeerOutPos = 0;
+static unsigned long ulPeerNext = 0;
+static unsigned long long ullPeerCheckEnd = 0;
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           handSource
+//  Description:    Sensor samples of the current step. A real hand is never
+//                  still, and checkDir() ignores repeated coordinates, so 
+//                  the samples wander over 7 values; the cursor task reads 
+//                  every 10th sample at 100 Hz and always sees a change.
+///////////////////////////////////////////////////////////////////////////////
+static void handSource(unsigned char* pucX, unsigned char* pucZ)
+{
+    static unsigned char ucJitter = 0;
+    
+    ucJitter = (ucJitter + 1) % 7;
+    *pucX = sScript[uiStep].ucX + ucJitter;
+    *pucZ = sScript[uiStep].ucZ + ucJitter;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           rangeSource
+//  Description:    VL6180 distance of the current step, a few mm of noise
+//                  on it as on the real sensor
+///////////////////////////////////////////////////////////////////////////////
+static unsigned char rangeSource(void)
+{
+    static unsigned char ucNoise = 0;
+    
+    if(!iRangePen || sScript[uiStep].ucMm == AWAY)
+        return(AWAY);
+    ucNoise = (ucNoise + 1) % 5;
+    return(sScript[uiStep].ucMm + ucNoise);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           startStep
+//  Description:    Presses the buttons of a script step, sends its key
+///////////////////////////////////////////////////////////////////////////////
+static void startStep(void)
+{
+    simPORTD.bits.RD13 = !(sScript[uiStep].ucButtons & PEN) || iRangePen;
+    simPORTA.bits.RA7 = !(sScript[uiStep].ucButtons & ERASER);
+    if(sScript[uiStep].cKey)
+        simUART2Receive(sScript[uiStep].cKey);
+    ullStepEnd += (unsigned long long)sScript[uiStep].ulMs * MS_CYCLES;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           peerSend
+//  Description:    Queues an answer of the negotiating terminal
+///////////////////////////////////////////////////////////////////////////////
+static void peerSend(const char* pszText)
+{
+    iPeerOutLen = snprintf(szPeerOut, sizeof(szPeerOut), "\033_B%s\033\\", pszText);
+    iPeerOutPos = 0;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           peerMessage
+//  Description:    Answers a negotiation message, the text between ESC _ B
+//                  and ESC '\'
+///////////////////////////////////////////////////////////////////////////////
+static void peerMessage(const char* pszText)
+{
+    unsigned long ulRate;
+    
+    if(!strcmp(pszText, "?"))
+    {
+        if(ullPeerCheckEnd)
+        {
+            ullPeerCheckEnd = 0;
+            peerSend("!");
+        }
+        return;
+    }
+    
+    ulRate = strtoul(pszText, NULL, 10);
+    if(ulRate > ulPeerMax)
+        peerSend("0");
+    else
+    {
+        peerSend(pszText);
+        ulPeerNext = ulRate;
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           peerSink
+//  Description:    Terminal output, stdout and the negotiation messages
+///////////////////////////////////////////////////////////////////////////////
+static void peerSink(unsigned char ucByte)
+{
+    static unsigned char ucPrev = 0;
+    
+    putchar(ucByte);
+    fflush(stdout);
+    
+    if(ulPeerMax && ucPrev == '\033' && ucByte == '_')
+        iPeerMsgLen = 0;
+    else if(iPeerMsgLen >= 0)
+    {
+        if(ucPrev == '\033' && ucByte == '\\')
+        {
+            // drop the B and the ESC
+            szPeerMsg[iPeerMsgLen - 1] = '\0';
+            if(szPeerMsg[0] == 'B')
+                peerMessage(szPeerMsg + 1);
+            iPeerMsgLen = -1;
+        }
+        else if(iPeerMsgLen < BAUD_MSG_MAX)
+            szPeerMsg[iPeerMsgLen++] = ucByte;
+        else
+            iPeerMsgLen = -1;
+    }
+    ucPrev = ucByte;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           peerStep
+//  Description:    Sends the next answer byte, changes the rate once an 
+//                  accept is out and goes back when the check is late
+///////////////////////////////////////////////////////////////////////////////
+static void peerStep(void)
+{
+    if(iPeerOutPos < iPeerOutLen)
+    {
+        simUART2Receive(szPeerOut[iPeerOutPos++]);
+        return;
+    }
+    
+    if(ulPeerNext)
+    {
+        if(!iPeerStuck)
+            simUART2PeerBaud = ulPeerNext;
+        ulPeerNext = 0;
+        ullPeerCheckEnd = simCycles + (unsigned long long)BAUD_PEER_MS * MS_CYCLES;
+    }
+    else if(ullPeerCheckEnd && simCycles >= ullPeerCheckEnd)
+    {
+        simUART2PeerBaud = UART2_BOOT_BAUD;
+        ullPeerCheckEnd = 0;
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           summary
+//  Description:    Prints the run statistics on stderr
+///////////////////////////////////////////////////////////////////////////////
+static void summary(void)
+{
+    I2C1_STATS sI2C;
+    
+    statsI2C1(&sI2C);
+    fprintf(stderr, "\n%.2f s simulated, %lu bytes sent, %lu dropped, %lu baud\n",
+            (double)simCycles / SIM_FCY, simUART2TxBytes, txDroppedUART2(), baudUART2());
+    fprintf(stderr, "I2C1: %lu starts, %lu bytes, %lu NAKs, bus busy %.1f%%, %lu hangs, %lu recovery clocks, %lu collisions\n",
+            simI2C1Stats.ulStarts, simI2C1Stats.ulBytes, simI2C1Stats.ulNaks,
+            100.0 * simI2C1Stats.ullBusy / simCycles, simI2C1Stats.ulHangs, 
+            simI2C1Stats.ulRecoveryClocks, simI2C1Stats.ulCollisions);
+    fprintf(stderr, "I2C1 at %u kHz: %lu transactions, %lu NAK, %lu timeouts, %lu recoveries, mean %lu us, max %lu us\n",
+            I2C1_Speed(), sI2C.ulXfers, sI2C.ulNaks, sI2C.ulTimeouts, sI2C.ulRecoveries,
+            sI2C.ulMeanUs, sI2C.ulMaxUs);
+    fprintf(stderr, "XZ: %lu samples, %lu reads, %lu stale, longest DR wait %.0f us, bus %.2f ms per 100 ms\n",
+            simXZStats.ulSamples, simXZStats.ulReads, simXZStats.ulStaleReads,
+            simXZStats.ullWaitMax * 1e6 / SIM_FCY, 100.0 * simXZStats.ullBusy / simCycles);
+    fprintf(stderr, "VL6180: %lu samples, %lu overruns, bus %.2f ms per 100 ms\n",
+            simVLStats.ulSamples, simVLStats.ulOverruns, 100.0 * simVLStats.ullBusy / simCycles);
+    fprintf(stderr, "I2C1 budget: XZ and VL6180 %.2f ms per 100 ms\n",
+            100.0 * (simXZStats.ullBusy + simVLStats.ullBusy) / simCycles);
+    fprintf(stderr, "buttons: %lu events lost\n", BUTTON_Lost());
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           restoreStdin
+//  Description:    Gives stdin back to the shell in blocking mode
+///////////////////////////////////////////////////////////////////////////////
+static void restoreStdin(void)
+{
+    if(iStdinFlags != -1)
+        fcntl(STDIN_FILENO, F_SETFL, iStdinFlags);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           appHook
+//  Description:    Runs once per simulated millisecond: script, stdin, 
+//                  pacing and the end of the run
+///////////////////////////////////////////////////////////////////////////////
+static void appHook(void)
+{
+    unsigned char ucByte;
+    struct timespec sNow, sWait;
+    long long llAhead;
+    
+    if(simCycles < ullNextMs)
+        return;
+    ullNextMs += MS_CYCLES;
+    
+    if(simCycles >= ullEnd)
+    {
+        summary();
+        exit(0);
+    }
+    
+    if(ullHangAt && simCycles >= ullHangAt)
+    {
+        simI2C1Hang(HANG_CLOCKS);
+        ullHangAt = 0;
+    }
+    
+    if(simCycles >= ullStepEnd && uiStep + 1 < SIM_STEP_CNT)
+    {
+        uiStep++;
+        startStep();
+    }
+    
+    if(read(STDIN_FILENO, &ucByte, 1) == 1)
+        simUART2Receive(ucByte);
+    if(ulPeerMax)
+        peerStep();
+    
+    if(iRealtime)
+    {
+        clock_gettime(CLOCK_MONOTONIC, &sNow);
+        llAhead = (long long)(simCycles / (SIM_FCY / 1000000)) 
+                - ((long long)(sNow.tv_sec - sStart.tv_sec) * 1000000 
+                + (sNow.tv_nsec - sStart.tv_nsec) / 1000);
+        if(llAhead > 0)
+        {
+            sWait.tv_sec = llAhead / 1000000;
+            sWait.tv_nsec = (llAhead % 1000000) * 1000;
+            nanosleep(&sWait, NULL);
+        }
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           simAppInit
+//  Description:    Sets up the models before the firmware's main() runs
+///////////////////////////////////////////////////////////////////////////////
+__attribute__((constructor)) static void simAppInit(void)
+{
+    const char* psz;
+    
+    psz = getenv("SIM_SECONDS");
+    ullEnd = (unsigned long long)(psz? atof(psz) * SIM_FCY : 20.0 * SIM_FCY);
+    psz = getenv("SIM_XZ_HZ");
+    simXZSource = handSource;
+    simXZAttach(psz? strtoul(psz, NULL, 10) : 100);
+    psz = getenv("SIM_REALTIME");
+    iRealtime = psz && atoi(psz);
+    psz = getenv("SIM_BAUD");
+    ulPeerMax = psz? strtoul(psz, NULL, 10) : 0;
+    psz = getenv("SIM_BAUD_STUCK");
+    iPeerStuck = psz && atoi(psz);
+    psz = getenv("SIM_I2C_HANG");
+    ullHangAt = psz? strtoull(psz, NULL, 10) * MS_CYCLES : 0;
+    psz = getenv("SIM_RANGE_PEN");
+    iRangePen = psz && atoi(psz);
+    simVLSource = rangeSource;
+    simVLAttach();
+    simUART2PeerBaud = UART2_BOOT_BAUD;
+    simUART2Sink = peerSink;
+    clock_gettime(CLOCK_MONOTONIC, &sStart);
+    
+    iStdinFlags = fcntl(STDIN_FILENO, F_GETFL);
+    if(iStdinFlags != -1)
+    {
+        fcntl(STDIN_FILENO, F_SETFL, iStdinFlags | O_NONBLOCK);
+        atexit(restoreStdin);
+    }
+    
+    startStep();
+    simHook = appHook;
+}
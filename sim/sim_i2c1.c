@@ -0,0 +1,306 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+//  Filename:       sim_i2c1.c
+//
+//  Description:    
+//  Model of the I2C1 master and of the slaves attached to its bus. A bus
+//  event requested through I2C1CON or I2C1TRN completes after its real
+//  duration at the bit rate set by I2C1BRG, then clears the request bit,
+//  updates I2C1STAT and raises MI2C1IF exactly like the peripheral does.
+//  A slave can be made to hang the bus, see simI2C1Hang(). While the 
+//  module is off its pins RG2 (SCL) and RG3 (SDA) are open drain port pins,
+//  pulled up unless TRIS and LAT drive them low.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include <xc.h>
+#include <stddef.h>
+
+// I2C1TRN holds this value when no byte is waiting to be sent, any byte the
+// firmware writes replaces it and starts a transmission. A byte written from
+// a char is sign extended, so 0xFFFF would be a 0xFF data byte.
+#define TRN_EMPTY   0x8000
+
+// bus events in progress
+#define OP_NONE     0
+#define OP_START    1
+#define OP_RESTART  2
+#define OP_STOP     3
+#define OP_TX       4
+#define OP_RX       5
+#define OP_ACK      6
+
+volatile SIM_I2CCON simI2C1CON;
+volatile SIM_I2CSTAT simI2C1STAT;
+volatile uint16_t simI2C1BRG, simI2C1TRN = TRN_EMPTY, simI2C1RCV;
+
+SIM_I2C_STATS simI2C1Stats;
+
+static SIM_I2C_DEV* pDevices = NULL;    // attached slaves
+static SIM_I2C_DEV* pSel = NULL;        // slave addressed since last START
+static SIM_I2C_DEV* pOwner = NULL;      // ... and kept until the STOP
+static unsigned long long ullXferBusy;  // bus cycles since the START
+static int iAddrPhase = 0;              // next byte sent is an address
+static int iRead = 0;                   // addressed slave is transmitting
+
+static int iOp = OP_NONE;
+static unsigned long long ullOpEnd;
+
+// a hung slave holds SDA low and the bus event in progress never ends,
+// until SCL has been pulsed iHangClocks times with the module off
+static int iHang = 0;
+static unsigned int uiHangClocks = 0;
+static int iSclLast = 1;
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           simI2C1Attach
+//  Description:    Connects a slave device to the simulated bus
+///////////////////////////////////////////////////////////////////////////////
+void simI2C1Attach(SIM_I2C_DEV* pDev)
+{
+    pDev->uiPtr = 0;
+    pDev->ucPtrBytes = 0;
+    pDev->pNext = pDevices;
+    pDevices = pDev;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           simI2C1Hang
+//  Description:    Makes the addressed slave hang the bus from now on, as
+//                  if it had lost a clock in the middle of a byte it sends:
+//                  it holds SDA low until it has seen <uiClocks> more
+//                  SCL pulses
+///////////////////////////////////////////////////////////////////////////////
+void simI2C1Hang(unsigned int uiClocks)
+{
+    iHang = 1;
+    uiHangClocks = uiClocks? uiClocks : 1;
+    simI2C1Stats.ulHangs++;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           pinStep
+//  Description:    The module is off: resets its state, models SCL and SDA
+//                  as port pins and counts the SCL pulses a hung slave sees
+///////////////////////////////////////////////////////////////////////////////
+static void pinStep(void)
+{
+    int iScl = simTRISG.bits.TRISG2 || simLATG.bits.LATG2;
+    int iSda = (simTRISG.bits.TRISG3 || simLATG.bits.LATG3) && !iHang;
+    
+    iOp = OP_NONE;
+    simI2C1CON.w &= ~0x001F;
+    simI2C1STAT.bits.TRSTAT = 0;
+    simI2C1STAT.bits.TBF = 0;
+    simI2C1STAT.bits.S = 0;
+    simI2C1TRN = TRN_EMPTY;
+    pSel = NULL;
+    pOwner = NULL;
+    
+    if(iScl && !iSclLast)
+    {
+        simI2C1Stats.ulRecoveryClocks++;
+        if(iHang && --uiHangClocks == 0)
+            iHang = 0;
+    }
+    iSclLast = iScl;
+    
+    simPORTG.bits.RG2 = iScl;
+    simPORTG.bits.RG3 = iSda;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           bitCycles
+//  Description:    SCL period in instruction cycles, inverse of the BRG 
+//                  formula used by I2C1_Initialize()
+///////////////////////////////////////////////////////////////////////////////
+static unsigned long bitCycles(void)
+{
+    return(simI2C1BRG + 1 + SIM_FCY / 10000000UL);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           slaveRead / slaveWrite
+//  Description:    Register access of the addressed slave, auto-incremented
+///////////////////////////////////////////////////////////////////////////////
+static unsigned char slaveRead(SIM_I2C_DEV* pDev)
+{
+    unsigned int uiReg = pDev->uiPtr++;
+    
+    if(pDev->pfRead)
+        return(pDev->pfRead(pDev, uiReg));
+    return((uiReg < pDev->uiRegCnt)? pDev->pucRegs[uiReg] : 0xFF);
+}
+
+static void slaveWrite(SIM_I2C_DEV* pDev, unsigned char ucData)
+{
+    // the first bytes of a write form the register pointer
+    if(pDev->ucPtrBytes < pDev->ucRegWidth)
+    {
+        pDev->uiPtr = (pDev->ucPtrBytes? pDev->uiPtr << 8 : 0) | ucData;
+        pDev->ucPtrBytes++;
+        return;
+    }
+    
+    if(pDev->pfWrite)
+        pDev->pfWrite(pDev, pDev->uiPtr, ucData);
+    else if(pDev->uiPtr < pDev->uiRegCnt)
+        pDev->pucRegs[pDev->uiPtr] = ucData;
+    pDev->uiPtr++;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           transmit
+//  Description:    Byte sent by the master, returns the slave's ACK bit
+///////////////////////////////////////////////////////////////////////////////
+static int transmit(unsigned char ucByte)
+{
+    SIM_I2C_DEV* pDev;
+    
+    if(iAddrPhase)
+    {
+        iAddrPhase = 0;
+        for(pDev = pDevices; pDev; pDev = pDev->pNext)
+            if(pDev->ucAddr == (ucByte & 0xFE))
+                break;
+        
+        pSel = pDev;
+        if(pDev)
+            pOwner = pDev;
+        iRead = ucByte & 0x01;
+        if(pSel && !iRead)
+            pSel->ucPtrBytes = 0;
+        return(pSel? 0 : 1);
+    }
+    
+    if(!pSel || iRead)
+        return(1);
+    
+    slaveWrite(pSel, ucByte);
+    return(0);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           begin
+//  Description:    Starts bus event <iNewOp> lasting <ulBits> SCL periods
+///////////////////////////////////////////////////////////////////////////////
+static void begin(int iNewOp, unsigned long ulBits)
+{
+    iOp = iNewOp;
+    ullOpEnd = simCycles + ulBits * bitCycles();
+    simI2C1Stats.ullBusy += ulBits * bitCycles();
+    ullXferBusy += ulBits * bitCycles();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           finish
+//  Description:    Completes the bus event in progress
+///////////////////////////////////////////////////////////////////////////////
+static void finish(void)
+{
+    switch(iOp)
+    {
+        case OP_START:
+        case OP_RESTART:
+            simI2C1CON.bits.SEN = 0;
+            simI2C1CON.bits.RSEN = 0;
+            simI2C1STAT.bits.S = 1;
+            simI2C1STAT.bits.P = 0;
+            iAddrPhase = 1;
+            simI2C1Stats.ulStarts++;
+            break;
+            
+        case OP_STOP:
+            simI2C1CON.bits.PEN = 0;
+            simI2C1STAT.bits.S = 0;
+            simI2C1STAT.bits.P = 1;
+            pSel = NULL;
+            
+            // the transaction ends, its time goes to the slave addressed
+            if(pOwner && pOwner->pullBusy)
+                *pOwner->pullBusy += ullXferBusy;
+            pOwner = NULL;
+            break;
+            
+        case OP_TX:
+            simI2C1STAT.bits.ACKSTAT = transmit(simI2C1TRN & 0xFF);
+            simI2C1STAT.bits.TRSTAT = 0;
+            simI2C1STAT.bits.TBF = 0;
+            simI2C1TRN = TRN_EMPTY;
+            simI2C1Stats.ulBytes++;
+            if(simI2C1STAT.bits.ACKSTAT)
+                simI2C1Stats.ulNaks++;
+            break;
+            
+        case OP_RX:
+            simI2C1RCV = (pSel && iRead)? slaveRead(pSel) : 0xFF;
+            simI2C1CON.bits.RCEN = 0;
+            simI2C1STAT.bits.RBF = 1;
+            simI2C1Stats.ulBytes++;
+            break;
+            
+        case OP_ACK:
+            simI2C1CON.bits.ACKEN = 0;
+            break;
+    }
+    
+    iOp = OP_NONE;
+    simI2C1STAT.bits.R_W = iRead;
+    simIFS1.bits.MI2C1IF = 1;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           simI2C1Step
+//  Description:    Completes the event in progress once its time is up, then
+//                  starts the next one requested by the firmware, if any
+///////////////////////////////////////////////////////////////////////////////
+void simI2C1Step(void)
+{
+    if(!simI2C1CON.bits.I2CEN)
+    {
+        pinStep();
+        return;
+    }
+    simPORTG.bits.RG2 = 1;
+    simPORTG.bits.RG3 = !iHang;
+    
+    if(iOp != OP_NONE)
+    {
+        if(iHang || simCycles < ullOpEnd)
+            return;
+        finish();
+    }
+    
+    // a byte written while the bus is not owned is a write collision
+    if(simI2C1TRN != TRN_EMPTY && !simI2C1STAT.bits.S)
+    {
+        simI2C1STAT.bits.IWCOL = 1;
+        simI2C1TRN = TRN_EMPTY;
+    }
+    
+    if(simI2C1CON.bits.SEN)
+    {
+        // two masters of the firmware both think they own the bus
+        if(simI2C1STAT.bits.S)
+            simI2C1Stats.ulCollisions++;
+        ullXferBusy = 0;
+        begin(OP_START, 1);
+    }
+    else if(simI2C1CON.bits.RSEN)
+        begin(OP_RESTART, 1);
+    else if(simI2C1CON.bits.PEN)
+        begin(OP_STOP, 1);
+    else if(simI2C1CON.bits.RCEN)
+    {
+        simI2C1STAT.bits.RBF = 0;
+        begin(OP_RX, 8);
+    }
+    else if(simI2C1CON.bits.ACKEN)
+        begin(OP_ACK, 1);
+    else if(simI2C1TRN != TRN_EMPTY)
+    {
+        simI2C1STAT.bits.TRSTAT = 1;
+        simI2C1STAT.bits.TBF = 1;
+        begin(OP_TX, 9);
+    }
+}
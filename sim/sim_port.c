@@ -0,0 +1,68 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+//  Filename:       sim_port.c
+//
+//  Description:    
+//  I/O port registers and change notification. The pins are driven by the
+//  other models (sim_xz.c drives RF6, sim_i2c1.c RG2 and RG3) or by host 
+//  code, e.g. to press the Explorer16 push buttons, which read low while 
+//  pressed. A change of a pin on an enabled CN input raises CNIF.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include <xc.h>
+
+volatile SIM_TRISA simTRISA;
+volatile SIM_PORTA simPORTA = { 0xFFFF };
+volatile SIM_LATA simLATA;
+volatile SIM_TRISD simTRISD;
+volatile SIM_PORTD simPORTD = { 0xFFFF };
+volatile SIM_LATD simLATD;
+volatile SIM_TRISF simTRISF;
+volatile SIM_PORTF simPORTF;
+volatile SIM_LATF simLATF;
+volatile SIM_TRISG simTRISG = { 0xFFFF };   // inputs out of reset
+volatile SIM_PORTG simPORTG = { 0xFFFF };
+volatile SIM_LATG simLATG;
+volatile SIM_CNEN1 simCNEN1;
+volatile SIM_CNEN2 simCNEN2;
+volatile SIM_TRISE simTRISE;
+volatile uint16_t simTRISB, simLATB, simTRISC, simLATC, simLATE;
+volatile uint16_t simCNPU1, simCNPU2, simAD1PCFG;
+volatile uint16_t simODCA, simODCB, simODCC, simODCD, simODCE, simODCF, simODCG;
+
+// CN inputs on the modelled pins, with the level last seen
+typedef struct
+{
+    volatile uint16_t* puiPort;
+    uint16_t uiPin;
+    volatile uint16_t* puiEnable;
+    uint16_t uiEnable;
+    int iLast;
+} SIM_CN;
+
+static SIM_CN sCN[] =
+{
+    { &simPORTD.w, 1 << 6,  &simCNEN1.w, 1 << 15, 1 },     // CN15 = RD6, S3
+    { &simPORTD.w, 1 << 13, &simCNEN2.w, 1 << 3,  1 },     // CN19 = RD13, S4
+};
+
+#define SIM_CN_CNT (sizeof(sCN) / sizeof(sCN[0]))
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           simPortStep
+//  Description:    Raises CNIF on a change of an enabled CN input
+///////////////////////////////////////////////////////////////////////////////
+void simPortStep(void)
+{
+    unsigned int i;
+    int iNow;
+    
+    for(i = 0; i < SIM_CN_CNT; i++)
+    {
+        iNow = (*sCN[i].puiPort & sCN[i].uiPin) != 0;
+        if(iNow != sCN[i].iLast && (*sCN[i].puiEnable & sCN[i].uiEnable))
+            simIFS1.bits.CNIF = 1;
+        sCN[i].iLast = iNow;
+    }
+}
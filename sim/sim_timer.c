@@ -0,0 +1,98 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+//  Filename:       sim_timer.c
+//
+//  Description:    
+//  Model of Timer1 running from the instruction clock: TMR1 counts at 
+//  Fcy / prescaler while TON is set, and on reaching PR1 it resets to zero
+//  and raises T1IF. Timer4 works the same way and raises T4IF. Timer2/3 is
+//  modelled as one 32-bit timer (T2CON.T32), TMR3:TMR2 counting up to 
+//  PR3:PR2 and raising T3IF.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include <xc.h>
+
+volatile SIM_TCON simT1CON;
+volatile uint16_t simTMR1, simPR1;
+volatile SIM_TCON simT2CON, simT3CON;
+volatile uint16_t simTMR2, simTMR3, simPR2 = 0xFFFF, simPR3 = 0xFFFF;
+volatile SIM_TCON simT4CON;
+volatile uint16_t simTMR4, simPR4 = 0xFFFF;
+
+// cycles not yet turned into timer counts
+static unsigned long long ullLast = 0;
+static unsigned long ulT1Frac = 0, ulT23Frac = 0, ulT4Frac = 0;
+
+static const unsigned int uiPrescale[4] = { 1, 8, 64, 256 };
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           t23Step
+//  Description:    Advances the 32-bit Timer2/3 by <ulElapsed> cycles
+///////////////////////////////////////////////////////////////////////////////
+static void t23Step(unsigned long ulElapsed)
+{
+    unsigned long long ullCount, ullPeriod;
+    
+    ulT23Frac += ulElapsed;
+    ullCount = ulT23Frac / uiPrescale[simT2CON.bits.TCKPS];
+    ulT23Frac -= ullCount * uiPrescale[simT2CON.bits.TCKPS];
+    
+    ullPeriod = (((unsigned long long)simPR3 << 16) | simPR2) + 1;
+    ullCount += ((unsigned long)simTMR3 << 16) | simTMR2;
+    if(ullCount >= ullPeriod)
+    {
+        simIFS0.bits.T3IF = 1;
+        ullCount %= ullPeriod;
+    }
+    simTMR3 = (uint16_t)(ullCount >> 16);
+    simTMR2 = (uint16_t)ullCount;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           t16Step
+//  Description:    Advances a 16-bit timer by <ulElapsed> cycles, returns 1
+//                  if it matched its period register
+///////////////////////////////////////////////////////////////////////////////
+static int t16Step(volatile SIM_TCON* pCon, volatile uint16_t* puiTmr, 
+                   uint16_t uiPr, unsigned long* pulFrac, unsigned long ulElapsed)
+{
+    unsigned long ulPeriod;
+    unsigned long ulCount;
+    int iMatch = 0;
+    
+    *pulFrac += ulElapsed;
+    ulCount = *pulFrac / uiPrescale[pCon->bits.TCKPS];
+    *pulFrac -= ulCount * uiPrescale[pCon->bits.TCKPS];
+    
+    // the counter matches PR, then restarts from zero on the next count
+    ulPeriod = (unsigned long)uiPr + 1;
+    ulCount += *puiTmr;
+    if(ulCount >= ulPeriod)
+    {
+        iMatch = 1;
+        ulCount %= ulPeriod;
+    }
+    *puiTmr = (uint16_t)ulCount;
+    return(iMatch);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           simTimerStep
+//  Description:    Advances the timers by the cycles elapsed since last step
+///////////////////////////////////////////////////////////////////////////////
+void simTimerStep(void)
+{
+    unsigned long ulElapsed = (unsigned long)(simCycles - ullLast);
+    
+    ullLast = simCycles;
+    
+    if(simT2CON.bits.TON && simT2CON.bits.T32)
+        t23Step(ulElapsed);
+    
+    if(simT1CON.bits.TON && t16Step(&simT1CON, &simTMR1, simPR1, &ulT1Frac, ulElapsed))
+        simIFS0.bits.T1IF = 1;
+    
+    if(simT4CON.bits.TON && t16Step(&simT4CON, &simTMR4, simPR4, &ulT4Frac, ulElapsed))
+        simIFS1.bits.T4IF = 1;
+}
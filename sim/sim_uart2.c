@@ -0,0 +1,157 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+//  Filename:       sim_uart2.c
+//
+//  Description:    
+//  Model of the UART2 module with its 4-deep transmit and receive buffers.
+//  Characters take 10 bit times at the rate set by U2BRG and BRGH, U2TXIF is
+//  raised when a character moves into the transmit shift register 
+//  (UTXISEL = 00) and U2RXIF when one is received (URXISEL = 00).
+//  When simUART2PeerBaud is set, characters in either direction are
+//  garbled while the UART's actual rate is more than PEER_TOL_PCT off it.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include <xc.h>
+#include <stdio.h>
+
+// U2TXREG holds this value when no byte has been written since the last step.
+// A byte written from a char is sign extended, so 0xFFFF would be a 0xFF 
+// data byte.
+#define TXREG_EMPTY 0x8000
+
+#define HW_FIFO     4
+
+// rate mismatch the two ends still get through
+#define PEER_TOL_PCT    4
+
+volatile SIM_UMODE simU2MODE;
+volatile SIM_USTA simU2STA;
+volatile uint16_t simU2BRG, simU2TXREG = TXREG_EMPTY;
+
+void (*simUART2Sink)(unsigned char ucByte) = NULL;
+unsigned long simUART2TxBytes = 0;
+unsigned long simUART2PeerBaud = 0;
+
+// transmit buffer and shift register
+static unsigned char ucTxFifo[HW_FIFO];
+static int iTxCnt = 0;
+static int iShifting = 0;
+static unsigned char ucShift;
+static unsigned long long ullShiftEnd;
+
+// receive buffer
+static unsigned char ucRxFifo[HW_FIFO];
+static int iRxCnt = 0;
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           charCycles
+//  Description:    Instruction cycles per character, 8N1 framing
+///////////////////////////////////////////////////////////////////////////////
+static unsigned long charCycles(void)
+{
+    return(10UL * (simU2BRG + 1) * (simU2MODE.bits.BRGH? 4 : 16));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           peerByte
+//  Description:    A character as the other end gets it, garbled when the
+//                  rates do not match
+///////////////////////////////////////////////////////////////////////////////
+static unsigned char peerByte(unsigned char ucByte)
+{
+    unsigned long ulActual;
+    
+    if(!simUART2PeerBaud)
+        return(ucByte);
+    ulActual = SIM_FCY / ((simU2BRG + 1UL) * (simU2MODE.bits.BRGH? 4 : 16));
+    if(ulActual * 100 > simUART2PeerBaud * (100 + PEER_TOL_PCT)
+       || ulActual * 100 < simUART2PeerBaud * (100 - PEER_TOL_PCT))
+        return(ucByte ^ 0xA5);
+    return(ucByte);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           simUART2Receive
+//  Description:    Delivers a byte from the terminal to the U2RX pin
+///////////////////////////////////////////////////////////////////////////////
+void simUART2Receive(unsigned char ucByte)
+{
+    if(!simU2MODE.bits.UARTEN)
+        return;
+    
+    if(iRxCnt == HW_FIFO)
+    {
+        simU2STA.bits.OERR = 1;
+        return;
+    }
+    
+    ucRxFifo[iRxCnt++] = peerByte(ucByte);
+    simU2STA.bits.URXDA = 1;
+    simIFS1.bits.U2RXIF = 1;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           simUART2Read
+//  Description:    Read of U2RXREG, pops the oldest received byte
+///////////////////////////////////////////////////////////////////////////////
+uint16_t simUART2Read(void)
+{
+    unsigned char ucByte = ucRxFifo[0];
+    int i;
+    
+    if(iRxCnt == 0)
+        return(0);
+    
+    for(i = 1; i < iRxCnt; i++)
+        ucRxFifo[i - 1] = ucRxFifo[i];
+    iRxCnt--;
+    
+    simU2STA.bits.URXDA = (iRxCnt > 0);
+    return(ucByte);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           simUART2Step
+//  Description:    Accepts bytes written to U2TXREG and shifts them out
+///////////////////////////////////////////////////////////////////////////////
+void simUART2Step(void)
+{
+    int i;
+    
+    if(simU2TXREG != TXREG_EMPTY)
+    {
+        if(simU2MODE.bits.UARTEN && simU2STA.bits.UTXEN && iTxCnt < HW_FIFO)
+            ucTxFifo[iTxCnt++] = simU2TXREG & 0xFF;
+        simU2TXREG = TXREG_EMPTY;
+    }
+    
+    if(iShifting && simCycles >= ullShiftEnd)
+    {
+        iShifting = 0;
+        simUART2TxBytes++;
+        ucShift = peerByte(ucShift);
+        if(simUART2Sink)
+            simUART2Sink(ucShift);
+        else
+        {
+            putchar(ucShift);
+            fflush(stdout);
+        }
+    }
+    
+    if(!iShifting && iTxCnt > 0)
+    {
+        ucShift = ucTxFifo[0];
+        for(i = 1; i < iTxCnt; i++)
+            ucTxFifo[i - 1] = ucTxFifo[i];
+        iTxCnt--;
+        
+        iShifting = 1;
+        ullShiftEnd = simCycles + charCycles();
+        simIFS1.bits.U2TXIF = 1;
+    }
+    
+    simU2STA.bits.UTXBF = (iTxCnt == HW_FIFO);
+    simU2STA.bits.TRMT = (iTxCnt == 0 && !iShifting);
+}
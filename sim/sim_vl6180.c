@@ -0,0 +1,151 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+//  Filename:       sim_vl6180.c
+//
+//  Description:
+//  Model of the VL6180 range sensor on the I2C1 bus, with its GPIO1 output
+//  wired to INT1 (RE8). A single shot or continuous ranging is started by
+//  SYSRANGE__START; a measurement converges in MEASURE_MS with a target,
+//  or runs the whole max convergence time without one and ends with an
+//  error code. When SYSTEM__INTERRUPT_CONFIG_GPIO asks for it, a new sample
+//  sets the range event and pulls GPIO1 low until it is cleared through
+//  SYSTEM__INTERRUPT_CLEAR. INT1 flags the edge selected by INT1EP.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include <xc.h>
+#include <stddef.h>
+#include "../APIs/VL6180.h"
+
+// measurement time with a target in range, readout averaging included
+#define MEASURE_MS      8
+
+// readout averaging after a measurement that did not converge
+#define READOUT_MS      5
+
+// error code of a result without a target: max convergence
+#define NO_TARGET_ERR   0x60
+
+#define MS_CYCLES       (SIM_FCY / 1000)
+
+unsigned char (*simVLSource)(void) = NULL;
+SIM_VL_STATS simVLStats;
+
+static unsigned char ucRegs[0x100];
+static unsigned long long ullNextStart = 0;    // continuous mode, 0 if stopped
+static unsigned long long ullDone = 0;         // measurement underway, 0 if none
+static int iGPIO = 1;                           // GPIO1 level, pulled up
+
+static void vlWrite(SIM_I2C_DEV* pDev, unsigned int uiReg, unsigned char ucData);
+static SIM_I2C_DEV sDev =
+{
+    .ucAddr = VL6180_ADDR,
+    .ucRegWidth = 2,
+    .pucRegs = ucRegs,
+    .uiRegCnt = sizeof(ucRegs),
+    .pfWrite = vlWrite,
+    .pullBusy = &simVLStats.ullBusy
+};
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           setGPIO
+//  Description:    Drives GPIO1, INT1 flags the selected edge
+///////////////////////////////////////////////////////////////////////////////
+static void setGPIO(int iLevel)
+{
+    if(iLevel != iGPIO && iLevel == !simINTCON2.bits.INT1EP)
+        simIFS1.bits.INT1IF = 1;
+    iGPIO = iLevel;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           measure
+//  Description:    Starts a measurement, it ends when its time is up
+///////////////////////////////////////////////////////////////////////////////
+static void measure(void)
+{
+    unsigned char ucMm = simVLSource? simVLSource() : 0xFF;
+
+    ucRegs[VL_RANGE_VAL] = ucMm;
+    ullDone = simCycles + (unsigned long long)MS_CYCLES
+            * ((ucMm != 0xFF)? MEASURE_MS : ucRegs[VL_RANGE_CONVERGE] + READOUT_MS);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           vlWrite
+//  Description:    Register write by the master: the interrupt clear and
+//                  the range start act, the rest is stored
+///////////////////////////////////////////////////////////////////////////////
+static void vlWrite(SIM_I2C_DEV* pDev, unsigned int uiReg, unsigned char ucData)
+{
+    (void)pDev;
+
+    if(uiReg >= sizeof(ucRegs))
+        return;
+
+    if(uiReg == VL_INT_CLEAR)
+    {
+        ucRegs[VL_INT_STATUS] &= ~ucData;
+        if(!(ucRegs[VL_INT_STATUS] & 0x07))
+            setGPIO(1);
+        return;
+    }
+
+    if(uiReg == VL_RANGE_START)
+    {
+        // the start bit stops continuous ranging, else starts a mode
+        if(ullNextStart)
+            ullNextStart = 0;
+        else if(ucData == VL_START_CONTINUOUS)
+            ullNextStart = simCycles;
+        else if(ucData == VL_START_SINGLE && !ullDone)
+            measure();
+        return;
+    }
+
+    ucRegs[uiReg] = ucData;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           simVLAttach
+//  Description:    Connects the sensor to the bus, fresh out of reset
+///////////////////////////////////////////////////////////////////////////////
+void simVLAttach(void)
+{
+    ucRegs[VL_FRESH_RESET] = 1;
+    simI2C1Attach(&sDev);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           simVLStep
+//  Description:    Starts the next continuous measurement when it is due and
+//                  ends the one underway when its time is up
+///////////////////////////////////////////////////////////////////////////////
+void simVLStep(void)
+{
+    unsigned char ucMm;
+
+    if(ullNextStart && simCycles >= ullNextStart && !ullDone)
+    {
+        ullNextStart += (unsigned long long)MS_CYCLES * 10 * (ucRegs[VL_RANGE_PERIOD] + 1);
+        measure();
+    }
+
+    if(!ullDone || simCycles < ullDone)
+        return;
+    ullDone = 0;
+
+    ucMm = ucRegs[VL_RANGE_VAL];
+    ucRegs[VL_RANGE_STATUS] = ((ucMm != 0xFF)? 0x00 : NO_TARGET_ERR) | 0x01;
+    simVLStats.ulSamples++;
+    if(ucRegs[VL_INT_STATUS] & 0x07)
+        simVLStats.ulOverruns++;
+
+    // new sample ready event on GPIO1 when enabled, active low
+    if((ucRegs[VL_INT_CONFIG] & 0x07) == VL_INT_NEW_SAMPLE)
+    {
+        ucRegs[VL_INT_STATUS] = (ucRegs[VL_INT_STATUS] & ~0x07) | VL_INT_NEW_SAMPLE;
+        if((ucRegs[VL_GPIO1_MODE] & 0x1E) == 0x10)
+            setGPIO(0);
+    }
+}
@@ -0,0 +1,122 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+//  Filename:       sim_xz.c
+//
+//  Description:    
+//  Model of the XZ sensor on the I2C1 bus and of its DR pin wired to INT0 
+//  (RF6). A new sample is produced at the configured rate; when DRE/DRCFG 
+//  enable it, DR goes high with the sample and low again once the X 
+//  coordinate has been read. INT0 flags the edge selected by INT0EP. 
+//  Reading X latches X and Z together, like the sensor's output registers.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include <xc.h>
+#include <stddef.h>
+#include "../APIs/XZsensor.h"
+
+
+
+
+void (*simXZSource)(unsigned char* pucX, unsigned char* pucZ) = NULL;
+SIM_XZ_STATS simXZStats;
+
+static unsigned char ucRegs[16];
+static unsigned char ucX = MIDPOINT, ucZ = MIDPOINT;   // newest sample
+static unsigned long long ullPeriod = 0, ullNext = 0;
+static int iFresh = 0;              // sample not read yet
+static int iDR = 0;                 // DR pin level
+static unsigned long long ullDRHigh;    // when DR went high
+
+static unsigned char xzRead(SIM_I2C_DEV* pDev, unsigned int uiReg);
+static SIM_I2C_DEV sDev =
+{
+    .ucAddr = XZ_ADDR,
+    .ucRegWidth = 1,
+    .pucRegs = ucRegs,
+    .uiRegCnt = sizeof(ucRegs),
+    .pfRead = xzRead,
+    .pullBusy = &simXZStats.ullBusy
+};
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           setDR
+//  Description:    Drives the DR pin, INT0 flags the selected edge
+///////////////////////////////////////////////////////////////////////////////
+static void setDR(int iLevel)
+{
+    if(iLevel != iDR && iLevel == !simINTCON2.bits.INT0EP)
+        simIFS0.bits.INT0IF = 1;
+    if(iLevel && !iDR)
+        ullDRHigh = simCycles;
+    iDR = iLevel;
+    simPORTF.bits.RF6 = iLevel;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           xzRead
+//  Description:    Register read by the master, reading X releases DR
+///////////////////////////////////////////////////////////////////////////////
+static unsigned char xzRead(SIM_I2C_DEV* pDev, unsigned int uiReg)
+{
+    (void)pDev;
+    
+    // reading X latches the whole sample, so a burst is never torn
+    if(uiReg == X_REG)
+    {
+        ucRegs[X_REG] = ucX;
+        ucRegs[Z_REG] = ucZ;
+        simXZStats.ulReads++;
+        if(!iFresh)
+            simXZStats.ulStaleReads++;
+        if(iDR && simCycles - ullDRHigh > simXZStats.ullWaitMax)
+            simXZStats.ullWaitMax = simCycles - ullDRHigh;
+        iFresh = 0;
+        setDR(0);
+    }
+    return((uiReg < sizeof(ucRegs))? ucRegs[uiReg] : 0xFF);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           simXZAttach
+//  Description:    Connects the sensor to the bus, sampling at <ulRateHz>
+///////////////////////////////////////////////////////////////////////////////
+void simXZAttach(unsigned long ulRateHz)
+{
+    ucRegs[X_REG] = ucX;
+    ucRegs[Z_REG] = ucZ;
+    simI2C1Attach(&sDev);
+    simXZSetRate(ulRateHz);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           simXZSetRate
+//  Description:    Changes the sample (and DR edge) rate
+///////////////////////////////////////////////////////////////////////////////
+void simXZSetRate(unsigned long ulRateHz)
+{
+    ullPeriod = ulRateHz? SIM_FCY / ulRateHz : 0;
+    ullNext = simCycles + ullPeriod;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           simXZStep
+//  Description:    Produces the next sample when it is due
+///////////////////////////////////////////////////////////////////////////////
+void simXZStep(void)
+{
+    if(ullPeriod == 0 || simCycles < ullNext)
+        return;
+    ullNext += ullPeriod;
+    
+    if(simXZSource)
+        simXZSource(&ucX, &ucZ);
+    
+    simXZStats.ulSamples++;
+    iFresh = 1;
+    
+    // DR asserts when enabled for coordinate data, active high; if the last
+    // sample was never read it is still high and no new edge is seen
+    if((ucRegs[DRE_REG] & DRE_CFG) && (ucRegs[DRCFG_REG] & 0x80))
+        setDR(1);
+}
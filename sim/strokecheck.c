@@ -0,0 +1,364 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+//  Filename:       strokecheck.c
+//
+//  Description:
+//  Host test of the stroke rasterizer (APIs/stroke.c), built by
+//  "make strokecheck" and run by "make check". A set of random moves is
+//  painted and erased with STROKE_Line(); after each one every cell of
+//  the move's Bresenham line, worked out here, must hold the pen's state in
+//  the canvas, no other cell may have changed, and a model of the terminal
+//  fed the UART2 output must show the same cells as the canvas. Output that
+//  does not fit the Tx ring is dropped, as on the board, and its rows must
+//  then be marked dirty; they are copied to the terminal as the redraw
+//  would.
+//
+//  Then the bytes sent for straight moves from the pen's cell are checked
+//  against what they must cost. A horizontal run is the ink character
+//  repeated, or once and REP where that is shorter (TERM_USE_REP). Each
+//  cell of a vertical run is the shortest CUD, a line feed, a backspace
+//  and the ink character; of a diagonal run a line feed and the character.
+//
+//  Usage:  strokecheck
+//
+//  Exits with 1 if a check failed.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include <xc.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../APIs/stroke.h"
+#include "../APIs/term.h"
+#include "../APIs/uart2.h"
+
+#define MOVES       2000            // random moves painted
+#define MOVE_MAX    40              // longest step of a move, in rows or cells
+#define BLANK_PCT   20              // moves made with the eraser
+#define RUN_MAX     60              // longest straight move timed in bytes
+#define RUN_ROW     10              // ... and where they start
+#define RUN_COL     20
+
+#define INK_CHAR    '\xDB'
+#define TEST_BAUD   1000000UL       // drains a move in a few hundred us
+
+// terminal model: the cells, the cursor and the last character printed
+static unsigned char ucScreen[SCREEN_H + 1][SCREEN_W + 1];
+static int iRow, iCol, iWrap;
+static char cLast = ' ';
+
+// UART2 output since the last capture
+static char cOut[4 * TX_FIFO_SIZE];
+static unsigned int uiOut;
+
+// cells the moves must have left
+static unsigned char ucModel[SCREEN_H + 1][SCREEN_W + 1];
+
+static unsigned long ulChecks = 0, ulFailed = 0;
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           check
+//  Description:    Counts a check, reports it if it failed
+///////////////////////////////////////////////////////////////////////////////
+static void check(int iOk, const char* pszWhat, unsigned long ulN)
+{
+    ulChecks++;
+    if(!iOk && ulFailed++ < 20)
+        printf("FAIL %s (%lu)\n", pszWhat, ulN);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           sink
+//  Description:    Bytes shifted out of U2TX
+///////////////////////////////////////////////////////////////////////////////
+static void sink(unsigned char ucByte)
+{
+    if(uiOut < sizeof(cOut))
+        cOut[uiOut++] = ucByte;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           clamp
+//  Description:    Keeps a coordinate on the screen
+///////////////////////////////////////////////////////////////////////////////
+static int clamp(int i, int iMax)
+{
+    return((i < 1)? 1 : (i > iMax)? iMax : i);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           put
+//  Description:    Prints a character at the terminal cursor, which stops
+//                  at the right edge and wraps on the next character
+///////////////////////////////////////////////////////////////////////////////
+static void put(char c)
+{
+    if(iWrap)
+    {
+        iRow = clamp(iRow + 1, SCREEN_H);
+        iCol = 1;
+        iWrap = 0;
+    }
+    ucScreen[iRow][iCol] = (c == INK_CHAR);
+    cLast = c;
+    if(iCol < SCREEN_W)
+        iCol++;
+    else
+        iWrap = 1;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           play
+//  Description:    Runs the captured output through the terminal model,
+//                  returns 0 on a sequence it does not know
+///////////////////////////////////////////////////////////////////////////////
+static int play(void)
+{
+    unsigned int i = 0, j;
+    int iN, iM;
+
+    while(i < uiOut)
+    {
+        char c = cOut[i++];
+
+        if(c != '\033')
+        {
+            switch(c)
+            {
+                case '\n': iRow = clamp(iRow + 1, SCREEN_H); break;
+                case '\r': iCol = 1; break;
+                case '\b': iCol = clamp(iCol - 1, SCREEN_W); break;
+                default: put(c); continue;
+            }
+            iWrap = 0;
+            continue;
+        }
+
+        iWrap = 0;
+        if(i < uiOut && cOut[i] == 'M')
+        {
+            i++;
+            iRow = clamp(iRow - 1, SCREEN_H);
+            continue;
+        }
+        if(i >= uiOut || cOut[i++] != '[')
+            return(0);
+
+        // one or two parameters, 0 or none meaning 1
+        for(iN = 0; i < uiOut && cOut[i] >= '0' && cOut[i] <= '9'; i++)
+            iN = 10 * iN + cOut[i] - '0';
+        if(!iN) iN = 1;
+        iM = 1;
+        if(i < uiOut && cOut[i] == ';')
+        {
+            for(i++, iM = 0; i < uiOut && cOut[i] >= '0' && cOut[i] <= '9'; i++)
+                iM = 10 * iM + cOut[i] - '0';
+            if(!iM) iM = 1;
+        }
+        if(i >= uiOut)
+            return(0);
+
+        switch(cOut[i++])
+        {
+            case 'A': iRow = clamp(iRow - iN, SCREEN_H); break;
+            case 'B': iRow = clamp(iRow + iN, SCREEN_H); break;
+            case 'C': iCol = clamp(iCol + iN, SCREEN_W); break;
+            case 'D': iCol = clamp(iCol - iN, SCREEN_W); break;
+            case 'H': iRow = clamp(iN, SCREEN_H); iCol = clamp(iM, SCREEN_W); break;
+            case 'b': for(j = 0; j < (unsigned int)iN; j++) put(cLast); break;
+            case 'X':
+                for(j = 0; j < (unsigned int)iN && iCol + j <= SCREEN_W; j++)
+                    ucScreen[iRow][iCol + j] = 0;
+                break;
+            default: return(0);
+        }
+    }
+    return(1);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           drain
+//  Description:    Waits for the output of a move and plays it
+///////////////////////////////////////////////////////////////////////////////
+static int drain(void)
+{
+    txFlushUART2();
+    return(play());
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           line
+//  Description:    Sets the cells of the Bresenham line from one cell to the
+//                  other in the model
+///////////////////////////////////////////////////////////////////////////////
+static void line(int iRow0, int iCol0, int iRow1, int iCol1, char state)
+{
+    int iDc = abs(iCol1 - iCol0), iDr = -abs(iRow1 - iRow0);
+    int iSc = (iCol1 > iCol0)? 1 : -1, iSr = (iRow1 > iRow0)? 1 : -1;
+    int iErr = iDc + iDr, iErr2;
+
+    for(;;)
+    {
+        ucModel[iRow0][iCol0] = state;
+        if(iRow0 == iRow1 && iCol0 == iCol1)
+            break;
+        iErr2 = 2 * iErr;
+        if(iErr2 >= iDr)
+        {
+            iErr += iDr;
+            iCol0 += iSc;
+        }
+        if(iErr2 <= iDc)
+        {
+            iErr += iDc;
+            iRow0 += iSr;
+        }
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           matches
+//  Description:    Compares the canvas, or the terminal but for the dirty
+//                  rows, with the model
+///////////////////////////////////////////////////////////////////////////////
+static int matches(int iScreen)
+{
+    int r, c;
+
+    for(r = 1; r <= SCREEN_H; r++)
+    {
+        if(iScreen && CANVAS_IsDirty(r))
+            continue;
+        for(c = 1; c <= SCREEN_W; c++)
+            if((iScreen? ucScreen[r][c] : CANVAS_Get(r, c)) != ucModel[r][c])
+                return(0);
+    }
+    return(1);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           redraw
+//  Description:    Copies the dirty rows to the terminal, returns how many
+///////////////////////////////////////////////////////////////////////////////
+static unsigned int redraw(void)
+{
+    unsigned int uiRows = 0;
+    int r, c;
+
+    for(r = 1; r <= SCREEN_H; r++)
+    {
+        if(!CANVAS_IsDirty(r))
+            continue;
+        for(c = 1; c <= SCREEN_W; c++)
+            ucScreen[r][c] = CANVAS_Get(r, c);
+        CANVAS_CleanRow(r);
+        uiRows++;
+    }
+    return(uiRows);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           start
+//  Description:    Blank canvas, terminal and model, the terminal cursor on
+//                  a known cell
+///////////////////////////////////////////////////////////////////////////////
+static void start(int iAtRow, int iAtCol)
+{
+    CANVAS_Clear();
+    memset(ucScreen, 0, sizeof(ucScreen));
+    memset(ucModel, 0, sizeof(ucModel));
+    TERM_SetPosition(iAtRow, iAtCol);
+    iRow = iAtRow;
+    iCol = iAtCol;
+    iWrap = 0;
+    uiOut = 0;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           runBytes
+//  Description:    Bytes of a horizontal run of <iN> ink cells
+///////////////////////////////////////////////////////////////////////////////
+static unsigned int runBytes(int iN)
+{
+    char cRep[16];
+    int iRep = 1 + sprintf(cRep, "\033[%db", iN - 1);
+
+    return((TERM_USE_REP && iN > 2 && iRep < iN)? iRep : iN);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           straight
+//  Description:    Paints a straight move of <iN> cells from the cursor in
+//                  direction <iDr>, <iDc> and checks its bytes
+///////////////////////////////////////////////////////////////////////////////
+static void straight(const char* pszWhat, int iN, int iDr, int iDc, unsigned int uiExpect)
+{
+    start(RUN_ROW, RUN_COL);
+    STROKE_Line(RUN_ROW, RUN_COL, RUN_ROW + iDr * (iN - 1), RUN_COL + iDc * (iN - 1), CANVAS_INK);
+    line(RUN_ROW, RUN_COL, RUN_ROW + iDr * (iN - 1), RUN_COL + iDc * (iN - 1), CANVAS_INK);
+    check(drain() && matches(1), pszWhat, iN);
+    if(uiOut != uiExpect)
+        printf("%s of %d cells: %u bytes, expected %u\n", pszWhat, iN, uiOut, uiExpect);
+    check(uiOut == uiExpect, pszWhat, iN);
+}
+
+int main(void)
+{
+    unsigned long ulMove, ulDropped, ulRedrawn = 0;
+    int iRow0, iCol0, iRow1, iCol1, iN;
+    unsigned char ucTermRow, ucTermCol;
+    char state;
+
+    simUART2Sink = sink;
+    UART2_Initialize();
+    setBaudUART2(TEST_BAUD);
+
+    // random moves, from where the last one ended
+    srand(1);
+    start(1, 1);
+    TERM_Invalidate();
+    iRow0 = SCREEN_H / 2;
+    iCol0 = SCREEN_W / 2;
+    for(ulMove = 0; ulMove < MOVES; ulMove++)
+    {
+        iRow1 = clamp(iRow0 + rand() % (2 * MOVE_MAX + 1) - MOVE_MAX, SCREEN_H);
+        iCol1 = clamp(iCol0 + rand() % (2 * MOVE_MAX + 1) - MOVE_MAX, SCREEN_W);
+        state = (rand() % 100 < BLANK_PCT)? CANVAS_BLANK : CANVAS_INK;
+
+        uiOut = 0;
+        ulDropped = txDroppedUART2();
+        STROKE_Line(iRow0, iCol0, iRow1, iCol1, state);
+        line(iRow0, iCol0, iRow1, iCol1, state);
+
+        check(matches(0), "canvas holds the Bresenham cells of the move", ulMove);
+        check(drain(), "output holds only known sequences", ulMove);
+        check(matches(1), "terminal shows the canvas", ulMove);
+        check(txDroppedUART2() != ulDropped || (iRow == iRow1
+              && (iCol == iCol1 || iCol == iCol1 + 1 || iWrap)),
+              "cursor left at the end of the move", ulMove);
+        TERM_Position(&ucTermRow, &ucTermCol);
+        check(ucTermCol == TERM_UNKNOWN || (ucTermRow == iRow && ucTermCol == iCol),
+              "tracked position is the terminal's", ulMove);
+
+        ulRedrawn += redraw();
+        iRow0 = iRow1;
+        iCol0 = iCol1;
+    }
+    printf("%d moves, %lu bytes dropped, %lu rows redrawn\n", MOVES, txDroppedUART2(), ulRedrawn);
+
+    // the straight moves fit the Tx ring
+    ulDropped = txDroppedUART2();
+
+    // bytes of straight moves from the cursor's cell
+    for(iN = 1; iN <= RUN_MAX; iN++)
+    {
+        straight("horizontal run", iN, 0, 1, runBytes(iN));
+        straight("vertical run", iN, 1, 0, 1 + 3 * (iN - 1));
+        straight("diagonal run", iN, 1, 1, 1 + 2 * (iN - 1));
+    }
+    check(txDroppedUART2() == ulDropped, "no output of the straight moves dropped", 0);
+
+    printf("strokecheck: %lu checks, %lu failed\n", ulChecks, ulFailed);
+    return(ulFailed? 1 : 0);
+}
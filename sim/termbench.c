@@ -0,0 +1,211 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+//  Filename:       termbench.c
+//
+//  Description:
+//  Host benchmark of the cursor encoder (APIs/term.c), built by
+//  "make termbench" and run by "make check". Cursor paths of FRAMES
+//  updates are sent two ways: by TERM_CursorSeq(), and by the absolute CUP
+//  "\033[row;colH" the firmware sent on every update before the encoder.
+//  Reported per path: the bytes per update of each and the host time per
+//  update of each.
+//
+//  The paths: a hand held still, which jitters by a cell; a slow and a fast
+//  walk, steps of up to 2 and 8 cells; and jumps anywhere on the screen.
+//  Every sequence the encoder builds is run through a model of the
+//  terminal, which must end on the target cell.
+//
+//  Usage:  termbench
+//
+//  Exits with 1 if a sequence missed its target.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include <xc.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "../APIs/term.h"
+#include "../APIs/XZsensor.h"
+
+#define FRAMES      100000UL
+
+typedef struct
+{
+    const char* pszName;
+    int iStep;                      // largest step per update, 0 for jumps
+} PATH;
+
+static const PATH sPaths[] =
+{
+    { "jitter", 1 },
+    { "slow walk", 2 },
+    { "fast walk", 8 },
+    { "jumps", 0 },
+};
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           nsNow
+//  Description:    Host monotonic clock in nanoseconds
+///////////////////////////////////////////////////////////////////////////////
+static unsigned long long nsNow(void)
+{
+    struct timespec sNow;
+
+    clock_gettime(CLOCK_MONOTONIC, &sNow);
+    return((unsigned long long)sNow.tv_sec * 1000000000ULL + sNow.tv_nsec);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           clamp
+//  Description:    Keeps a coordinate on the screen
+///////////////////////////////////////////////////////////////////////////////
+static int clamp(int i, int iMax)
+{
+    return((i < 1)? 1 : (i > iMax)? iMax : i);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           param
+//  Description:    Reads a CSI parameter, <iDefault> if there is none
+///////////////////////////////////////////////////////////////////////////////
+static int param(const char** ppc, const char* pcEnd, int iDefault)
+{
+    int i = 0, iDigits = 0;
+
+    while(*ppc < pcEnd && **ppc >= '0' && **ppc <= '9')
+    {
+        i = 10 * i + *(*ppc)++ - '0';
+        iDigits++;
+    }
+    return((iDigits && i)? i : iDefault);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  Name:           play
+//  Description:    Moves the terminal cursor <piRow>, <piCol> as the sequence
+//                  does, returns 0 if it holds anything but cursor moves
+///////////////////////////////////////////////////////////////////////////////
+static int play(const char* pc, unsigned int uiLen, int* piRow, int* piCol)
+{
+    const char* pcEnd = pc + uiLen;
+    int iN, iM;
+
+    while(pc < pcEnd)
+    {
+        switch(*pc++)
+        {
+            case '\n': *piRow = clamp(*piRow + 1, SCREEN_H); break;
+            case '\r': *piCol = 1; break;
+            case '\b': *piCol = clamp(*piCol - 1, SCREEN_W); break;
+            case '\033':
+                if(pc < pcEnd && *pc == 'M')
+                {
+                    pc++;
+                    *piRow = clamp(*piRow - 1, SCREEN_H);
+                    break;
+                }
+                if(pc >= pcEnd || *pc++ != '[')
+                    return(0);
+                iN = param(&pc, pcEnd, 1);
+                iM = 1;
+                if(pc < pcEnd && *pc == ';')
+                {
+                    pc++;
+                    iM = param(&pc, pcEnd, 1);
+                }
+                if(pc >= pcEnd)
+                    return(0);
+                switch(*pc++)
+                {
+                    case 'A': *piRow = clamp(*piRow - iN, SCREEN_H); break;
+                    case 'B': *piRow = clamp(*piRow + iN, SCREEN_H); break;
+                    case 'C': *piCol = clamp(*piCol + iN, SCREEN_W); break;
+                    case 'D': *piCol = clamp(*piCol - iN, SCREEN_W); break;
+                    case 'H': *piRow = clamp(iN, SCREEN_H); *piCol = clamp(iM, SCREEN_W); break;
+                    default: return(0);
+                }
+                break;
+            default:
+                return(0);
+        }
+    }
+    return(1);
+}
+
+int main(void)
+{
+    static unsigned char ucRows[FRAMES], ucCols[FRAMES];
+    char cSeq[TERM_SEQ_MAX + 1], cCup[32];
+    unsigned long ulFrame, ulTerm, ulCup, ulMissed = 0;
+    unsigned long long ullNs, ullTermNs, ullCupNs;
+    unsigned int i, uiLen;
+    int iRow, iCol, iTermRow, iTermCol, iStep;
+
+    printf("%-10s %12s %12s %10s %10s\n", "path", "encoder B/u", "CUP B/u", "encoder ns", "CUP ns");
+
+    srand(1);
+    for(i = 0; i < sizeof(sPaths) / sizeof(sPaths[0]); i++)
+    {
+        // the path first, so the timing is of the sequences only
+        iStep = sPaths[i].iStep;
+        iRow = SCREEN_H / 2;
+        iCol = SCREEN_W / 2;
+        for(ulFrame = 0; ulFrame < FRAMES; ulFrame++)
+        {
+            if(iStep)
+            {
+                iRow = clamp(iRow + rand() % (2 * iStep + 1) - iStep, SCREEN_H);
+                iCol = clamp(iCol + rand() % (2 * iStep + 1) - iStep, SCREEN_W);
+            }
+            else
+            {
+                iRow = 1 + rand() % SCREEN_H;
+                iCol = 1 + rand() % SCREEN_W;
+            }
+            ucRows[ulFrame] = iRow;
+            ucCols[ulFrame] = iCol;
+        }
+
+        // the encoder, each sequence checked on the terminal model
+        TERM_Invalidate();
+        iTermRow = iTermCol = 1;
+        ulTerm = 0;
+        for(ulFrame = 0; ulFrame < FRAMES; ulFrame++)
+        {
+            uiLen = TERM_CursorSeq(cSeq, ucRows[ulFrame], ucCols[ulFrame]);
+            ulTerm += uiLen;
+
+            if(!play(cSeq, uiLen, &iTermRow, &iTermCol)
+               || iTermRow != ucRows[ulFrame] || iTermCol != ucCols[ulFrame])
+            {
+                if(ulMissed++ < 10)
+                    printf("FAIL %s: update %lu to %u;%u ends on %d;%d\n", sPaths[i].pszName,
+                            ulFrame, ucRows[ulFrame], ucCols[ulFrame], iTermRow, iTermCol);
+                iTermRow = ucRows[ulFrame];
+                iTermCol = ucCols[ulFrame];
+            }
+        }
+
+        // the encoder again, timed
+        TERM_Invalidate();
+        ullNs = nsNow();
+        for(ulFrame = 0; ulFrame < FRAMES; ulFrame++)
+            TERM_CursorSeq(cSeq, ucRows[ulFrame], ucCols[ulFrame]);
+        ullTermNs = nsNow() - ullNs;
+
+        // the absolute CUP, as moveCursor() built it with sprintf()
+        ulCup = 0;
+        ullNs = nsNow();
+        for(ulFrame = 0; ulFrame < FRAMES; ulFrame++)
+            ulCup += sprintf(cCup, "\033[%u;%uH", ucRows[ulFrame], ucCols[ulFrame]);
+        ullCupNs = nsNow() - ullNs;
+
+        printf("%-10s %12.2f %12.2f %10.1f %10.1f\n", sPaths[i].pszName,
+                (double)ulTerm / FRAMES, (double)ulCup / FRAMES,
+                (double)ullTermNs / FRAMES, (double)ullCupNs / FRAMES);
+    }
+
+    printf("termbench: %lu sequences missed their target\n", ulMissed);
+    return(ulMissed? 1 : 0);
+}
@@ -0,0 +1,881 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+//  Filename:       xc.h
+//
+//  Description:    
+//  Host stand-in for the XC16 device header of the PIC24FJ128GA010. Put the
+//  sim/ directory first on the include path and the firmware sources compile
+//  with a Linux C compiler unchanged. Every special function register is a 
+//  plain variable reached through SIM_SFR(), which advances the simulated 
+//  instruction clock, steps the peripheral models in sim/ and dispatches any 
+//  enabled interrupt before the access, so busy-wait loops and ISRs behave as
+//  they do on the chip. Only the registers used by the project are declared.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef SIM_XC_H
+#define SIM_XC_H
+
+#include <stdint.h>
+#include "sim.h"
+
+// ISRs are plain functions on the host, dispatched by sim.c
+#define __interrupt__   __used__
+#define no_auto_psv     __used__
+
+// every SFR access costs simulated time and lets the peripherals run
+#define SIM_SFR(r)      (*(simAccess(), &(r)))
+
+// core built-ins
+#define Nop()           simAccess()
+#define ClrWdt()        simAccess()
+#define Idle()          simIdle()
+#define __delay32(n)    simAdvance((unsigned long)(n))
+
+///////////////////////////// Oscillator Module /////////////////////////////
+
+typedef union
+{
+    uint16_t w;
+    struct
+    {
+        unsigned OSWEN:1;
+        unsigned SOSCEN:1;
+        unsigned :1;
+        unsigned CF:1;
+        unsigned :1;
+        unsigned LOCK:1;
+        unsigned :1;
+        unsigned CLKLOCK:1;
+        unsigned NOSC:3;
+        unsigned :1;
+        unsigned COSC:3;
+        unsigned :1;
+    } bits;
+} SIM_OSCCON;
+
+extern volatile SIM_OSCCON simOSCCON;
+extern volatile uint16_t simCLKDIV, simOSCTUN;
+
+#define OSCCON          SIM_SFR(simOSCCON.w)
+#define OSCCONbits      SIM_SFR(simOSCCON.bits)
+#define CLKDIV          SIM_SFR(simCLKDIV)
+#define OSCTUN          SIM_SFR(simOSCTUN)
+
+#define _OSCCON_NOSC_POSITION   8
+#define _OSCCON_OSWEN_MASK      0x0001
+
+// unlock sequence built-ins, a requested clock switch completes at once
+void simWriteOSCCONH(uint8_t ucValue);
+void simWriteOSCCONL(uint8_t ucValue);
+
+#define __builtin_write_OSCCONH(v)  simWriteOSCCONH(v)
+#define __builtin_write_OSCCONL(v)  simWriteOSCCONL(v)
+
+///////////////////////////////// I2C1 Module /////////////////////////////////
+
+typedef union
+{
+    uint16_t w;
+    struct
+    {
+        unsigned SEN:1;
+        unsigned RSEN:1;
+        unsigned PEN:1;
+        unsigned RCEN:1;
+        unsigned ACKEN:1;
+        unsigned ACKDT:1;
+        unsigned STREN:1;
+        unsigned GCEN:1;
+        unsigned SMEN:1;
+        unsigned DISSLW:1;
+        unsigned A10M:1;
+        unsigned IPMIEN:1;
+        unsigned SCLREL:1;
+        unsigned I2CSIDL:1;
+        unsigned :1;
+        unsigned I2CEN:1;
+    } bits;
+} SIM_I2CCON;
+
+typedef union
+{
+    uint16_t w;
+    struct
+    {
+        unsigned TBF:1;
+        unsigned RBF:1;
+        unsigned R_W:1;
+        unsigned S:1;
+        unsigned P:1;
+        unsigned D_A:1;
+        unsigned I2COV:1;
+        unsigned IWCOL:1;
+        unsigned ADD10:1;
+        unsigned GCSTAT:1;
+        unsigned BCL:1;
+        unsigned :3;
+        unsigned TRSTAT:1;
+        unsigned ACKSTAT:1;
+    } bits;
+} SIM_I2CSTAT;
+
+extern volatile SIM_I2CCON simI2C1CON;
+extern volatile SIM_I2CSTAT simI2C1STAT;
+extern volatile uint16_t simI2C1BRG, simI2C1TRN, simI2C1RCV;
+
+#define I2C1CON         SIM_SFR(simI2C1CON.w)
+#define I2C1CONbits     SIM_SFR(simI2C1CON.bits)
+#define I2C1STAT        SIM_SFR(simI2C1STAT.w)
+#define I2C1STATbits    SIM_SFR(simI2C1STAT.bits)
+#define I2C1BRG         SIM_SFR(simI2C1BRG)
+#define I2C1TRN         SIM_SFR(simI2C1TRN)
+#define I2C1RCV         SIM_SFR(simI2C1RCV)
+
+/////////////////////////////////// Timers ////////////////////////////////////
+
+typedef union
+{
+    uint16_t w;
+    struct
+    {
+        unsigned :1;
+        unsigned TCS:1;
+        unsigned TSYNC:1;
+        unsigned T32:1;
+        unsigned TCKPS:2;
+        unsigned TGATE:1;
+        unsigned :6;
+        unsigned TSIDL:1;
+        unsigned :1;
+        unsigned TON:1;
+    } bits;
+} SIM_TCON;
+
+extern volatile SIM_TCON simT1CON;
+extern volatile uint16_t simTMR1, simPR1;
+
+#define T1CON           SIM_SFR(simT1CON.w)
+#define T1CONbits       SIM_SFR(simT1CON.bits)
+#define TMR1            SIM_SFR(simTMR1)
+#define PR1             SIM_SFR(simPR1)
+
+// Timer2/3, only the 32-bit mode (T2CON.T32) is modelled
+extern volatile SIM_TCON simT2CON, simT3CON;
+extern volatile uint16_t simTMR2, simTMR3, simPR2, simPR3;
+
+#define T2CON           SIM_SFR(simT2CON.w)
+#define T2CONbits       SIM_SFR(simT2CON.bits)
+#define T3CON           SIM_SFR(simT3CON.w)
+#define T3CONbits       SIM_SFR(simT3CON.bits)
+#define TMR2            SIM_SFR(simTMR2)
+#define TMR3            SIM_SFR(simTMR3)
+#define PR2             SIM_SFR(simPR2)
+#define PR3             SIM_SFR(simPR3)
+
+// Timer4, 16-bit like Timer1
+extern volatile SIM_TCON simT4CON;
+extern volatile uint16_t simTMR4, simPR4;
+
+#define T4CON           SIM_SFR(simT4CON.w)
+#define T4CONbits       SIM_SFR(simT4CON.bits)
+#define TMR4            SIM_SFR(simTMR4)
+#define PR4             SIM_SFR(simPR4)
+
+//////////////////////////////// UART2 Module ////////////////////////////////
+
+typedef union
+{
+    uint16_t w;
+    struct
+    {
+        unsigned STSEL:1;
+        unsigned PDSEL:2;
+        unsigned BRGH:1;
+        unsigned RXINV:1;
+        unsigned ABAUD:1;
+        unsigned LPBACK:1;
+        unsigned WAKE:1;
+        unsigned UEN:2;
+        unsigned :1;
+        unsigned RTSMD:1;
+        unsigned IREN:1;
+        unsigned USIDL:1;
+        unsigned :1;
+        unsigned UARTEN:1;
+    } bits;
+} SIM_UMODE;
+
+typedef union
+{
+    uint16_t w;
+    struct
+    {
+        unsigned URXDA:1;
+        unsigned OERR:1;
+        unsigned FERR:1;
+        unsigned PERR:1;
+        unsigned RIDLE:1;
+        unsigned ADDEN:1;
+        unsigned URXISEL:2;
+        unsigned TRMT:1;
+        unsigned UTXBF:1;
+        unsigned UTXEN:1;
+        unsigned UTXBRK:1;
+        unsigned :1;
+        unsigned UTXISEL0:1;
+        unsigned UTXINV:1;
+        unsigned UTXISEL1:1;
+    } bits;
+} SIM_USTA;
+
+extern volatile SIM_UMODE simU2MODE;
+extern volatile SIM_USTA simU2STA;
+extern volatile uint16_t simU2BRG, simU2TXREG;
+
+#define U2MODE          SIM_SFR(simU2MODE.w)
+#define U2MODEbits      SIM_SFR(simU2MODE.bits)
+#define U2STA           SIM_SFR(simU2STA.w)
+#define U2STAbits       SIM_SFR(simU2STA.bits)
+#define U2BRG           SIM_SFR(simU2BRG)
+#define U2TXREG         SIM_SFR(simU2TXREG)
+
+// reading U2RXREG pops the receive buffer, so it is a read-only access
+#define U2RXREG         (simAccess(), simUART2Read())
+
+/////////////////////////////////// Ports /////////////////////////////////////
+
+// S3 = RD6, S4 = RD13, S5 = RA7, XZ sensor DR = RF6 (INT0), VL6180 GPIO1 
+// = RE8 (INT1), SCL1 = RG2, SDA1 = RG3
+
+typedef union
+{
+    uint16_t w;
+    struct
+    {
+        unsigned TRISA0:1;
+        unsigned TRISA1:1;
+        unsigned TRISA2:1;
+        unsigned TRISA3:1;
+        unsigned TRISA4:1;
+        unsigned TRISA5:1;
+        unsigned TRISA6:1;
+        unsigned TRISA7:1;
+        unsigned TRISA8:1;
+        unsigned TRISA9:1;
+        unsigned TRISA10:1;
+        unsigned TRISA11:1;
+        unsigned TRISA12:1;
+        unsigned TRISA13:1;
+        unsigned TRISA14:1;
+        unsigned TRISA15:1;
+    } bits;
+} SIM_TRISA;
+
+typedef union
+{
+    uint16_t w;
+    struct
+    {
+        unsigned RA0:1;
+        unsigned RA1:1;
+        unsigned RA2:1;
+        unsigned RA3:1;
+        unsigned RA4:1;
+        unsigned RA5:1;
+        unsigned RA6:1;
+        unsigned RA7:1;
+        unsigned RA8:1;
+        unsigned RA9:1;
+        unsigned RA10:1;
+        unsigned RA11:1;
+        unsigned RA12:1;
+        unsigned RA13:1;
+        unsigned RA14:1;
+        unsigned RA15:1;
+    } bits;
+} SIM_PORTA;
+
+typedef union
+{
+    uint16_t w;
+    struct
+    {
+        unsigned LATA0:1;
+        unsigned LATA1:1;
+        unsigned LATA2:1;
+        unsigned LATA3:1;
+        unsigned LATA4:1;
+        unsigned LATA5:1;
+        unsigned LATA6:1;
+        unsigned LATA7:1;
+        unsigned LATA8:1;
+        unsigned LATA9:1;
+        unsigned LATA10:1;
+        unsigned LATA11:1;
+        unsigned LATA12:1;
+        unsigned LATA13:1;
+        unsigned LATA14:1;
+        unsigned LATA15:1;
+    } bits;
+} SIM_LATA;
+
+typedef union
+{
+    uint16_t w;
+    struct
+    {
+        unsigned TRISD0:1;
+        unsigned TRISD1:1;
+        unsigned TRISD2:1;
+        unsigned TRISD3:1;
+        unsigned TRISD4:1;
+        unsigned TRISD5:1;
+        unsigned TRISD6:1;
+        unsigned TRISD7:1;
+        unsigned TRISD8:1;
+        unsigned TRISD9:1;
+        unsigned TRISD10:1;
+        unsigned TRISD11:1;
+        unsigned TRISD12:1;
+        unsigned TRISD13:1;
+        unsigned TRISD14:1;
+        unsigned TRISD15:1;
+    } bits;
+} SIM_TRISD;
+
+typedef union
+{
+    uint16_t w;
+    struct
+    {
+        unsigned RD0:1;
+        unsigned RD1:1;
+        unsigned RD2:1;
+        unsigned RD3:1;
+        unsigned RD4:1;
+        unsigned RD5:1;
+        unsigned RD6:1;
+        unsigned RD7:1;
+        unsigned RD8:1;
+        unsigned RD9:1;
+        unsigned RD10:1;
+        unsigned RD11:1;
+        unsigned RD12:1;
+        unsigned RD13:1;
+        unsigned RD14:1;
+        unsigned RD15:1;
+    } bits;
+} SIM_PORTD;
+
+typedef union
+{
+    uint16_t w;
+    struct
+    {
+        unsigned LATD0:1;
+        unsigned LATD1:1;
+        unsigned LATD2:1;
+        unsigned LATD3:1;
+        unsigned LATD4:1;
+        unsigned LATD5:1;
+        unsigned LATD6:1;
+        unsigned LATD7:1;
+        unsigned LATD8:1;
+        unsigned LATD9:1;
+        unsigned LATD10:1;
+        unsigned LATD11:1;
+        unsigned LATD12:1;
+        unsigned LATD13:1;
+        unsigned LATD14:1;
+        unsigned LATD15:1;
+    } bits;
+} SIM_LATD;
+
+typedef union
+{
+    uint16_t w;
+    struct
+    {
+        unsigned TRISF0:1;
+        unsigned TRISF1:1;
+        unsigned TRISF2:1;
+        unsigned TRISF3:1;
+        unsigned TRISF4:1;
+        unsigned TRISF5:1;
+        unsigned TRISF6:1;
+        unsigned TRISF7:1;
+        unsigned TRISF8:1;
+        unsigned TRISF9:1;
+        unsigned TRISF10:1;
+        unsigned TRISF11:1;
+        unsigned TRISF12:1;
+        unsigned TRISF13:1;
+        unsigned TRISF14:1;
+        unsigned TRISF15:1;
+    } bits;
+} SIM_TRISF;
+
+typedef union
+{
+    uint16_t w;
+    struct
+    {
+        unsigned TRISE0:1;
+        unsigned TRISE1:1;
+        unsigned TRISE2:1;
+        unsigned TRISE3:1;
+        unsigned TRISE4:1;
+        unsigned TRISE5:1;
+        unsigned TRISE6:1;
+        unsigned TRISE7:1;
+        unsigned TRISE8:1;
+        unsigned TRISE9:1;
+        unsigned :6;
+    } bits;
+} SIM_TRISE;
+
+typedef union
+{
+    uint16_t w;
+    struct
+    {
+        unsigned RF0:1;
+        unsigned RF1:1;
+        unsigned RF2:1;
+        unsigned RF3:1;
+        unsigned RF4:1;
+        unsigned RF5:1;
+        unsigned RF6:1;
+        unsigned RF7:1;
+        unsigned RF8:1;
+        unsigned RF9:1;
+        unsigned RF10:1;
+        unsigned RF11:1;
+        unsigned RF12:1;
+        unsigned RF13:1;
+        unsigned RF14:1;
+        unsigned RF15:1;
+    } bits;
+} SIM_PORTF;
+
+typedef union
+{
+    uint16_t w;
+    struct
+    {
+        unsigned LATF0:1;
+        unsigned LATF1:1;
+        unsigned LATF2:1;
+        unsigned LATF3:1;
+        unsigned LATF4:1;
+        unsigned LATF5:1;
+        unsigned LATF6:1;
+        unsigned LATF7:1;
+        unsigned LATF8:1;
+        unsigned LATF9:1;
+        unsigned LATF10:1;
+        unsigned LATF11:1;
+        unsigned LATF12:1;
+        unsigned LATF13:1;
+        unsigned LATF14:1;
+        unsigned LATF15:1;
+    } bits;
+} SIM_LATF;
+
+typedef union
+{
+    uint16_t w;
+    struct
+    {
+        unsigned TRISG0:1;
+        unsigned TRISG1:1;
+        unsigned TRISG2:1;
+        unsigned TRISG3:1;
+        unsigned TRISG4:1;
+        unsigned TRISG5:1;
+        unsigned TRISG6:1;
+        unsigned TRISG7:1;
+        unsigned TRISG8:1;
+        unsigned TRISG9:1;
+        unsigned TRISG10:1;
+        unsigned TRISG11:1;
+        unsigned TRISG12:1;
+        unsigned TRISG13:1;
+        unsigned TRISG14:1;
+        unsigned TRISG15:1;
+    } bits;
+} SIM_TRISG;
+
+typedef union
+{
+    uint16_t w;
+    struct
+    {
+        unsigned RG0:1;
+        unsigned RG1:1;
+        unsigned RG2:1;
+        unsigned RG3:1;
+        unsigned RG4:1;
+        unsigned RG5:1;
+        unsigned RG6:1;
+        unsigned RG7:1;
+        unsigned RG8:1;
+        unsigned RG9:1;
+        unsigned RG10:1;
+        unsigned RG11:1;
+        unsigned RG12:1;
+        unsigned RG13:1;
+        unsigned RG14:1;
+        unsigned RG15:1;
+    } bits;
+} SIM_PORTG;
+
+typedef union
+{
+    uint16_t w;
+    struct
+    {
+        unsigned LATG0:1;
+        unsigned LATG1:1;
+        unsigned LATG2:1;
+        unsigned LATG3:1;
+        unsigned LATG4:1;
+        unsigned LATG5:1;
+        unsigned LATG6:1;
+        unsigned LATG7:1;
+        unsigned LATG8:1;
+        unsigned LATG9:1;
+        unsigned LATG10:1;
+        unsigned LATG11:1;
+        unsigned LATG12:1;
+        unsigned LATG13:1;
+        unsigned LATG14:1;
+        unsigned LATG15:1;
+    } bits;
+} SIM_LATG;
+
+// change notification enables, CN0 to CN15 and CN16 to CN21
+typedef union
+{
+    uint16_t w;
+    struct
+    {
+        unsigned CN0IE:1;
+        unsigned CN1IE:1;
+        unsigned CN2IE:1;
+        unsigned CN3IE:1;
+        unsigned CN4IE:1;
+        unsigned CN5IE:1;
+        unsigned CN6IE:1;
+        unsigned CN7IE:1;
+        unsigned CN8IE:1;
+        unsigned CN9IE:1;
+        unsigned CN10IE:1;
+        unsigned CN11IE:1;
+        unsigned CN12IE:1;
+        unsigned CN13IE:1;
+        unsigned CN14IE:1;
+        unsigned CN15IE:1;
+    } bits;
+} SIM_CNEN1;
+
+typedef union
+{
+    uint16_t w;
+    struct
+    {
+        unsigned CN16IE:1;
+        unsigned CN17IE:1;
+        unsigned CN18IE:1;
+        unsigned CN19IE:1;
+        unsigned CN20IE:1;
+        unsigned CN21IE:1;
+        unsigned :10;
+    } bits;
+} SIM_CNEN2;
+
+extern volatile SIM_TRISA simTRISA;
+extern volatile SIM_PORTA simPORTA;
+extern volatile SIM_LATA simLATA;
+extern volatile SIM_TRISD simTRISD;
+extern volatile SIM_PORTD simPORTD;
+extern volatile SIM_LATD simLATD;
+extern volatile SIM_TRISE simTRISE;
+extern volatile SIM_TRISF simTRISF;
+extern volatile SIM_PORTF simPORTF;
+extern volatile SIM_LATF simLATF;
+extern volatile SIM_TRISG simTRISG;
+extern volatile SIM_PORTG simPORTG;
+extern volatile SIM_LATG simLATG;
+extern volatile SIM_CNEN1 simCNEN1;
+extern volatile SIM_CNEN2 simCNEN2;
+
+#define TRISA           SIM_SFR(simTRISA.w)
+#define TRISAbits       SIM_SFR(simTRISA.bits)
+#define PORTA           SIM_SFR(simPORTA.w)
+#define PORTAbits       SIM_SFR(simPORTA.bits)
+#define LATA            SIM_SFR(simLATA.w)
+#define LATAbits        SIM_SFR(simLATA.bits)
+#define TRISD           SIM_SFR(simTRISD.w)
+#define TRISDbits       SIM_SFR(simTRISD.bits)
+#define PORTD           SIM_SFR(simPORTD.w)
+#define PORTDbits       SIM_SFR(simPORTD.bits)
+#define LATD            SIM_SFR(simLATD.w)
+#define LATDbits        SIM_SFR(simLATD.bits)
+#define TRISE           SIM_SFR(simTRISE.w)
+#define TRISEbits       SIM_SFR(simTRISE.bits)
+#define TRISF           SIM_SFR(simTRISF.w)
+#define TRISFbits       SIM_SFR(simTRISF.bits)
+#define PORTF           SIM_SFR(simPORTF.w)
+#define PORTFbits       SIM_SFR(simPORTF.bits)
+#define LATF            SIM_SFR(simLATF.w)
+#define LATFbits        SIM_SFR(simLATF.bits)
+#define TRISG           SIM_SFR(simTRISG.w)
+#define TRISGbits       SIM_SFR(simTRISG.bits)
+#define PORTG           SIM_SFR(simPORTG.w)
+#define PORTGbits       SIM_SFR(simPORTG.bits)
+#define LATG            SIM_SFR(simLATG.w)
+#define LATGbits        SIM_SFR(simLATG.bits)
+#define CNEN1           SIM_SFR(simCNEN1.w)
+#define CNEN1bits       SIM_SFR(simCNEN1.bits)
+#define CNEN2           SIM_SFR(simCNEN2.w)
+#define CNEN2bits       SIM_SFR(simCNEN2.bits)
+
+// the other ports and pin configuration registers are only written by 
+// PIN_MANAGER_Initialize(), no bit fields
+extern volatile uint16_t simTRISB, simLATB, simTRISC, simLATC, simLATE;
+extern volatile uint16_t simCNPU1, simCNPU2, simAD1PCFG;
+extern volatile uint16_t simODCA, simODCB, simODCC, simODCD, simODCE, simODCF, simODCG;
+
+#define TRISB           SIM_SFR(simTRISB)
+#define LATB            SIM_SFR(simLATB)
+#define TRISC           SIM_SFR(simTRISC)
+#define LATC            SIM_SFR(simLATC)
+#define LATE            SIM_SFR(simLATE)
+#define CNPU1           SIM_SFR(simCNPU1)
+#define CNPU2           SIM_SFR(simCNPU2)
+#define ODCA            SIM_SFR(simODCA)
+#define ODCB            SIM_SFR(simODCB)
+#define ODCC            SIM_SFR(simODCC)
+#define ODCD            SIM_SFR(simODCD)
+#define ODCE            SIM_SFR(simODCE)
+#define ODCF            SIM_SFR(simODCF)
+#define ODCG            SIM_SFR(simODCG)
+#define AD1PCFG         SIM_SFR(simAD1PCFG)
+
+////////////////////////////////// CPU Core //////////////////////////////////
+
+typedef union
+{
+    uint16_t w;
+    struct
+    {
+        unsigned C:1;
+        unsigned Z:1;
+        unsigned OV:1;
+        unsigned N:1;
+        unsigned RA:1;
+        unsigned IPL:3;
+        unsigned DC:1;
+        unsigned :7;
+    } bits;
+} SIM_SR;
+
+extern volatile SIM_SR simSR;
+
+#define SR              SIM_SFR(simSR.w)
+#define SRbits          SIM_SFR(simSR.bits)
+
+// CPU priority built-ins, see dispatch() in sim.c for how IPL is honoured
+#define SET_CPU_IPL(ipl)                    (SRbits.IPL = (ipl))
+#define SET_AND_SAVE_CPU_IPL(save_to, ipl)  { save_to = SRbits.IPL; SET_CPU_IPL(ipl); } (void) 0
+#define RESTORE_CPU_IPL(saved_to)           SET_CPU_IPL(saved_to)
+
+////////////////////////////// Interrupt Control //////////////////////////////
+
+typedef union
+{
+    uint16_t w;
+    struct
+    {
+        unsigned INT0IF:1;
+        unsigned IC1IF:1;
+        unsigned OC1IF:1;
+        unsigned T1IF:1;
+        unsigned :1;
+        unsigned IC2IF:1;
+        unsigned OC2IF:1;
+        unsigned T2IF:1;
+        unsigned T3IF:1;
+        unsigned SPF1IF:1;
+        unsigned SPI1IF:1;
+        unsigned U1RXIF:1;
+        unsigned U1TXIF:1;
+        unsigned AD1IF:1;
+        unsigned :2;
+    } bits;
+} SIM_IFS0;
+
+typedef union
+{
+    uint16_t w;
+    struct
+    {
+        unsigned INT0IE:1;
+        unsigned IC1IE:1;
+        unsigned OC1IE:1;
+        unsigned T1IE:1;
+        unsigned :1;
+        unsigned IC2IE:1;
+        unsigned OC2IE:1;
+        unsigned T2IE:1;
+        unsigned T3IE:1;
+        unsigned SPF1IE:1;
+        unsigned SPI1IE:1;
+        unsigned U1RXIE:1;
+        unsigned U1TXIE:1;
+        unsigned AD1IE:1;
+        unsigned :2;
+    } bits;
+} SIM_IEC0;
+
+typedef union
+{
+    uint16_t w;
+    struct
+    {
+        unsigned INT0IP:3;
+        unsigned :1;
+        unsigned IC1IP:3;
+        unsigned :1;
+        unsigned OC1IP:3;
+        unsigned :1;
+        unsigned T1IP:3;
+        unsigned :1;
+    } bits;
+} SIM_IPC0;
+
+typedef union
+{
+    uint16_t w;
+    struct
+    {
+        unsigned SI2C1IF:1;
+        unsigned MI2C1IF:1;
+        unsigned CMIF:1;
+        unsigned CNIF:1;
+        unsigned INT1IF:1;
+        unsigned :6;
+        unsigned T4IF:1;
+        unsigned :2;
+        unsigned U2RXIF:1;
+        unsigned U2TXIF:1;
+    } bits;
+} SIM_IFS1;
+
+typedef union
+{
+    uint16_t w;
+    struct
+    {
+        unsigned SI2C1IE:1;
+        unsigned MI2C1IE:1;
+        unsigned CMIE:1;
+        unsigned CNIE:1;
+        unsigned INT1IE:1;
+        unsigned :6;
+        unsigned T4IE:1;
+        unsigned :2;
+        unsigned U2RXIE:1;
+        unsigned U2TXIE:1;
+    } bits;
+} SIM_IEC1;
+
+typedef union
+{
+    uint16_t w;
+    struct
+    {
+        unsigned SI2C1IP:3;
+        unsigned :1;
+        unsigned MI2C1IP:3;
+        unsigned :1;
+        unsigned CMIP:3;
+        unsigned :1;
+        unsigned CNIP:3;
+        unsigned :1;
+    } bits;
+} SIM_IPC4;
+
+typedef union
+{
+    uint16_t w;
+    struct
+    {
+        unsigned INT1IP:3;
+        unsigned :13;
+    } bits;
+} SIM_IPC5;
+
+typedef union
+{
+    uint16_t w;
+    struct
+    {
+        unsigned :4;
+        unsigned OC3IP:3;
+        unsigned :1;
+        unsigned OC4IP:3;
+        unsigned :1;
+        unsigned T4IP:3;
+        unsigned :1;
+    } bits;
+} SIM_IPC6;
+
+typedef union
+{
+    uint16_t w;
+    struct
+    {
+        unsigned INT0EP:1;
+        unsigned INT1EP:1;
+        unsigned INT2EP:1;
+        unsigned INT3EP:1;
+        unsigned INT4EP:1;
+        unsigned :9;
+        unsigned DISI:1;
+        unsigned ALTIVT:1;
+    } bits;
+} SIM_INTCON2;
+
+extern volatile SIM_INTCON2 simINTCON2;
+extern volatile SIM_IFS0 simIFS0;
+extern volatile SIM_IEC0 simIEC0;
+extern volatile SIM_IPC0 simIPC0;
+extern volatile SIM_IFS1 simIFS1;
+extern volatile SIM_IEC1 simIEC1;
+extern volatile SIM_IPC4 simIPC4;
+extern volatile SIM_IPC5 simIPC5;
+extern volatile SIM_IPC6 simIPC6;
+
+#define INTCON2         SIM_SFR(simINTCON2.w)
+#define INTCON2bits     SIM_SFR(simINTCON2.bits)
+#define IFS0            SIM_SFR(simIFS0.w)
+#define IFS0bits        SIM_SFR(simIFS0.bits)
+#define IEC0            SIM_SFR(simIEC0.w)
+#define IEC0bits        SIM_SFR(simIEC0.bits)
+#define IPC0            SIM_SFR(simIPC0.w)
+#define IPC0bits        SIM_SFR(simIPC0.bits)
+#define IFS1            SIM_SFR(simIFS1.w)
+#define IFS1bits        SIM_SFR(simIFS1.bits)
+#define IEC1            SIM_SFR(simIEC1.w)
+#define IEC1bits        SIM_SFR(simIEC1.bits)
+#define IPC4            SIM_SFR(simIPC4.w)
+#define IPC4bits        SIM_SFR(simIPC4.bits)
+#define IPC5            SIM_SFR(simIPC5.w)
+#define IPC5bits        SIM_SFR(simIPC5.bits)
+#define IPC6            SIM_SFR(simIPC6.w)
+#define IPC6bits        SIM_SFR(simIPC6.bits)
+
+#endif  // SIM_XC_H